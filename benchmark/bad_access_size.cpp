@@ -0,0 +1,26 @@
+//
+// Copyright (c) 2022 Ramirisu (labyrinth dot ramirisu at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Code size of the failure paths of `value()`: every function below carries
+// one for `optional` and one for `expected` with a non-trivial error. Compare
+// the size of the object file across `GUL_BAD_ACCESS` modes and changes.
+
+#include "repeat.hpp"
+
+#include <gul/expected.hpp>
+#include <gul/optional.hpp>
+
+#include <string>
+
+#define GUL_BENCH_VALUE(n)                                                     \
+  int value##n(const gul::optional<bench_tag<n>>& o,                           \
+               const gul::expected<bench_tag<n>, std::string>& e)              \
+  {                                                                            \
+    return o.value().v + e.value().v;                                          \
+  }
+
+GUL_BENCH_REPEAT(GUL_BENCH_VALUE)
@@ -0,0 +1,22 @@
+//
+// Copyright (c) 2022 Ramirisu (labyrinth dot ramirisu at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Compile time of instantiating `expected` for 200 distinct trivially copyable
+// types, plus copying each of them once.
+
+#include "repeat.hpp"
+
+#include <gul/expected.hpp>
+
+#define GUL_BENCH_INSTANTIATE(n)                                               \
+  int use##n(const gul::expected<bench_tag<n>, int>& x)                        \
+  {                                                                            \
+    auto copy = x;                                                             \
+    return int(sizeof(copy));                                                  \
+  }
+
+GUL_BENCH_REPEAT(GUL_BENCH_INSTANTIATE)
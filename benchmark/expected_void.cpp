@@ -0,0 +1,46 @@
+//
+// Copyright (c) 2022 Ramirisu (labyrinth dot ramirisu at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Code size of passing `expected<void, E>` through a chain of calls. This file
+// is built twice: with `expected_error_niche<bench_errc>`, which drops the
+// discriminator so the result is returned in a register, and without it
+// (`GUL_BENCH_NO_NICHE`), which returns an 8-byte struct.
+
+#include "repeat.hpp"
+
+#include <gul/expected.hpp>
+
+enum class bench_errc : int {
+  ok,
+  failed,
+};
+
+#if !defined(GUL_BENCH_NO_NICHE)
+GUL_NAMESPACE_BEGIN
+
+template <>
+struct expected_error_niche<bench_errc>
+    : expected_error_niche_value<bench_errc, bench_errc::ok> { };
+
+GUL_NAMESPACE_END
+#endif
+
+using bench_result = gul::expected<void, bench_errc>;
+
+bench_result bench_step(int x);
+
+#define GUL_BENCH_PROPAGATE(n)                                                 \
+  bench_result propagate##n(int x)                                             \
+  {                                                                            \
+    auto r = bench_step(x + n);                                                \
+    if (!r) {                                                                  \
+      return r;                                                                \
+    }                                                                          \
+    return bench_step(x - n);                                                  \
+  }
+
+GUL_BENCH_REPEAT(GUL_BENCH_PROPAGATE)
@@ -0,0 +1,81 @@
+//
+// Copyright (c) 2022 Ramirisu (labyrinth dot ramirisu at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Call and construction cost of `std::function`, `inplace_function` and
+// `function_ref` for a lambda capturing 24 bytes, which libstdc++ and libc++
+// put on the heap. Prints the best of five runs in nanoseconds per operation.
+
+#include <gul/config.hpp>
+#include <gul/function.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+
+namespace {
+
+constexpr int iterations = 10000000;
+
+struct payload {
+  std::int64_t a;
+  std::int64_t b;
+  std::int64_t c;
+};
+
+volatile std::int64_t sink;
+
+template <typename F>
+GUL_NOINLINE std::int64_t call(F& f, std::int64_t x)
+{
+  return f(x);
+}
+
+template <typename Body>
+double nanoseconds_per_op(Body body)
+{
+  using clock = std::chrono::steady_clock;
+  double best = 1e300;
+  for (int run = 0; run < 5; ++run) {
+    const auto start = clock::now();
+    for (int i = 0; i < iterations; ++i) {
+      body(i);
+    }
+    const std::chrono::duration<double, std::nano> elapsed
+        = clock::now() - start;
+    best = std::min(best, elapsed.count() / iterations);
+  }
+  return best;
+}
+
+template <typename Wrapper>
+void bench(const char* name)
+{
+  const payload p = { 1, 2, 3 };
+  auto lambda = [p](std::int64_t x) { return p.a + p.b * x + p.c; };
+  Wrapper stored(lambda);
+  const double call_ns
+      = nanoseconds_per_op([&](int i) { sink = call(stored, i); });
+  const double construct_ns = nanoseconds_per_op([&](int i) {
+    auto local = [p, i](std::int64_t x) { return p.a + p.b * x + i; };
+    Wrapper w(local);
+    sink = call(w, i);
+  });
+  std::printf("%-18s %8.2f ns %18.2f ns\n", name, call_ns, construct_ns);
+}
+
+}
+
+int main()
+{
+  using signature = std::int64_t(std::int64_t);
+  std::printf("%-18s %11s %21s\n", "", "call", "construct + call");
+  bench<std::function<signature>>("std::function");
+  bench<gul::inplace_function<signature>>("inplace_function");
+  bench<gul::function_ref<signature>>("function_ref");
+}
@@ -0,0 +1,34 @@
+//
+// Copyright (c) 2022 Ramirisu (labyrinth dot ramirisu at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#pragma once
+
+// Expands `M(n)` for n in [100, 300), giving 200 distinct instantiations
+// without a generator script.
+#define GUL_BENCH_REPEAT_10(M, P)                                              \
+  M(P##0) M(P##1) M(P##2) M(P##3) M(P##4) M(P##5) M(P##6) M(P##7) M(P##8)      \
+      M(P##9)
+
+#define GUL_BENCH_REPEAT_100(M, P)                                             \
+  GUL_BENCH_REPEAT_10(M, P##0)                                                 \
+  GUL_BENCH_REPEAT_10(M, P##1)                                                 \
+  GUL_BENCH_REPEAT_10(M, P##2)                                                 \
+  GUL_BENCH_REPEAT_10(M, P##3)                                                 \
+  GUL_BENCH_REPEAT_10(M, P##4)                                                 \
+  GUL_BENCH_REPEAT_10(M, P##5)                                                 \
+  GUL_BENCH_REPEAT_10(M, P##6)                                                 \
+  GUL_BENCH_REPEAT_10(M, P##7)                                                 \
+  GUL_BENCH_REPEAT_10(M, P##8)                                                 \
+  GUL_BENCH_REPEAT_10(M, P##9)
+
+#define GUL_BENCH_REPEAT(M)                                                    \
+  GUL_BENCH_REPEAT_100(M, 1) GUL_BENCH_REPEAT_100(M, 2)
+
+template <int I>
+struct bench_tag {
+  int v;
+};
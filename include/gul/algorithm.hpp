@@ -0,0 +1,310 @@
+//
+// Copyright (c) 2022 Ramirisu (labyrinth dot ramirisu at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#pragma once
+
+#include <gul/config.hpp>
+
+#include <gul/detail/algorithm.hpp>
+
+#include <gul/span.hpp>
+#include <gul/type_traits.hpp>
+#include <gul/utility.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <utility>
+#include <vector>
+
+GUL_NAMESPACE_BEGIN
+
+// Splits a span into chunks of about `chunk_bytes` bytes that are processed
+// by up to `threads` threads, the calling thread included. Zero threads means
+// std::thread::hardware_concurrency().
+struct parallel_policy {
+  constexpr parallel_policy() noexcept = default;
+
+  constexpr explicit parallel_policy(std::size_t threads,
+                                     std::size_t chunk_bytes
+                                     = std::size_t(1) << 18) noexcept
+      : threads(threads)
+      , chunk_bytes(chunk_bytes)
+  {
+  }
+
+  std::size_t threads = 0;
+  std::size_t chunk_bytes = std::size_t(1) << 18;
+};
+
+GUL_CXX17_INLINE constexpr parallel_policy par {};
+
+namespace detail {
+
+inline std::size_t chunk_elements(const parallel_policy& policy,
+                                  std::size_t element_size) noexcept
+{
+  const std::size_t elements = policy.chunk_bytes / element_size;
+  return elements != 0 ? elements : 1;
+}
+
+inline std::size_t chunk_count(std::size_t count, std::size_t chunk) noexcept
+{
+  return (count + chunk - 1) / chunk;
+}
+
+// Calls `f(index, offset, length)` for every chunk. Workers claim chunks one
+// at a time, so uneven chunks do not leave threads idle. `f` must not throw.
+template <typename F>
+void parallel_for_chunks(const parallel_policy& policy,
+                         std::size_t count,
+                         std::size_t chunk,
+                         F f)
+{
+  const std::size_t chunks = chunk_count(count, chunk);
+  std::size_t threads = policy.threads != 0
+      ? policy.threads
+      : std::size_t(std::thread::hardware_concurrency());
+  if (threads > chunks) {
+    threads = chunks;
+  }
+
+  std::atomic<std::size_t> next(0);
+  auto work = [&]() {
+    for (;;) {
+      const std::size_t index = next.fetch_add(1, std::memory_order_relaxed);
+      if (index >= chunks) {
+        break;
+      }
+      const std::size_t offset = index * chunk;
+      f(index, offset, count - offset < chunk ? count - offset : chunk);
+    }
+  };
+
+  std::vector<std::thread> workers;
+  if (threads > 1) {
+    // If a thread cannot be started, the ones that are running and the
+    // calling thread take the remaining chunks.
+    GUL_TRY
+    {
+      workers.reserve(threads - 1);
+      for (std::size_t i = 1; i < threads; ++i) {
+        workers.emplace_back(work);
+      }
+    }
+    GUL_CATCH(...) { }
+  }
+  work();
+  for (auto& worker : workers) {
+    worker.join();
+  }
+}
+
+}
+
+// Returns `init` plus the sum of the elements. The additions may be
+// reassociated, so floating-point results can differ from a left fold.
+template <typename T, std::size_t N, typename U>
+U reduce(span<T, N> s, U init)
+{
+  return detail::sum_kernel(s.data(), s.size(), std::move(init));
+}
+
+template <typename T, std::size_t N, typename U>
+U reduce(const parallel_policy& policy, span<T, N> s, U init)
+{
+  const std::size_t chunk = detail::chunk_elements(policy, sizeof(T));
+  std::vector<U> partials(detail::chunk_count(s.size(), chunk), U());
+  detail::parallel_for_chunks(
+      policy, s.size(), chunk,
+      [&](std::size_t index, std::size_t offset, std::size_t length) {
+        partials[index] = detail::sum_kernel(s.data() + offset, length, U());
+      });
+  for (auto& partial : partials) {
+    init = std::move(init) + partial;
+  }
+  return init;
+}
+
+template <typename T, std::size_t N, typename U, typename BinaryOp>
+U reduce(span<T, N> s, U init, BinaryOp op)
+{
+  for (auto& value : s) {
+    init = op(std::move(init), value);
+  }
+  return init;
+}
+
+// `op` has to be associative and commutative, the chunks are folded
+// independently and their results are combined in order.
+template <typename T, std::size_t N, typename U, typename BinaryOp>
+U reduce(const parallel_policy& policy, span<T, N> s, U init, BinaryOp op)
+{
+  const std::size_t chunk = detail::chunk_elements(policy, sizeof(T));
+  std::vector<U> partials(detail::chunk_count(s.size(), chunk), init);
+  detail::parallel_for_chunks(
+      policy, s.size(), chunk,
+      [&](std::size_t index, std::size_t offset, std::size_t length) {
+        U acc = s[offset];
+        for (std::size_t i = 1; i < length; ++i) {
+          acc = op(std::move(acc), s[offset + i]);
+        }
+        partials[index] = std::move(acc);
+      });
+  for (auto& partial : partials) {
+    init = op(std::move(init), partial);
+  }
+  return init;
+}
+
+// Writes `f(in[i])` into `out[i]` and returns the part of `out` that was
+// written.
+template <typename T,
+          std::size_t N,
+          typename U,
+          std::size_t M,
+          typename UnaryOp>
+span<U> transform(span<T, N> in, span<U, M> out, UnaryOp f)
+{
+  GUL_ASSERT(in.size() <= out.size());
+  for (std::size_t i = 0; i < in.size(); ++i) {
+    out[i] = f(in[i]);
+  }
+  return out.first(in.size());
+}
+
+template <typename T,
+          std::size_t N,
+          typename U,
+          std::size_t M,
+          typename UnaryOp>
+span<U> transform(const parallel_policy& policy,
+                  span<T, N> in,
+                  span<U, M> out,
+                  UnaryOp f)
+{
+  GUL_ASSERT(in.size() <= out.size());
+  detail::parallel_for_chunks(
+      policy, in.size(), detail::chunk_elements(policy, sizeof(T)),
+      [&](std::size_t, std::size_t offset, std::size_t length) {
+        for (std::size_t i = offset; i < offset + length; ++i) {
+          out[i] = f(in[i]);
+        }
+      });
+  return out.first(in.size());
+}
+
+template <typename T, std::size_t N, typename U>
+std::size_t count(span<T, N> s, const U& value)
+{
+  return detail::count_kernel(
+      s.data(), s.size(), value,
+      bool_constant<detail::is_simd_comparable<remove_cv_t<T>>::value
+                    && std::is_same<remove_cv_t<T>, U>::value> {});
+}
+
+template <typename T, std::size_t N, typename U>
+std::size_t count(const parallel_policy& policy, span<T, N> s, const U& value)
+{
+  const std::size_t chunk = detail::chunk_elements(policy, sizeof(T));
+  std::vector<std::size_t> partials(detail::chunk_count(s.size(), chunk));
+  detail::parallel_for_chunks(
+      policy, s.size(), chunk,
+      [&](std::size_t index, std::size_t offset, std::size_t length) {
+        partials[index] = count(s.subspan(offset, length), value);
+      });
+  std::size_t result = 0;
+  for (auto partial : partials) {
+    result += partial;
+  }
+  return result;
+}
+
+// Returns an iterator to the first element equal to `value`, or `s.end()`.
+template <typename T, std::size_t N, typename U>
+auto find(span<T, N> s, const U& value) -> typename span<T, N>::iterator
+{
+  const std::size_t index = detail::find_kernel(
+      s.data(), s.size(), value,
+      bool_constant<detail::is_simd_comparable<remove_cv_t<T>>::value
+                    && std::is_same<remove_cv_t<T>, U>::value> {});
+  return index == s.size() ? s.end()
+                           : s.begin() + static_cast<std::ptrdiff_t>(index);
+}
+
+// Returns the smallest and the largest element of a non-empty span. The
+// result is unspecified if the span contains NaNs.
+template <typename T, std::size_t N>
+auto minmax(span<T, N> s) -> std::pair<remove_cv_t<T>, remove_cv_t<T>>
+{
+  GUL_ASSERT(!s.empty());
+  return detail::minmax_kernel(s.data(), s.size());
+}
+
+template <typename T, std::size_t N>
+auto minmax(const parallel_policy& policy, span<T, N> s)
+    -> std::pair<remove_cv_t<T>, remove_cv_t<T>>
+{
+  GUL_ASSERT(!s.empty());
+  const std::size_t chunk = detail::chunk_elements(policy, sizeof(T));
+  std::vector<std::pair<remove_cv_t<T>, remove_cv_t<T>>> partials(
+      detail::chunk_count(s.size(), chunk));
+  detail::parallel_for_chunks(
+      policy, s.size(), chunk,
+      [&](std::size_t index, std::size_t offset, std::size_t length) {
+        partials[index] = detail::minmax_kernel(s.data() + offset, length);
+      });
+  auto result = partials[0];
+  for (std::size_t i = 1; i < partials.size(); ++i) {
+    if (partials[i].first < result.first) {
+      result.first = partials[i].first;
+    }
+    if (result.second < partials[i].second) {
+      result.second = partials[i].second;
+    }
+  }
+  return result;
+}
+
+// Returns `init` plus the sum of `a[i] * b[i]`. The additions may be
+// reassociated.
+template <typename T, std::size_t N, typename V, std::size_t M, typename U>
+U dot(span<T, N> a, span<V, M> b, U init)
+{
+  GUL_ASSERT(a.size() == b.size());
+  return detail::dot_kernel(a.data(), b.data(), a.size(), std::move(init));
+}
+
+template <typename T, std::size_t N, typename V, std::size_t M, typename U>
+U dot(const parallel_policy& policy, span<T, N> a, span<V, M> b, U init)
+{
+  GUL_ASSERT(a.size() == b.size());
+  const std::size_t chunk = detail::chunk_elements(policy, sizeof(T));
+  std::vector<U> partials(detail::chunk_count(a.size(), chunk), U());
+  detail::parallel_for_chunks(
+      policy, a.size(), chunk,
+      [&](std::size_t index, std::size_t offset, std::size_t length) {
+        partials[index] = detail::dot_kernel(a.data() + offset,
+                                             b.data() + offset, length, U());
+      });
+  for (auto& partial : partials) {
+    init = std::move(init) + partial;
+  }
+  return init;
+}
+
+// Writes the inclusive prefix sums of `in` into `out`, which may be `in`
+// itself, and returns the part of `out` that was written.
+template <typename T, std::size_t N, typename U, std::size_t M>
+span<U> prefix_sum(span<T, N> in, span<U, M> out)
+{
+  GUL_ASSERT(in.size() <= out.size());
+  detail::prefix_sum_kernel(in.data(), in.size(), out.data());
+  return out.first(in.size());
+}
+
+GUL_NAMESPACE_END
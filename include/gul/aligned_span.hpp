@@ -0,0 +1,465 @@
+//
+// Copyright (c) 2022 Ramirisu (labyrinth dot ramirisu at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#pragma once
+
+#include <gul/config.hpp>
+
+#include <gul/span.hpp>
+#include <gul/type_traits.hpp>
+#include <gul/utility.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+
+GUL_NAMESPACE_BEGIN
+
+namespace detail {
+
+constexpr bool is_power_of_two(std::size_t x) noexcept
+{
+  return x != 0 && (x & (x - 1)) == 0;
+}
+
+constexpr std::size_t lowest_set_bit(std::size_t x) noexcept
+{
+  return x & (~x + 1);
+}
+
+constexpr std::size_t gcd(std::size_t a, std::size_t b) noexcept
+{
+  return b == 0 ? a : gcd(b, a % b);
+}
+
+// The alignment of an `align`-aligned address advanced by `bytes` bytes.
+constexpr std::size_t offset_alignment(std::size_t align,
+                                       std::size_t bytes) noexcept
+{
+  return bytes == 0 || lowest_set_bit(bytes) > align ? align
+                                                     : lowest_set_bit(bytes);
+}
+
+template <std::size_t Align>
+bool is_aligned(const volatile void* pointer) noexcept
+{
+  return reinterpret_cast<std::uintptr_t>(pointer) % Align == 0;
+}
+
+template <std::size_t Align, typename T>
+T* assume_aligned(T* pointer) noexcept
+{
+#if defined(__GNUC__) || defined(__clang__)
+  return static_cast<T*>(__builtin_assume_aligned(pointer, Align));
+#else
+  return pointer;
+#endif
+}
+
+}
+
+// A span whose first element is known to be aligned to `Align` bytes, so that
+// vector kernels can use aligned loads without a scalar prologue.
+template <typename T, std::size_t Align>
+class aligned_span {
+  static_assert(detail::is_power_of_two(Align),
+                "Align must be a power of two");
+  static_assert(Align >= alignof(T), "Align must not be weaker than T's");
+
+public:
+  using element_type = T;
+  using value_type = remove_cv_t<T>;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using pointer = T*;
+  using const_pointer = const T*;
+  using reference = T&;
+  using const_reference = const T&;
+  using iterator = T*;
+
+  static constexpr std::size_t alignment = Align;
+
+  constexpr aligned_span() noexcept = default;
+
+  aligned_span(pointer first, size_type size) noexcept
+      : data_(first)
+      , size_(size)
+  {
+    GUL_ASSERT(detail::is_aligned<Align>(first));
+  }
+
+  template <typename U,
+            std::size_t N,
+            GUL_REQUIRES(std::is_convertible<U (*)[], T (*)[]>::value)>
+  explicit aligned_span(span<U, N> s) noexcept
+      : aligned_span(s.data(), s.size())
+  {
+  }
+
+  template <typename U,
+            std::size_t OtherAlign,
+            GUL_REQUIRES(std::is_convertible<U (*)[], T (*)[]>::value
+                         && OtherAlign >= Align)>
+  aligned_span(aligned_span<U, OtherAlign> other) noexcept
+      : data_(other.data_)
+      , size_(other.size_)
+  {
+  }
+
+  template <typename U,
+            GUL_REQUIRES(std::is_convertible<T (*)[], U (*)[]>::value)>
+  operator span<U>() const noexcept
+  {
+    return span<U>(data_, size_);
+  }
+
+  reference front() const
+  {
+    GUL_ASSERT(size() > 0);
+    return *data();
+  }
+
+  reference back() const
+  {
+    GUL_ASSERT(size() > 0);
+    return *(data() + size() - 1);
+  }
+
+  reference operator[](size_type index) const
+  {
+    GUL_ASSERT(index < size());
+    return *(data() + index);
+  }
+
+  pointer data() const noexcept
+  {
+    return detail::assume_aligned<Align>(data_);
+  }
+
+  constexpr size_type size() const noexcept
+  {
+    return size_;
+  }
+
+  constexpr size_type size_bytes() const noexcept
+  {
+    return size_ * sizeof(T);
+  }
+
+  constexpr bool empty() const noexcept
+  {
+    return size_ == 0;
+  }
+
+  iterator begin() const noexcept
+  {
+    return data();
+  }
+
+  iterator end() const noexcept
+  {
+    return data() + size();
+  }
+
+  // The first elements start at the same address, so the guarantee holds.
+  aligned_span first(size_type count) const noexcept
+  {
+    GUL_ASSERT(count <= size());
+    return aligned_span(data_, count, unchecked_tag {});
+  }
+
+  span<T> last(size_type count) const noexcept
+  {
+    GUL_ASSERT(count <= size());
+    return span<T>(data_ + (size_ - count), count);
+  }
+
+  // The alignment of the result is derived from `Offset` at compile time,
+  // e.g. `aligned_span<float, 32>::subspan<4>()` is 16-byte aligned.
+  template <std::size_t Offset, std::size_t Count = dynamic_extent>
+  auto subspan() const noexcept
+      -> aligned_span<T, detail::offset_alignment(Align, Offset * sizeof(T))>
+  {
+    GUL_ASSERT(Offset <= size());
+    GUL_ASSERT(Count == dynamic_extent || Count <= size() - Offset);
+    return aligned_span<T, detail::offset_alignment(Align,
+                                                    Offset * sizeof(T))>(
+        data_ + Offset, Count == dynamic_extent ? size_ - Offset : Count);
+  }
+
+  // `offset` has to keep the alignment, i.e. be a multiple of
+  // `Align / sizeof(T)` elements.
+  aligned_span subspan(size_type offset,
+                       size_type count = dynamic_extent) const noexcept
+  {
+    GUL_ASSERT(offset <= size());
+    GUL_ASSERT(count == dynamic_extent || count <= size() - offset);
+    return aligned_span(data_ + offset,
+                        count == dynamic_extent ? size_ - offset : count);
+  }
+
+private:
+  template <typename, std::size_t>
+  friend class aligned_span;
+
+  struct unchecked_tag { };
+
+  constexpr aligned_span(pointer first,
+                         size_type size,
+                         unchecked_tag) noexcept
+      : data_(first)
+      , size_(size)
+  {
+  }
+
+  T* data_ = nullptr;
+  size_type size_ = 0;
+};
+
+template <typename T, std::size_t Align>
+constexpr std::size_t aligned_span<T, Align>::alignment;
+
+// An owning, `Align`-aligned array. The storage is padded with
+// value-initialized elements up to a multiple of `Align / sizeof(T)`
+// elements, so a vector kernel can process `padded_view()` in whole vectors
+// without a scalar epilogue.
+template <typename T, std::size_t Align>
+class aligned_buffer {
+  static_assert(detail::is_power_of_two(Align),
+                "Align must be a power of two");
+  static_assert(Align >= alignof(T), "Align must not be weaker than T's");
+
+public:
+  using element_type = T;
+  using value_type = T;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using pointer = T*;
+  using const_pointer = const T*;
+  using reference = T&;
+  using const_reference = const T&;
+  using iterator = T*;
+  using const_iterator = const T*;
+
+  static constexpr std::size_t alignment = Align;
+
+  constexpr aligned_buffer() noexcept = default;
+
+  explicit aligned_buffer(size_type size)
+      : aligned_buffer(size, T())
+  {
+  }
+
+  aligned_buffer(size_type size, const T& value)
+  {
+    const size_type padded = padded_size_for(size);
+    data_ = allocate(padded);
+    size_type i = 0;
+    GUL_TRY
+    {
+      for (; i < size; ++i) {
+        ::new (static_cast<void*>(data_ + i)) T(value);
+      }
+      for (; i < padded; ++i) {
+        ::new (static_cast<void*>(data_ + i)) T();
+      }
+    }
+    GUL_CATCH(...)
+    {
+      destroy(data_, i);
+      deallocate(data_);
+      GUL_RETHROW();
+    }
+    size_ = size;
+  }
+
+  aligned_buffer(const aligned_buffer&) = delete;
+
+  aligned_buffer(aligned_buffer&& other) noexcept
+      : data_(exchange(other.data_, nullptr))
+      , size_(exchange(other.size_, 0))
+  {
+  }
+
+  aligned_buffer& operator=(const aligned_buffer&) = delete;
+
+  aligned_buffer& operator=(aligned_buffer&& other) noexcept
+  {
+    if (this != &other) {
+      reset();
+      data_ = exchange(other.data_, nullptr);
+      size_ = exchange(other.size_, 0);
+    }
+    return *this;
+  }
+
+  ~aligned_buffer()
+  {
+    reset();
+  }
+
+  reference operator[](size_type index) noexcept
+  {
+    GUL_ASSERT(index < size());
+    return data()[index];
+  }
+
+  const_reference operator[](size_type index) const noexcept
+  {
+    GUL_ASSERT(index < size());
+    return data()[index];
+  }
+
+  pointer data() noexcept
+  {
+    return detail::assume_aligned<Align>(data_);
+  }
+
+  const_pointer data() const noexcept
+  {
+    return detail::assume_aligned<Align>(static_cast<const T*>(data_));
+  }
+
+  size_type size() const noexcept
+  {
+    return size_;
+  }
+
+  // The number of elements including the padding.
+  size_type padded_size() const noexcept
+  {
+    return data_ != nullptr ? padded_size_for(size_) : 0;
+  }
+
+  bool empty() const noexcept
+  {
+    return size_ == 0;
+  }
+
+  iterator begin() noexcept
+  {
+    return data();
+  }
+
+  const_iterator begin() const noexcept
+  {
+    return data();
+  }
+
+  iterator end() noexcept
+  {
+    return data() + size();
+  }
+
+  const_iterator end() const noexcept
+  {
+    return data() + size();
+  }
+
+  aligned_span<T, Align> view() noexcept
+  {
+    return aligned_span<T, Align>(data_, size_);
+  }
+
+  aligned_span<const T, Align> view() const noexcept
+  {
+    return aligned_span<const T, Align>(data_, size_);
+  }
+
+  aligned_span<T, Align> padded_view() noexcept
+  {
+    return aligned_span<T, Align>(data_, padded_size());
+  }
+
+  aligned_span<const T, Align> padded_view() const noexcept
+  {
+    return aligned_span<const T, Align>(data_, padded_size());
+  }
+
+  operator aligned_span<T, Align>() noexcept
+  {
+    return view();
+  }
+
+  operator aligned_span<const T, Align>() const noexcept
+  {
+    return view();
+  }
+
+  operator span<T>() noexcept
+  {
+    return span<T>(data_, size_);
+  }
+
+  operator span<const T>() const noexcept
+  {
+    return span<const T>(data_, size_);
+  }
+
+private:
+  // The fewest elements spanning a whole number of vectors, i.e.
+  // `lcm(sizeof(T), Align) / sizeof(T)`.
+  static constexpr size_type granule = Align / detail::gcd(sizeof(T), Align);
+
+  static size_type padded_size_for(size_type size) noexcept
+  {
+    // Always keeps at least one vector, so that `data()` is never null.
+    return size == 0 ? granule : (size + granule - 1) / granule * granule;
+  }
+
+  // `::operator new` only guarantees fundamental alignment before c++17, so
+  // over-allocate and keep the real block address in front of the aligned
+  // pointer.
+  static T* allocate(size_type count)
+  {
+    void* raw = ::operator new(count * sizeof(T) + sizeof(void*) + Align - 1);
+    const auto address
+        = reinterpret_cast<std::uintptr_t>(raw) + sizeof(void*) + Align - 1;
+    const auto aligned
+        = reinterpret_cast<unsigned char*>(address - address % Align);
+    std::memcpy(aligned - sizeof(void*), &raw, sizeof(void*));
+    return reinterpret_cast<T*>(aligned);
+  }
+
+  static void deallocate(T* pointer) noexcept
+  {
+    void* raw;
+    std::memcpy(&raw, reinterpret_cast<unsigned char*>(pointer) - sizeof(void*),
+                sizeof(void*));
+    ::operator delete(raw);
+  }
+
+  static void destroy(T* pointer, size_type count) noexcept
+  {
+    for (size_type i = 0; i < count; ++i) {
+      pointer[i].~T();
+    }
+  }
+
+  void reset() noexcept
+  {
+    if (data_ != nullptr) {
+      const size_type padded = padded_size_for(size_);
+      destroy(data_, padded);
+      deallocate(data_);
+      data_ = nullptr;
+      size_ = 0;
+    }
+  }
+
+  T* data_ = nullptr;
+  size_type size_ = 0;
+};
+
+template <typename T, std::size_t Align>
+constexpr std::size_t aligned_buffer<T, Align>::alignment;
+
+template <typename T, std::size_t Align>
+constexpr std::size_t aligned_buffer<T, Align>::granule;
+
+GUL_NAMESPACE_END
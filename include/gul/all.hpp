@@ -14,13 +14,31 @@
 
 #include <gul/invoke.hpp>
 
+#include <gul/algorithm.hpp>
+#include <gul/aligned_span.hpp>
+#include <gul/bit.hpp>
+#include <gul/bounds_check.hpp>
+#include <gul/buffer_sequence.hpp>
 #include <gul/byte.hpp>
+#include <gul/byte_io.hpp>
+#include <gul/charconv.hpp>
+#include <gul/collect.hpp>
 #include <gul/expected.hpp>
+#include <gul/function.hpp>
+#include <gul/mdspan.hpp>
+#include <gul/niche.hpp>
 #include <gul/optional.hpp>
+#include <gul/optional_array.hpp>
 #include <gul/out_ptr.hpp>
+#include <gul/pipe.hpp>
+#include <gul/ring_span.hpp>
 #include <gul/span.hpp>
+#include <gul/status.hpp>
+#include <gul/strided_span.hpp>
 #include <gul/string_view.hpp>
 #include <gul/tuple.hpp>
+#include <gul/utf.hpp>
 
 #include <gul/fifo_map.hpp>
 #include <gul/lru_map.hpp>
+#include <gul/mapped_file.hpp>
@@ -0,0 +1,262 @@
+//
+// Copyright (c) 2022 Ramirisu (labyrinth dot ramirisu at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#pragma once
+
+#include <gul/config.hpp>
+
+#include <gul/detail/bit.hpp>
+
+#include <gul/byte.hpp>
+#include <gul/span.hpp>
+#include <gul/type_traits.hpp>
+#include <gul/utility.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+GUL_NAMESPACE_BEGIN
+
+enum class endian {
+  little = 0,
+  big = 1,
+  native = GUL_BIG_ENDIAN ? big : little,
+};
+
+namespace detail {
+
+template <std::size_t Size>
+struct uint_of_size;
+
+template <>
+struct uint_of_size<1> {
+  using type = std::uint8_t;
+};
+
+template <>
+struct uint_of_size<2> {
+  using type = std::uint16_t;
+};
+
+template <>
+struct uint_of_size<4> {
+  using type = std::uint32_t;
+};
+
+template <>
+struct uint_of_size<8> {
+  using type = std::uint64_t;
+};
+
+inline std::uint8_t byteswap_uint(std::uint8_t x) noexcept
+{
+  return x;
+}
+
+inline std::uint16_t byteswap_uint(std::uint16_t x) noexcept
+{
+  return byteswap16(x);
+}
+
+inline std::uint32_t byteswap_uint(std::uint32_t x) noexcept
+{
+  return byteswap32(x);
+}
+
+inline std::uint64_t byteswap_uint(std::uint64_t x) noexcept
+{
+  return byteswap64(x);
+}
+
+template <typename T>
+struct is_endian_loadable
+    : bool_constant<(std::is_arithmetic<T>::value || std::is_enum<T>::value)
+                    && (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4
+                        || sizeof(T) == 8)> { };
+
+template <typename T>
+T load_bytes(const void* p, std::false_type) noexcept
+{
+  T value;
+  std::memcpy(&value, p, sizeof(T));
+  return value;
+}
+
+template <typename T>
+T load_bytes(const void* p, std::true_type) noexcept
+{
+  using uint_type = typename uint_of_size<sizeof(T)>::type;
+  uint_type bits;
+  std::memcpy(&bits, p, sizeof(T));
+  bits = byteswap_uint(bits);
+  T value;
+  std::memcpy(&value, &bits, sizeof(T));
+  return value;
+}
+
+template <typename T>
+void store_bytes(void* p, T value, std::false_type) noexcept
+{
+  std::memcpy(p, &value, sizeof(T));
+}
+
+template <typename T>
+void store_bytes(void* p, T value, std::true_type) noexcept
+{
+  using uint_type = typename uint_of_size<sizeof(T)>::type;
+  uint_type bits;
+  std::memcpy(&bits, &value, sizeof(T));
+  bits = byteswap_uint(bits);
+  std::memcpy(p, &bits, sizeof(T));
+}
+
+using swap_on_little_endian = bool_constant<!GUL_BIG_ENDIAN>;
+using swap_on_big_endian = bool_constant<GUL_BIG_ENDIAN != 0>;
+
+inline void byteswap_elements(unsigned char*,
+                              std::size_t,
+                              integral_constant<std::size_t, 1>) noexcept
+{
+}
+
+#ifdef GUL_HAS_SSSE3
+inline __m128i byteswap_mask(integral_constant<std::size_t, 2>) noexcept
+{
+  return _mm_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14);
+}
+
+inline __m128i byteswap_mask(integral_constant<std::size_t, 4>) noexcept
+{
+  return _mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+}
+
+inline __m128i byteswap_mask(integral_constant<std::size_t, 8>) noexcept
+{
+  return _mm_setr_epi8(7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8);
+}
+#endif
+
+template <std::size_t Size>
+void byteswap_elements(unsigned char* data,
+                       std::size_t count,
+                       integral_constant<std::size_t, Size> size) noexcept
+{
+  using uint_type = typename uint_of_size<Size>::type;
+  std::size_t i = 0;
+#ifdef GUL_HAS_SSSE3
+  const __m128i mask = byteswap_mask(size);
+#ifdef GUL_HAS_AVX2
+  const __m256i mask256
+      = _mm256_inserti128_si256(_mm256_castsi128_si256(mask), mask, 1);
+  for (; i + 32 / Size <= count; i += 32 / Size) {
+    const auto p = reinterpret_cast<__m256i*>(data + i * Size);
+    _mm256_storeu_si256(
+        p, _mm256_shuffle_epi8(_mm256_loadu_si256(p), mask256));
+  }
+#endif
+  for (; i + 16 / Size <= count; i += 16 / Size) {
+    const auto p = reinterpret_cast<__m128i*>(data + i * Size);
+    _mm_storeu_si128(p, _mm_shuffle_epi8(_mm_loadu_si128(p), mask));
+  }
+#else
+  GUL_UNUSED(size);
+#endif
+  for (; i < count; ++i) {
+    uint_type bits;
+    std::memcpy(&bits, data + i * Size, Size);
+    bits = byteswap_uint(bits);
+    std::memcpy(data + i * Size, &bits, Size);
+  }
+}
+
+template <typename B>
+using enable_if_byte_t
+    = enable_if_t<std::is_same<remove_cv_t<B>, byte>::value, int>;
+
+}
+
+template <typename T, GUL_REQUIRES(std::is_integral<T>::value)>
+T byteswap(T value) noexcept
+{
+  using uint_type = typename detail::uint_of_size<sizeof(T)>::type;
+  return static_cast<T>(detail::byteswap_uint(static_cast<uint_type>(value)));
+}
+
+// Reverses the byte order of every element of `s` in place.
+template <typename T,
+          std::size_t N,
+          GUL_REQUIRES(detail::is_endian_loadable<T>::value
+                       && !std::is_const<T>::value)>
+void byteswap(span<T, N> s) noexcept
+{
+  detail::byteswap_elements(reinterpret_cast<unsigned char*>(s.data()),
+                            s.size(),
+                            std::integral_constant<std::size_t, sizeof(T)> {});
+}
+
+template <typename T,
+          typename B,
+          std::size_t N,
+          GUL_REQUIRES(detail::is_endian_loadable<T>::value),
+          detail::enable_if_byte_t<B> = 0>
+T load_le(span<B, N> s, std::size_t offset = 0) noexcept
+{
+  GUL_ASSERT(offset <= s.size() && sizeof(T) <= s.size() - offset);
+  return detail::load_bytes<T>(s.data() + offset,
+                               detail::swap_on_big_endian {});
+}
+
+template <typename T,
+          typename B,
+          std::size_t N,
+          GUL_REQUIRES(detail::is_endian_loadable<T>::value),
+          detail::enable_if_byte_t<B> = 0>
+T load_be(span<B, N> s, std::size_t offset = 0) noexcept
+{
+  GUL_ASSERT(offset <= s.size() && sizeof(T) <= s.size() - offset);
+  return detail::load_bytes<T>(s.data() + offset,
+                               detail::swap_on_little_endian {});
+}
+
+template <typename T,
+          std::size_t N,
+          GUL_REQUIRES(detail::is_endian_loadable<T>::value)>
+void store_le(span<byte, N> s, std::size_t offset, T value) noexcept
+{
+  GUL_ASSERT(offset <= s.size() && sizeof(T) <= s.size() - offset);
+  detail::store_bytes(s.data() + offset, value,
+                      detail::swap_on_big_endian {});
+}
+
+template <typename T,
+          std::size_t N,
+          GUL_REQUIRES(detail::is_endian_loadable<T>::value)>
+void store_le(span<byte, N> s, T value) noexcept
+{
+  store_le(s, 0, value);
+}
+
+template <typename T,
+          std::size_t N,
+          GUL_REQUIRES(detail::is_endian_loadable<T>::value)>
+void store_be(span<byte, N> s, std::size_t offset, T value) noexcept
+{
+  GUL_ASSERT(offset <= s.size() && sizeof(T) <= s.size() - offset);
+  detail::store_bytes(s.data() + offset, value,
+                      detail::swap_on_little_endian {});
+}
+
+template <typename T,
+          std::size_t N,
+          GUL_REQUIRES(detail::is_endian_loadable<T>::value)>
+void store_be(span<byte, N> s, T value) noexcept
+{
+  store_be(s, 0, value);
+}
+
+GUL_NAMESPACE_END
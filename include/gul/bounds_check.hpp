@@ -0,0 +1,110 @@
+//
+// Copyright (c) 2022 Ramirisu (labyrinth dot ramirisu at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#pragma once
+
+#include <gul/config.hpp>
+
+#include <cstdlib>
+#include <stdexcept>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+#define GUL_BOUNDS_CHECK_NONE 0
+#define GUL_BOUNDS_CHECK_ASSERT 1
+#define GUL_BOUNDS_CHECK_TRAP 2
+#define GUL_BOUNDS_CHECK_THROW 3
+
+// Selects the policy `bounds_check_default` names for the translation unit.
+// It has to be defined the same way before every gul include of a
+// translation unit.
+#ifndef GUL_BOUNDS_CHECK
+#define GUL_BOUNDS_CHECK GUL_BOUNDS_CHECK_ASSERT
+#endif
+
+GUL_NAMESPACE_BEGIN
+
+namespace detail {
+
+[[noreturn]] inline void bounds_check_trap() noexcept
+{
+#if defined(__GNUC__) || defined(__clang__)
+  __builtin_trap();
+#elif defined(_MSC_VER)
+  // FAST_FAIL_FATAL_APP_EXIT
+  __fastfail(7);
+#else
+  std::abort();
+#endif
+}
+
+[[noreturn]] inline void bounds_check_throw()
+{
+#if GUL_NO_EXCEPTIONS
+  std::abort();
+#else
+  throw std::out_of_range("gul: access out of bounds");
+#endif
+}
+
+}
+
+// Performs no checking at all.
+struct bounds_check_none {
+  static GUL_CXX14_CONSTEXPR void check(bool in_bounds) noexcept
+  {
+    GUL_UNUSED(in_bounds);
+  }
+};
+
+// Checks with `GUL_ASSERT`, i.e. only when `NDEBUG` is not defined.
+struct bounds_check_assert {
+  static GUL_CXX14_CONSTEXPR void check(bool in_bounds) noexcept
+  {
+    GUL_ASSERT(in_bounds);
+    GUL_UNUSED(in_bounds);
+  }
+};
+
+// Executes a trap instruction, which costs a compare and a not-taken branch.
+struct bounds_check_trap {
+  static GUL_CXX14_CONSTEXPR void check(bool in_bounds) noexcept
+  {
+    if (!in_bounds) {
+      detail::bounds_check_trap();
+    }
+  }
+};
+
+// Throws `std::out_of_range`, or aborts when exceptions are disabled.
+struct bounds_check_throw {
+  static GUL_CXX14_CONSTEXPR void check(bool in_bounds)
+  {
+    if (!in_bounds) {
+      detail::bounds_check_throw();
+    }
+  }
+};
+
+// The policy selected by `GUL_BOUNDS_CHECK`. Being an alias, the policy is
+// part of the type of e.g. `span<T>`, so translation units that select
+// different policies use different types instead of breaking the ODR.
+#if GUL_BOUNDS_CHECK == GUL_BOUNDS_CHECK_NONE
+using bounds_check_default = bounds_check_none;
+#elif GUL_BOUNDS_CHECK == GUL_BOUNDS_CHECK_ASSERT
+using bounds_check_default = bounds_check_assert;
+#elif GUL_BOUNDS_CHECK == GUL_BOUNDS_CHECK_TRAP
+using bounds_check_default = bounds_check_trap;
+#elif GUL_BOUNDS_CHECK == GUL_BOUNDS_CHECK_THROW
+using bounds_check_default = bounds_check_throw;
+#else
+#error "GUL_BOUNDS_CHECK must name one of the GUL_BOUNDS_CHECK_* policies"
+#endif
+
+GUL_NAMESPACE_END
@@ -0,0 +1,175 @@
+//
+// Copyright (c) 2022 Ramirisu (labyrinth dot ramirisu at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#pragma once
+
+#include <gul/config.hpp>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define GUL_HAS_IOVEC
+#endif
+
+#include <gul/byte.hpp>
+#include <gul/span.hpp>
+#include <gul/string_view.hpp>
+#include <gul/type_traits.hpp>
+
+#include <cstddef>
+#include <cstring>
+#include <vector>
+
+#ifdef GUL_HAS_IOVEC
+#include <sys/uio.h>
+#endif
+
+GUL_NAMESPACE_BEGIN
+
+namespace detail {
+
+#ifdef GUL_HAS_IOVEC
+using iovec_type = ::iovec;
+#else
+struct iovec_type {
+  void* iov_base;
+  std::size_t iov_len;
+};
+#endif
+
+}
+
+// A list of non-owning byte buffers laid out as `struct iovec`s, so that it
+// can be handed to writev/readv/sendmsg without copying either the payload or
+// the buffer list. Empty buffers are not stored.
+template <typename B>
+class basic_buffer_sequence {
+  static_assert(std::is_same<remove_cv_t<B>, byte>::value,
+                "B must be byte or const byte");
+
+public:
+  using value_type = span<B>;
+  using size_type = std::size_t;
+  using iovec_type = detail::iovec_type;
+
+  basic_buffer_sequence() = default;
+
+  void reserve(size_type count)
+  {
+    buffers_.reserve(first_ + count);
+  }
+
+  void push_back(span<B> buffer)
+  {
+    if (buffer.empty()) {
+      return;
+    }
+    iovec_type entry;
+    entry.iov_base = const_cast<byte*>(buffer.data());
+    entry.iov_len = buffer.size();
+    buffers_.push_back(entry);
+    size_bytes_ += buffer.size();
+  }
+
+  template <typename C = B, GUL_REQUIRES(std::is_const<C>::value)>
+  void push_back(string_view str)
+  {
+    push_back(
+        span<B>(reinterpret_cast<const byte*>(str.data()), str.size()));
+  }
+
+  // The number of buffers.
+  size_type size() const noexcept
+  {
+    return buffers_.size() - first_;
+  }
+
+  bool empty() const noexcept
+  {
+    return size() == 0;
+  }
+
+  // The number of bytes over all buffers.
+  size_type size_bytes() const noexcept
+  {
+    return size_bytes_;
+  }
+
+  span<B> operator[](size_type index) const noexcept
+  {
+    GUL_ASSERT(index < size());
+    const auto& entry = buffers_[first_ + index];
+    return span<B>(static_cast<B*>(entry.iov_base), entry.iov_len);
+  }
+
+  // The buffers as an iovec array. writev and readv accept at most IOV_MAX
+  // entries, so longer sequences have to be passed in several calls.
+  span<const iovec_type> iovecs() const noexcept
+  {
+    return span<const iovec_type>(buffers_.data() + first_, size());
+  }
+
+  // Drops the first `count` bytes, e.g. the part a writev call accepted. A
+  // `count` beyond `size_bytes()` drops everything.
+  void consume(size_type count) noexcept
+  {
+    if (count > size_bytes_) {
+      count = size_bytes_;
+    }
+    size_bytes_ -= count;
+    while (count != 0) {
+      auto& entry = buffers_[first_];
+      if (count < entry.iov_len) {
+        entry.iov_base = static_cast<byte*>(entry.iov_base) + count;
+        entry.iov_len -= count;
+        break;
+      }
+      count -= entry.iov_len;
+      ++first_;
+    }
+    // Consumed entries are dropped once they make up half of the storage,
+    // which keeps it bounded when appending and consuming alternate.
+    if (first_ == buffers_.size()) {
+      clear();
+    } else if (first_ > buffers_.size() / 2) {
+      buffers_.erase(buffers_.begin(),
+                     buffers_.begin() + static_cast<std::ptrdiff_t>(first_));
+      first_ = 0;
+    }
+  }
+
+  // Copies the leading bytes into `dest` and returns how many were copied.
+  size_type copy_to(span<byte> dest) const noexcept
+  {
+    size_type copied = 0;
+    for (size_type i = first_;
+         i < buffers_.size() && copied < dest.size(); ++i) {
+      const size_type count = buffers_[i].iov_len < dest.size() - copied
+          ? buffers_[i].iov_len
+          : dest.size() - copied;
+      std::memcpy(dest.data() + copied, buffers_[i].iov_base, count);
+      copied += count;
+    }
+    return copied;
+  }
+
+  void clear() noexcept
+  {
+    buffers_.clear();
+    first_ = 0;
+    size_bytes_ = 0;
+  }
+
+private:
+  std::vector<iovec_type> buffers_;
+  // Fully consumed buffers are skipped rather than erased.
+  size_type first_ = 0;
+  size_type size_bytes_ = 0;
+};
+
+using buffer_sequence = basic_buffer_sequence<const byte>;
+using mutable_buffer_sequence = basic_buffer_sequence<byte>;
+
+GUL_NAMESPACE_END
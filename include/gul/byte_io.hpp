@@ -0,0 +1,346 @@
+//
+// Copyright (c) 2022 Ramirisu (labyrinth dot ramirisu at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#pragma once
+
+#include <gul/config.hpp>
+
+#include <gul/detail/bit.hpp>
+
+#include <gul/bit.hpp>
+#include <gul/byte.hpp>
+#include <gul/expected.hpp>
+#include <gul/span.hpp>
+#include <gul/string_view.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <system_error>
+
+GUL_NAMESPACE_BEGIN
+
+namespace detail {
+
+// Decodes a ULEB128 value of at most 8 bytes from the little-endian word
+// `word`, without a loop. Returns the encoded length, or 0 when the value
+// does not terminate within the word.
+inline std::size_t varint_decode8(std::uint64_t word,
+                                  std::uint64_t& value) noexcept
+{
+  const std::uint64_t stops = ~word & 0x8080808080808080;
+  if (stops == 0) {
+    return 0;
+  }
+  const auto length = std::size_t(countr_zero(stops) / 8 + 1);
+  // Keeps the bytes up to and including the stop byte.
+  std::uint64_t x = word & (stops ^ (stops - 1));
+  x = ((x & 0x7F007F007F007F00) >> 1) | (x & 0x007F007F007F007F);
+  x = ((x & 0x3FFF00003FFF0000) >> 2) | (x & 0x00003FFF00003FFF);
+  x = ((x & 0x0FFFFFFF00000000) >> 4) | (x & 0x000000000FFFFFFF);
+  value = x;
+  return length;
+}
+
+inline std::size_t varint_size(std::uint64_t value) noexcept
+{
+  return std::size_t((64 - countl_zero(value | 1) + 6) / 7);
+}
+
+inline std::size_t signed_varint_size(std::int64_t value) noexcept
+{
+  // One extra bit is needed for the sign.
+  const auto magnitude
+      = static_cast<std::uint64_t>(value < 0 ? ~value : value);
+  return std::size_t((64 - countl_zero(magnitude) + 7) / 7);
+}
+
+}
+
+class byte_reader {
+public:
+  using size_type = std::size_t;
+
+  constexpr byte_reader() noexcept = default;
+
+  constexpr explicit byte_reader(span<const byte> buffer) noexcept
+      : buffer_(buffer)
+  {
+  }
+
+  constexpr size_type position() const noexcept
+  {
+    return position_;
+  }
+
+  constexpr size_type remaining() const noexcept
+  {
+    return buffer_.size() - position_;
+  }
+
+  constexpr bool empty() const noexcept
+  {
+    return remaining() == 0;
+  }
+
+  span<const byte> remaining_bytes() const noexcept
+  {
+    return span<const byte>(buffer_.data() + position_, remaining());
+  }
+
+  auto skip(size_type count) noexcept -> expected<void, std::errc>
+  {
+    if (count > remaining()) {
+      return underflow();
+    }
+    position_ += count;
+    return {};
+  }
+
+  template <typename T,
+            GUL_REQUIRES(detail::is_endian_loadable<T>::value)>
+  auto read_le() noexcept -> expected<T, std::errc>
+  {
+    if (sizeof(T) > remaining()) {
+      return underflow();
+    }
+    const auto value = load_le<T>(buffer_, position_);
+    position_ += sizeof(T);
+    return value;
+  }
+
+  template <typename T,
+            GUL_REQUIRES(detail::is_endian_loadable<T>::value)>
+  auto read_be() noexcept -> expected<T, std::errc>
+  {
+    if (sizeof(T) > remaining()) {
+      return underflow();
+    }
+    const auto value = load_be<T>(buffer_, position_);
+    position_ += sizeof(T);
+    return value;
+  }
+
+  // Reads an unsigned LEB128 value.
+  auto read_varint() noexcept -> expected<std::uint64_t, std::errc>
+  {
+    const auto p = reinterpret_cast<const unsigned char*>(buffer_.data())
+        + position_;
+    std::uint64_t value = 0;
+    if (remaining() >= 8) {
+      const auto length
+          = detail::varint_decode8(detail::load_u64_le(p), value);
+      if (length != 0) {
+        position_ += length;
+        return value;
+      }
+    }
+    const size_type count = remaining() < 10 ? remaining() : 10;
+    for (size_type i = 0; i < count; ++i) {
+      const std::uint64_t b = p[i];
+      if (i == 9 && b > 1) {
+        return malformed();
+      }
+      value |= (b & 0x7F) << (7 * i);
+      if (b < 0x80) {
+        position_ += i + 1;
+        return value;
+      }
+    }
+    return count == 10 ? malformed() : underflow();
+  }
+
+  // Reads a signed LEB128 value.
+  auto read_signed_varint() noexcept -> expected<std::int64_t, std::errc>
+  {
+    const auto p = reinterpret_cast<const unsigned char*>(buffer_.data())
+        + position_;
+    std::uint64_t value = 0;
+    const size_type count = remaining() < 10 ? remaining() : 10;
+    for (size_type i = 0; i < count; ++i) {
+      const std::uint64_t b = p[i];
+      if (i == 9 && b != 0x00 && b != 0x7F) {
+        return malformed();
+      }
+      value |= (b & 0x7F) << (7 * i);
+      if (b < 0x80) {
+        if (i < 9 && (b & 0x40) != 0) {
+          value |= ~std::uint64_t(0) << (7 * (i + 1));
+        }
+        position_ += i + 1;
+        return static_cast<std::int64_t>(value);
+      }
+    }
+    return count == 10 ? malformed() : underflow();
+  }
+
+  auto read_bytes(size_type count) noexcept
+      -> expected<span<const byte>, std::errc>
+  {
+    if (count > remaining()) {
+      return underflow();
+    }
+    const auto result = span<const byte>(buffer_.data() + position_, count);
+    position_ += count;
+    return result;
+  }
+
+  // Reads a string prefixed with its length as an unsigned LEB128 value.
+  auto read_string() noexcept -> expected<string_view, std::errc>
+  {
+    const auto start = position_;
+    const auto length = read_varint();
+    if (!length) {
+      return unexpected<std::errc>(length.error());
+    }
+    if (*length > remaining()) {
+      position_ = start;
+      return underflow();
+    }
+    const auto result = string_view(
+        reinterpret_cast<const char*>(buffer_.data() + position_),
+        static_cast<size_type>(*length));
+    position_ += result.size();
+    return result;
+  }
+
+private:
+  static unexpected<std::errc> underflow() noexcept
+  {
+    return unexpected<std::errc>(std::errc::result_out_of_range);
+  }
+
+  static unexpected<std::errc> malformed() noexcept
+  {
+    return unexpected<std::errc>(std::errc::illegal_byte_sequence);
+  }
+
+  span<const byte> buffer_;
+  size_type position_ = 0;
+};
+
+class byte_writer {
+public:
+  using size_type = std::size_t;
+
+  constexpr byte_writer() noexcept = default;
+
+  constexpr explicit byte_writer(span<byte> buffer) noexcept
+      : buffer_(buffer)
+  {
+  }
+
+  constexpr size_type position() const noexcept
+  {
+    return position_;
+  }
+
+  constexpr size_type remaining() const noexcept
+  {
+    return buffer_.size() - position_;
+  }
+
+  // Returns the part of the buffer that has been written so far.
+  span<byte> written() const noexcept
+  {
+    return span<byte>(buffer_.data(), position_);
+  }
+
+  template <typename T,
+            GUL_REQUIRES(detail::is_endian_loadable<T>::value)>
+  auto write_le(T value) noexcept -> expected<void, std::errc>
+  {
+    if (sizeof(T) > remaining()) {
+      return overflow();
+    }
+    store_le(buffer_, position_, value);
+    position_ += sizeof(T);
+    return {};
+  }
+
+  template <typename T,
+            GUL_REQUIRES(detail::is_endian_loadable<T>::value)>
+  auto write_be(T value) noexcept -> expected<void, std::errc>
+  {
+    if (sizeof(T) > remaining()) {
+      return overflow();
+    }
+    store_be(buffer_, position_, value);
+    position_ += sizeof(T);
+    return {};
+  }
+
+  // Writes an unsigned LEB128 value.
+  auto write_varint(std::uint64_t value) noexcept -> expected<void, std::errc>
+  {
+    const size_type size = detail::varint_size(value);
+    if (size > remaining()) {
+      return overflow();
+    }
+    auto p = reinterpret_cast<unsigned char*>(buffer_.data()) + position_;
+    for (size_type i = 0; i + 1 < size; ++i) {
+      p[i] = static_cast<unsigned char>(value | 0x80);
+      value >>= 7;
+    }
+    p[size - 1] = static_cast<unsigned char>(value);
+    position_ += size;
+    return {};
+  }
+
+  // Writes a signed LEB128 value.
+  auto write_signed_varint(std::int64_t value) noexcept
+      -> expected<void, std::errc>
+  {
+    const size_type size = detail::signed_varint_size(value);
+    if (size > remaining()) {
+      return overflow();
+    }
+    auto p = reinterpret_cast<unsigned char*>(buffer_.data()) + position_;
+    for (size_type i = 0; i + 1 < size; ++i) {
+      p[i] = static_cast<unsigned char>(value | 0x80);
+      value >>= 7;
+    }
+    p[size - 1] = static_cast<unsigned char>(value & 0x7F);
+    position_ += size;
+    return {};
+  }
+
+  auto write_bytes(span<const byte> bytes) noexcept
+      -> expected<void, std::errc>
+  {
+    if (bytes.size() > remaining()) {
+      return overflow();
+    }
+    if (!bytes.empty()) {
+      std::memcpy(buffer_.data() + position_, bytes.data(), bytes.size());
+    }
+    position_ += bytes.size();
+    return {};
+  }
+
+  // Writes a string prefixed with its length as an unsigned LEB128 value.
+  auto write_string(string_view str) noexcept -> expected<void, std::errc>
+  {
+    if (detail::varint_size(str.size()) + str.size() > remaining()) {
+      return overflow();
+    }
+    write_varint(str.size());
+    return write_bytes(span<const byte>(
+        reinterpret_cast<const byte*>(str.data()), str.size()));
+  }
+
+private:
+  static unexpected<std::errc> overflow() noexcept
+  {
+    return unexpected<std::errc>(std::errc::no_buffer_space);
+  }
+
+  span<byte> buffer_;
+  size_type position_ = 0;
+};
+
+GUL_NAMESPACE_END
@@ -0,0 +1,247 @@
+//
+// Copyright (c) 2022 Ramirisu (labyrinth dot ramirisu at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#pragma once
+
+#include <gul/config.hpp>
+
+#include <gul/detail/charconv.hpp>
+
+#include <gul/expected.hpp>
+#include <gul/span.hpp>
+#include <gul/string_view.hpp>
+#include <gul/type_traits.hpp>
+
+#include <limits>
+#include <system_error>
+
+GUL_NAMESPACE_BEGIN
+
+enum class chars_format {
+  scientific = 0x1,
+  fixed = 0x2,
+  general = fixed | scientific,
+};
+
+template <typename T>
+struct from_chars_result {
+  T value;
+  std::size_t size;
+};
+
+namespace detail {
+
+template <typename T>
+using from_chars_expected = expected<from_chars_result<T>, std::errc>;
+
+template <typename T>
+inline from_chars_expected<T> from_chars_integer(const char* first,
+                                                 const char* last,
+                                                 int base,
+                                                 std::true_type)
+{
+  using UInt = typename std::make_unsigned<T>::type;
+  const bool negative = first != last && *first == '-';
+  const char* digits_first = negative ? first + 1 : first;
+
+  UInt magnitude;
+  bool overflow;
+  const char* p = parse_unsigned(digits_first, last, unsigned(base), magnitude,
+                                 overflow);
+  if (p == digits_first) {
+    return unexpected<std::errc>(std::errc::invalid_argument);
+  }
+
+  const UInt limit = negative ? UInt(UInt(std::numeric_limits<T>::max()) + 1)
+                              : UInt(std::numeric_limits<T>::max());
+  if (overflow || magnitude > limit) {
+    return unexpected<std::errc>(std::errc::result_out_of_range);
+  }
+
+  const T value
+      = negative ? T(UInt(0) - magnitude) : static_cast<T>(magnitude);
+  return from_chars_result<T> { value, std::size_t(p - first) };
+}
+
+template <typename T>
+inline from_chars_expected<T> from_chars_integer(const char* first,
+                                                 const char* last,
+                                                 int base,
+                                                 std::false_type)
+{
+  T value;
+  bool overflow;
+  const char* p = parse_unsigned(first, last, unsigned(base), value, overflow);
+  if (p == first) {
+    return unexpected<std::errc>(std::errc::invalid_argument);
+  }
+  if (overflow) {
+    return unexpected<std::errc>(std::errc::result_out_of_range);
+  }
+
+  return from_chars_result<T> { value, std::size_t(p - first) };
+}
+
+template <typename T>
+inline from_chars_expected<T>
+from_chars_float(const char* first, const char* last, chars_format fmt)
+{
+  const bool negative = first != last && *first == '-';
+  const char* p = negative ? first + 1 : first;
+  if (starts_with_icase(p, last, "inf")) {
+    p += 3;
+    if (starts_with_icase(p, last, "inity")) {
+      p += 5;
+    }
+    const T value = std::numeric_limits<T>::infinity();
+    return from_chars_result<T> { negative ? -value : value,
+                                  std::size_t(p - first) };
+  }
+  if (starts_with_icase(p, last, "nan")) {
+    p += 3;
+    if (p != last && *p == '(') {
+      const char* q = p + 1;
+      while (q != last && (*q == '_' || char_to_digit(*q) < 36u)) {
+        ++q;
+      }
+      if (q != last && *q == ')') {
+        p = q + 1;
+      }
+    }
+    const T value = std::numeric_limits<T>::quiet_NaN();
+    return from_chars_result<T> { negative ? -value : value,
+                                  std::size_t(p - first) };
+  }
+
+  const auto format = to_underlying(fmt);
+  decimal_literal literal;
+  if (!parse_decimal_literal(
+          first, last, (format & to_underlying(chars_format::scientific)) != 0,
+          format == to_underlying(chars_format::scientific), literal)) {
+    return unexpected<std::errc>(std::errc::invalid_argument);
+  }
+
+  bool out_of_range;
+  const T value = decimal_literal_to_float<T>(literal, out_of_range);
+  if (out_of_range) {
+    return unexpected<std::errc>(std::errc::result_out_of_range);
+  }
+
+  return from_chars_result<T> { value, std::size_t(literal.last - first) };
+}
+
+}
+
+template <typename T,
+          GUL_REQUIRES(std::is_integral<T>::value
+                       && !std::is_same<remove_cv_t<T>, bool>::value)>
+inline auto from_chars(string_view str, int base = 10)
+    -> expected<from_chars_result<T>, std::errc>
+{
+  GUL_ASSERT(2 <= base && base <= 36);
+  return detail::from_chars_integer<T>(str.data(), str.data() + str.size(),
+                                       base, std::is_signed<T> {});
+}
+
+template <typename T,
+          std::size_t Extent,
+          GUL_REQUIRES(std::is_integral<T>::value
+                       && !std::is_same<remove_cv_t<T>, bool>::value)>
+inline auto from_chars(span<const char, Extent> str, int base = 10)
+    -> expected<from_chars_result<T>, std::errc>
+{
+  return from_chars<T>(string_view(str.data(), str.size()), base);
+}
+
+template <typename T,
+          GUL_REQUIRES(std::is_same<T, float>::value
+                       || std::is_same<T, double>::value)>
+inline auto from_chars(string_view str,
+                       chars_format fmt = chars_format::general)
+    -> expected<from_chars_result<T>, std::errc>
+{
+  return detail::from_chars_float<T>(str.data(), str.data() + str.size(),
+                                     fmt);
+}
+
+template <typename T,
+          std::size_t Extent,
+          GUL_REQUIRES(std::is_same<T, float>::value
+                       || std::is_same<T, double>::value)>
+inline auto from_chars(span<const char, Extent> str,
+                       chars_format fmt = chars_format::general)
+    -> expected<from_chars_result<T>, std::errc>
+{
+  return from_chars<T>(string_view(str.data(), str.size()), fmt);
+}
+
+template <typename T,
+          GUL_REQUIRES(std::is_integral<T>::value
+                       && !std::is_same<remove_cv_t<T>, bool>::value)>
+inline auto to_chars(span<char> buffer, T value, int base = 10) noexcept
+    -> expected<std::size_t, std::errc>
+{
+  GUL_ASSERT(2 <= base && base <= 36);
+  using UInt = typename std::make_unsigned<T>::type;
+  const bool negative = value < 0;
+  const std::uint64_t magnitude
+      = negative ? UInt(UInt(0) - UInt(value)) : UInt(value);
+  const int num_digits = base == 10
+      ? detail::count_digits(magnitude)
+      : detail::count_digits(magnitude, unsigned(base));
+
+  const std::size_t size = std::size_t(num_digits) + (negative ? 1 : 0);
+  if (size > buffer.size()) {
+    return unexpected<std::errc>(std::errc::value_too_large);
+  }
+
+  char* last = buffer.data() + size;
+  if (base == 10) {
+    detail::write_digits(last, magnitude);
+  } else {
+    detail::write_digits(last, magnitude, unsigned(base));
+  }
+  if (negative) {
+    buffer[0] = '-';
+  }
+  return size;
+}
+
+template <typename T,
+          GUL_REQUIRES(std::is_same<T, float>::value
+                       || std::is_same<T, double>::value)>
+inline auto to_chars(span<char> buffer, T value) noexcept
+    -> expected<std::size_t, std::errc>
+{
+  const auto size
+      = detail::format_float(buffer.data(), buffer.data() + buffer.size(),
+                             value, detail::float_format::shortest);
+  if (size < 0) {
+    return unexpected<std::errc>(std::errc::value_too_large);
+  }
+  return std::size_t(size);
+}
+
+template <typename T,
+          GUL_REQUIRES(std::is_same<T, float>::value
+                       || std::is_same<T, double>::value)>
+inline auto to_chars(span<char> buffer, T value, chars_format fmt) noexcept
+    -> expected<std::size_t, std::errc>
+{
+  const auto format = fmt == chars_format::scientific
+      ? detail::float_format::scientific
+      : fmt == chars_format::fixed ? detail::float_format::fixed
+                                   : detail::float_format::general;
+  const auto size = detail::format_float(
+      buffer.data(), buffer.data() + buffer.size(), value, format);
+  if (size < 0) {
+    return unexpected<std::errc>(std::errc::value_too_large);
+  }
+  return std::size_t(size);
+}
+
+GUL_NAMESPACE_END
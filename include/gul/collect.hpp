@@ -0,0 +1,324 @@
+//
+// Copyright (c) 2022 Ramirisu (labyrinth dot ramirisu at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#pragma once
+
+#include <gul/config.hpp>
+
+#include <gul/algorithm.hpp>
+#include <gul/expected.hpp>
+#include <gul/optional.hpp>
+#include <gul/optional_array.hpp>
+#include <gul/span.hpp>
+#include <gul/type_traits.hpp>
+#include <gul/utility.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+GUL_NAMESPACE_BEGIN
+
+namespace detail {
+
+template <typename Opt>
+struct collect_traits { };
+
+template <typename T>
+struct collect_traits<optional<T>> {
+  using value_type = T;
+
+  template <typename V>
+  using rebind = optional<V>;
+
+  template <typename R, typename Opt>
+  static R failure(Opt&&)
+  {
+    return R(nullopt);
+  }
+};
+
+template <typename T, typename E>
+struct collect_traits<expected<T, E>> {
+  using value_type = T;
+  using error_type = E;
+
+  template <typename V>
+  using rebind = expected<V, E>;
+
+  template <typename R, typename Exp>
+  static R failure(Exp&& exp)
+  {
+    return R(unexpect, std::forward<Exp>(exp).error());
+  }
+};
+
+template <typename Opt>
+using collect_value_t = typename collect_traits<remove_cv_t<Opt>>::value_type;
+
+template <typename Opt>
+using collect_error_t = typename collect_traits<remove_cv_t<Opt>>::error_type;
+
+template <typename Opt>
+using sequence_result_t = typename collect_traits<
+    remove_cv_t<Opt>>::template rebind<std::vector<collect_value_t<Opt>>>;
+
+template <typename Opt>
+struct is_collectable
+    : disjunction<is_specialization_of<remove_cv_t<Opt>, optional>,
+                  is_specialization_of<remove_cv_t<Opt>, expected>> { };
+
+// Moves the values of `[first, first + count)` into `out` up to the first
+// element without one and returns its offset, or `count`.
+template <typename Opt, typename V>
+std::size_t take_values(Opt* first, std::size_t count, std::vector<V>& out)
+{
+  for (std::size_t i = 0; i < count; ++i) {
+    if (!first[i].has_value()) {
+      return i;
+    }
+    out.push_back(*std::move(first[i]));
+  }
+  return count;
+}
+
+template <typename Opt, typename V>
+void take_present_values(Opt* first, std::size_t count, std::vector<V>& out)
+{
+  for (std::size_t i = 0; i < count; ++i) {
+    if (first[i].has_value()) {
+      out.push_back(*std::move(first[i]));
+    }
+  }
+}
+
+template <typename Exp, typename V, typename E>
+void take_partition(Exp* first,
+                    std::size_t count,
+                    std::vector<V>& values,
+                    std::vector<E>& errors)
+{
+  for (std::size_t i = 0; i < count; ++i) {
+    if (first[i].has_value()) {
+      values.push_back(*std::move(first[i]));
+    } else {
+      errors.push_back(std::move(first[i]).error());
+    }
+  }
+}
+
+template <typename V>
+void append_parts(std::vector<std::vector<V>>& parts, std::vector<V>& out)
+{
+  std::size_t total = out.size();
+  for (auto& part : parts) {
+    total += part.size();
+  }
+  out.reserve(total);
+  for (auto& part : parts) {
+    out.insert(out.end(), std::make_move_iterator(part.begin()),
+               std::make_move_iterator(part.end()));
+  }
+}
+
+}
+
+// These take a span of `optional`s or `expected`s and make a single pass,
+// moving the values out of a mutable span and copying them out of a const
+// one. The overloads taking a `parallel_policy` process chunks on several
+// threads and concatenate the results in order; moving the elements must
+// not throw there.
+
+// Returns all values, or nothing as soon as an element holds none: `nullopt`
+// for `optional`s, or the first error for `expected`s.
+template <typename Opt,
+          std::size_t N,
+          GUL_REQUIRES(detail::is_collectable<Opt>::value)>
+detail::sequence_result_t<Opt> sequence(span<Opt, N> s)
+{
+  using traits = detail::collect_traits<remove_cv_t<Opt>>;
+  using result_type = detail::sequence_result_t<Opt>;
+  std::vector<detail::collect_value_t<Opt>> values;
+  values.reserve(s.size());
+  const std::size_t failed = detail::take_values(s.data(), s.size(), values);
+  if (failed != s.size()) {
+    return traits::template failure<result_type>(std::move(s[failed]));
+  }
+  return result_type(in_place, std::move(values));
+}
+
+template <typename Opt,
+          std::size_t N,
+          GUL_REQUIRES(detail::is_collectable<Opt>::value)>
+detail::sequence_result_t<Opt> sequence(const parallel_policy& policy,
+                                        span<Opt, N> s)
+{
+  using traits = detail::collect_traits<remove_cv_t<Opt>>;
+  using result_type = detail::sequence_result_t<Opt>;
+  using value_type = detail::collect_value_t<Opt>;
+  const std::size_t chunk = detail::chunk_elements(policy, sizeof(Opt));
+  std::vector<std::vector<value_type>> parts(
+      detail::chunk_count(s.size(), chunk));
+  std::atomic<std::size_t> first_failed(s.size());
+  detail::parallel_for_chunks(
+      policy, s.size(), chunk,
+      [&](std::size_t index, std::size_t offset, std::size_t length) {
+        // Chunks past a known failure are not needed.
+        if (offset > first_failed.load(std::memory_order_relaxed)) {
+          return;
+        }
+        parts[index].reserve(length);
+        const std::size_t failed
+            = detail::take_values(s.data() + offset, length, parts[index]);
+        if (failed == length) {
+          return;
+        }
+        std::size_t current = first_failed.load(std::memory_order_relaxed);
+        while (offset + failed < current
+               && !first_failed.compare_exchange_weak(
+                   current, offset + failed, std::memory_order_relaxed)) {
+        }
+      });
+  const std::size_t failed = first_failed.load(std::memory_order_relaxed);
+  if (failed != s.size()) {
+    return traits::template failure<result_type>(std::move(s[failed]));
+  }
+  std::vector<value_type> values;
+  detail::append_parts(parts, values);
+  return result_type(in_place, std::move(values));
+}
+
+// Returns the values of the elements that hold one, skipping `nullopt`s and
+// errors.
+template <typename Opt,
+          std::size_t N,
+          GUL_REQUIRES(detail::is_collectable<Opt>::value)>
+std::vector<detail::collect_value_t<Opt>> collect(span<Opt, N> s)
+{
+  std::vector<detail::collect_value_t<Opt>> values;
+  values.reserve(s.size());
+  detail::take_present_values(s.data(), s.size(), values);
+  return values;
+}
+
+template <typename Opt,
+          std::size_t N,
+          GUL_REQUIRES(detail::is_collectable<Opt>::value)>
+std::vector<detail::collect_value_t<Opt>> collect(const parallel_policy& policy,
+                                                  span<Opt, N> s)
+{
+  using value_type = detail::collect_value_t<Opt>;
+  const std::size_t chunk = detail::chunk_elements(policy, sizeof(Opt));
+  std::vector<std::vector<value_type>> parts(
+      detail::chunk_count(s.size(), chunk));
+  detail::parallel_for_chunks(
+      policy, s.size(), chunk,
+      [&](std::size_t index, std::size_t offset, std::size_t length) {
+        parts[index].reserve(length);
+        detail::take_present_values(s.data() + offset, length, parts[index]);
+      });
+  std::vector<value_type> values;
+  detail::append_parts(parts, values);
+  return values;
+}
+
+// Splits `expected`s into their values and their errors, both in order.
+// Capacity is reserved for the values only, errors being expected to be
+// rare.
+template <typename Exp,
+          std::size_t N,
+          GUL_REQUIRES(
+              detail::is_specialization_of<remove_cv_t<Exp>, expected>::value)>
+std::pair<std::vector<detail::collect_value_t<Exp>>,
+          std::vector<detail::collect_error_t<Exp>>>
+partition(span<Exp, N> s)
+{
+  std::pair<std::vector<detail::collect_value_t<Exp>>,
+            std::vector<detail::collect_error_t<Exp>>>
+      result;
+  result.first.reserve(s.size());
+  detail::take_partition(s.data(), s.size(), result.first, result.second);
+  return result;
+}
+
+template <typename Exp,
+          std::size_t N,
+          GUL_REQUIRES(
+              detail::is_specialization_of<remove_cv_t<Exp>, expected>::value)>
+std::pair<std::vector<detail::collect_value_t<Exp>>,
+          std::vector<detail::collect_error_t<Exp>>>
+partition(const parallel_policy& policy, span<Exp, N> s)
+{
+  using value_type = detail::collect_value_t<Exp>;
+  using error_type = detail::collect_error_t<Exp>;
+  const std::size_t chunk = detail::chunk_elements(policy, sizeof(Exp));
+  const std::size_t chunks = detail::chunk_count(s.size(), chunk);
+  std::vector<std::vector<value_type>> values(chunks);
+  std::vector<std::vector<error_type>> errors(chunks);
+  detail::parallel_for_chunks(
+      policy, s.size(), chunk,
+      [&](std::size_t index, std::size_t offset, std::size_t length) {
+        values[index].reserve(length);
+        detail::take_partition(s.data() + offset, length, values[index],
+                               errors[index]);
+      });
+  std::pair<std::vector<value_type>, std::vector<error_type>> result;
+  detail::append_parts(values, result.first);
+  detail::append_parts(errors, result.second);
+  return result;
+}
+
+// Turns a span of `optional`s into a column of values with a validity
+// bitmap. `T` has to be default constructible, for the null slots, and not
+// `bool`, which `optional_array` does not support.
+template <typename Opt,
+          std::size_t N,
+          GUL_REQUIRES(
+              detail::is_specialization_of<remove_cv_t<Opt>, optional>::value)>
+optional_array<detail::collect_value_t<Opt>> transpose(span<Opt, N> s)
+{
+  optional_array<detail::collect_value_t<Opt>> result;
+  result.reserve(s.size());
+  for (auto& element : s) {
+    if (element.has_value()) {
+      result.push_back(*std::move(element));
+    } else {
+      result.push_back(nullopt);
+    }
+  }
+  return result;
+}
+
+// Chunks are rounded to whole bitmap words, so that no two threads write to
+// the same word.
+template <typename Opt,
+          std::size_t N,
+          GUL_REQUIRES(
+              detail::is_specialization_of<remove_cv_t<Opt>, optional>::value)>
+optional_array<detail::collect_value_t<Opt>>
+transpose(const parallel_policy& policy, span<Opt, N> s)
+{
+  using result_type = optional_array<detail::collect_value_t<Opt>>;
+  const std::size_t bits = result_type::bits_per_word;
+  const std::size_t chunk
+      = (detail::chunk_elements(policy, sizeof(Opt)) + bits - 1) / bits * bits;
+  result_type result(s.size());
+  detail::parallel_for_chunks(
+      policy, s.size(), chunk,
+      [&](std::size_t, std::size_t offset, std::size_t length) {
+        for (std::size_t i = offset; i < offset + length; ++i) {
+          if (s[i].has_value()) {
+            result.set(i, *std::move(s[i]));
+          }
+        }
+      });
+  return result;
+}
+
+GUL_NAMESPACE_END
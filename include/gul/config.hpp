@@ -63,6 +63,30 @@
 #define GUL_CXX_COMPILER_MSVC2015
 #endif
 
+#if defined(__GNUC__) || defined(__clang__)
+#define GUL_COLD __attribute__((cold))
+#define GUL_NOINLINE __attribute__((noinline))
+#elif defined(GUL_CXX_COMPILER_MSVC)
+#define GUL_COLD
+#define GUL_NOINLINE __declspec(noinline)
+#else
+#define GUL_COLD
+#define GUL_NOINLINE
+#endif
+
+#define GUL_BAD_ACCESS_THROW 0
+#define GUL_BAD_ACCESS_TERMINATE 1
+#define GUL_BAD_ACCESS_TRAP 2
+
+// Selects what `optional::value()` and `expected::value()` do when there is
+// no value: throw (abort when exceptions are disabled), call
+// `std::terminate()`, or execute a trap instruction. It changes the bodies of
+// inline functions but no types, so it has to be defined the same way in
+// every translation unit of the program.
+#ifndef GUL_BAD_ACCESS
+#define GUL_BAD_ACCESS GUL_BAD_ACCESS_THROW
+#endif
+
 #if defined(GUL_HAS_CXX14) && !defined(GUL_CXX_COMPILER_MSVC2015)
 #define GUL_CXX14_CONSTEXPR constexpr
 #else
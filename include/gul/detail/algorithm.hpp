@@ -0,0 +1,411 @@
+//
+// Copyright (c) 2022 Ramirisu (labyrinth dot ramirisu at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#pragma once
+
+#include <gul/config.hpp>
+
+#include <gul/detail/bit.hpp>
+
+#include <gul/type_traits.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+
+GUL_NAMESPACE_BEGIN
+
+namespace detail {
+
+// Sums with several independent accumulators, so the loop carries no serial
+// dependency and the compiler can keep the accumulators in vector registers.
+template <typename T, typename U>
+U sum_kernel(const T* p, std::size_t n, U init)
+{
+  U acc[8] = {};
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    for (std::size_t k = 0; k < 8; ++k) {
+      acc[k] += p[i + k];
+    }
+  }
+  for (; i < n; ++i) {
+    acc[0] += p[i];
+  }
+  return init + (((acc[0] + acc[1]) + (acc[2] + acc[3]))
+                 + ((acc[4] + acc[5]) + (acc[6] + acc[7])));
+}
+
+template <typename T, typename V, typename U>
+U dot_kernel(const T* a, const V* b, std::size_t n, U init)
+{
+  U acc[8] = {};
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    for (std::size_t k = 0; k < 8; ++k) {
+      acc[k] += a[i + k] * b[i + k];
+    }
+  }
+  for (; i < n; ++i) {
+    acc[0] += a[i] * b[i];
+  }
+  return init + (((acc[0] + acc[1]) + (acc[2] + acc[3]))
+                 + ((acc[4] + acc[5]) + (acc[6] + acc[7])));
+}
+
+template <typename T>
+std::pair<T, T> minmax_kernel(const T* p, std::size_t n)
+{
+  T lo[4] = { p[0], p[0], p[0], p[0] };
+  T hi[4] = { p[0], p[0], p[0], p[0] };
+  std::size_t i = 1;
+  for (; i + 4 <= n; i += 4) {
+    for (std::size_t k = 0; k < 4; ++k) {
+      lo[k] = p[i + k] < lo[k] ? p[i + k] : lo[k];
+      hi[k] = hi[k] < p[i + k] ? p[i + k] : hi[k];
+    }
+  }
+  for (; i < n; ++i) {
+    lo[0] = p[i] < lo[0] ? p[i] : lo[0];
+    hi[0] = hi[0] < p[i] ? p[i] : hi[0];
+  }
+  for (std::size_t k = 1; k < 4; ++k) {
+    lo[0] = lo[k] < lo[0] ? lo[k] : lo[0];
+    hi[0] = hi[0] < hi[k] ? hi[k] : hi[0];
+  }
+  return std::pair<T, T>(lo[0], hi[0]);
+}
+
+template <typename T, typename U>
+std::size_t count_kernel(const T* p, std::size_t n, const U& value)
+{
+  std::size_t result = 0;
+  for (std::size_t i = 0; i < n; ++i) {
+    result += p[i] == value ? 1 : 0;
+  }
+  return result;
+}
+
+template <typename T, typename U>
+std::size_t find_kernel(const T* p, std::size_t n, const U& value)
+{
+  std::size_t i = 0;
+  for (; i < n; ++i) {
+    if (p[i] == value) {
+      break;
+    }
+  }
+  return i;
+}
+
+template <typename T, typename U>
+void prefix_sum_kernel(const T* in, std::size_t n, U* out)
+{
+  if (n == 0) {
+    return;
+  }
+  U acc = in[0];
+  out[0] = acc;
+  for (std::size_t i = 1; i < n; ++i) {
+    acc = acc + in[i];
+    out[i] = acc;
+  }
+}
+
+#ifdef GUL_HAS_SSE2
+inline float sum_kernel(const float* p, std::size_t n, float init)
+{
+  __m128 acc0 = _mm_setzero_ps();
+  __m128 acc1 = _mm_setzero_ps();
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    acc0 = _mm_add_ps(acc0, _mm_loadu_ps(p + i));
+    acc1 = _mm_add_ps(acc1, _mm_loadu_ps(p + i + 4));
+  }
+  float lanes[4];
+  _mm_storeu_ps(lanes, _mm_add_ps(acc0, acc1));
+  float tail = 0;
+  for (; i < n; ++i) {
+    tail += p[i];
+  }
+  return init + (((lanes[0] + lanes[1]) + (lanes[2] + lanes[3])) + tail);
+}
+
+inline double sum_kernel(const double* p, std::size_t n, double init)
+{
+  __m128d acc0 = _mm_setzero_pd();
+  __m128d acc1 = _mm_setzero_pd();
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    acc0 = _mm_add_pd(acc0, _mm_loadu_pd(p + i));
+    acc1 = _mm_add_pd(acc1, _mm_loadu_pd(p + i + 2));
+  }
+  double lanes[2];
+  _mm_storeu_pd(lanes, _mm_add_pd(acc0, acc1));
+  double tail = 0;
+  for (; i < n; ++i) {
+    tail += p[i];
+  }
+  return init + ((lanes[0] + lanes[1]) + tail);
+}
+
+inline float
+dot_kernel(const float* a, const float* b, std::size_t n, float init)
+{
+  __m128 acc0 = _mm_setzero_ps();
+  __m128 acc1 = _mm_setzero_ps();
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    acc0 = _mm_add_ps(acc0,
+                      _mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+    acc1 = _mm_add_ps(
+        acc1, _mm_mul_ps(_mm_loadu_ps(a + i + 4), _mm_loadu_ps(b + i + 4)));
+  }
+  float lanes[4];
+  _mm_storeu_ps(lanes, _mm_add_ps(acc0, acc1));
+  float tail = 0;
+  for (; i < n; ++i) {
+    tail += a[i] * b[i];
+  }
+  return init + (((lanes[0] + lanes[1]) + (lanes[2] + lanes[3])) + tail);
+}
+
+inline double
+dot_kernel(const double* a, const double* b, std::size_t n, double init)
+{
+  __m128d acc0 = _mm_setzero_pd();
+  __m128d acc1 = _mm_setzero_pd();
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    acc0 = _mm_add_pd(acc0,
+                      _mm_mul_pd(_mm_loadu_pd(a + i), _mm_loadu_pd(b + i)));
+    acc1 = _mm_add_pd(
+        acc1, _mm_mul_pd(_mm_loadu_pd(a + i + 2), _mm_loadu_pd(b + i + 2)));
+  }
+  double lanes[2];
+  _mm_storeu_pd(lanes, _mm_add_pd(acc0, acc1));
+  double tail = 0;
+  for (; i < n; ++i) {
+    tail += a[i] * b[i];
+  }
+  return init + ((lanes[0] + lanes[1]) + tail);
+}
+
+inline std::pair<float, float> minmax_kernel(const float* p, std::size_t n)
+{
+  __m128 lo = _mm_set1_ps(p[0]);
+  __m128 hi = lo;
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    const __m128 x = _mm_loadu_ps(p + i);
+    lo = _mm_min_ps(x, lo);
+    hi = _mm_max_ps(x, hi);
+  }
+  float los[4];
+  float his[4];
+  _mm_storeu_ps(los, lo);
+  _mm_storeu_ps(his, hi);
+  for (std::size_t k = 1; k < 4; ++k) {
+    los[0] = los[k] < los[0] ? los[k] : los[0];
+    his[0] = his[0] < his[k] ? his[k] : his[0];
+  }
+  for (; i < n; ++i) {
+    los[0] = p[i] < los[0] ? p[i] : los[0];
+    his[0] = his[0] < p[i] ? p[i] : his[0];
+  }
+  return std::pair<float, float>(los[0], his[0]);
+}
+
+inline std::pair<double, double> minmax_kernel(const double* p, std::size_t n)
+{
+  __m128d lo = _mm_set1_pd(p[0]);
+  __m128d hi = lo;
+  std::size_t i = 0;
+  for (; i + 2 <= n; i += 2) {
+    const __m128d x = _mm_loadu_pd(p + i);
+    lo = _mm_min_pd(x, lo);
+    hi = _mm_max_pd(x, hi);
+  }
+  double los[2];
+  double his[2];
+  _mm_storeu_pd(los, lo);
+  _mm_storeu_pd(his, hi);
+  los[0] = los[1] < los[0] ? los[1] : los[0];
+  his[0] = his[0] < his[1] ? his[1] : his[0];
+  for (; i < n; ++i) {
+    los[0] = p[i] < los[0] ? p[i] : los[0];
+    his[0] = his[0] < p[i] ? p[i] : his[0];
+  }
+  return std::pair<double, double>(los[0], his[0]);
+}
+
+inline std::pair<std::int32_t, std::int32_t>
+minmax_kernel(const std::int32_t* p, std::size_t n)
+{
+  __m128i lo = _mm_set1_epi32(p[0]);
+  __m128i hi = lo;
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+    // SSE2 has no 32-bit min/max, so select with the comparison masks.
+    const __m128i lt = _mm_cmplt_epi32(x, lo);
+    lo = _mm_or_si128(_mm_and_si128(lt, x), _mm_andnot_si128(lt, lo));
+    const __m128i gt = _mm_cmpgt_epi32(x, hi);
+    hi = _mm_or_si128(_mm_and_si128(gt, x), _mm_andnot_si128(gt, hi));
+  }
+  std::int32_t los[4];
+  std::int32_t his[4];
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(los), lo);
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(his), hi);
+  for (std::size_t k = 1; k < 4; ++k) {
+    los[0] = los[k] < los[0] ? los[k] : los[0];
+    his[0] = his[0] < his[k] ? his[k] : his[0];
+  }
+  for (; i < n; ++i) {
+    los[0] = p[i] < los[0] ? p[i] : los[0];
+    his[0] = his[0] < p[i] ? p[i] : his[0];
+  }
+  return std::pair<std::int32_t, std::int32_t>(los[0], his[0]);
+}
+
+inline __m128i simd_cmpeq(__m128i x, __m128i y, integral_constant<int, 1>)
+{
+  return _mm_cmpeq_epi8(x, y);
+}
+
+inline __m128i simd_cmpeq(__m128i x, __m128i y, integral_constant<int, 2>)
+{
+  return _mm_cmpeq_epi16(x, y);
+}
+
+inline __m128i simd_cmpeq(__m128i x, __m128i y, integral_constant<int, 4>)
+{
+  return _mm_cmpeq_epi32(x, y);
+}
+
+template <typename T>
+__m128i simd_splat(T value)
+{
+  __m128i result;
+  T lanes[16 / sizeof(T)];
+  for (auto& lane : lanes) {
+    lane = value;
+  }
+  std::memcpy(&result, lanes, sizeof(result));
+  return result;
+}
+
+// Returns a 16-bit mask with sizeof(T) bits set for every lane equal to
+// `value`.
+template <typename T>
+unsigned simd_match(const T* p, __m128i value)
+{
+  const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+  return unsigned(_mm_movemask_epi8(
+      simd_cmpeq(x, value, integral_constant<int, int(sizeof(T))> {})));
+}
+
+template <typename T>
+std::size_t count_kernel(const T* p, std::size_t n, T value, std::true_type)
+{
+  const __m128i splat = simd_splat(value);
+  const std::size_t lanes = 16 / sizeof(T);
+  std::size_t bits = 0;
+  std::size_t i = 0;
+  for (; i + lanes <= n; i += lanes) {
+    bits += std::size_t(popcount(simd_match(p + i, splat)));
+  }
+  return bits / sizeof(T) + count_kernel(p + i, n - i, value);
+}
+
+template <typename T>
+std::size_t find_kernel(const T* p, std::size_t n, T value, std::true_type)
+{
+  const __m128i splat = simd_splat(value);
+  const std::size_t lanes = 16 / sizeof(T);
+  std::size_t i = 0;
+  for (; i + lanes <= n; i += lanes) {
+    const unsigned mask = simd_match(p + i, splat);
+    if (mask != 0) {
+      return i + std::size_t(countr_zero(mask)) / sizeof(T);
+    }
+  }
+  return i + find_kernel(p + i, n - i, value);
+}
+
+inline void
+prefix_sum_kernel(const std::int32_t* in, std::size_t n, std::int32_t* out)
+{
+  __m128i carry = _mm_setzero_si128();
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+    x = _mm_add_epi32(x, _mm_slli_si128(x, 4));
+    x = _mm_add_epi32(x, _mm_slli_si128(x, 8));
+    x = _mm_add_epi32(x, carry);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), x);
+    carry = _mm_shuffle_epi32(x, 0xFF);
+  }
+  auto acc = static_cast<std::uint32_t>(_mm_cvtsi128_si32(carry));
+  for (; i < n; ++i) {
+    acc += static_cast<std::uint32_t>(in[i]);
+    std::memcpy(out + i, &acc, sizeof(acc));
+  }
+}
+
+inline void prefix_sum_kernel(const float* in, std::size_t n, float* out)
+{
+  __m128 carry = _mm_setzero_ps();
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    __m128 x = _mm_loadu_ps(in + i);
+    x = _mm_add_ps(
+        x, _mm_castsi128_ps(_mm_slli_si128(_mm_castps_si128(x), 4)));
+    x = _mm_add_ps(
+        x, _mm_castsi128_ps(_mm_slli_si128(_mm_castps_si128(x), 8)));
+    x = _mm_add_ps(x, carry);
+    _mm_storeu_ps(out + i, x);
+    carry = _mm_shuffle_ps(x, x, 0xFF);
+  }
+  float acc = _mm_cvtss_f32(carry);
+  for (; i < n; ++i) {
+    acc += in[i];
+    out[i] = acc;
+  }
+}
+#endif
+
+template <typename T, typename U>
+std::size_t
+count_kernel(const T* p, std::size_t n, const U& value, std::false_type)
+{
+  return count_kernel(p, n, value);
+}
+
+template <typename T, typename U>
+std::size_t
+find_kernel(const T* p, std::size_t n, const U& value, std::false_type)
+{
+  return find_kernel(p, n, value);
+}
+
+template <typename T>
+struct is_simd_comparable
+    : bool_constant<
+#ifdef GUL_HAS_SSE2
+          std::is_integral<T>::value
+          && (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4)
+#else
+          false
+#endif
+          > {
+};
+
+}
+
+GUL_NAMESPACE_END
@@ -0,0 +1,151 @@
+//
+// Copyright (c) 2022 Ramirisu (labyrinth dot ramirisu at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#pragma once
+
+#include <gul/config.hpp>
+
+#include <gul/detail/bit.hpp>
+
+#include <cstddef>
+#include <cstdint>
+
+GUL_NAMESPACE_BEGIN
+
+namespace detail {
+
+constexpr char ascii_to_lower(char c) noexcept
+{
+  return c >= 'A' && c <= 'Z' ? char(c | 0x20) : c;
+}
+
+inline std::uint64_t ascii_to_lower8(std::uint64_t x) noexcept
+{
+  const std::uint64_t ones = 0x0101010101010101;
+  const std::uint64_t heptets = x & (0x7F * ones);
+  const std::uint64_t above_z = heptets + (0x7F - 'Z') * ones;
+  const std::uint64_t from_a = heptets + (0x80 - 'A') * ones;
+  const std::uint64_t upper = ~x & (from_a ^ above_z) & (0x80 * ones);
+  return x | (upper >> 2);
+}
+
+#ifdef GUL_HAS_SSE2
+inline __m128i ascii_load16(const char* p) noexcept
+{
+  return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+}
+
+inline __m128i ascii_to_lower16(__m128i x) noexcept
+{
+  // Moves 'A'..'Z' to the bottom of the signed range so a single signed
+  // comparison selects them.
+  const __m128i shifted = _mm_add_epi8(x, _mm_set1_epi8(0x80 - 'A'));
+  const __m128i upper
+      = _mm_cmplt_epi8(shifted, _mm_set1_epi8(-0x80 + ('Z' - 'A' + 1)));
+  return _mm_or_si128(x, _mm_and_si128(upper, _mm_set1_epi8(0x20)));
+}
+#endif
+
+inline std::size_t
+ascii_imismatch(const char* lhs, const char* rhs, std::size_t size) noexcept
+{
+  std::size_t i = 0;
+#ifdef GUL_HAS_SSE2
+  for (; i + 16 <= size; i += 16) {
+    const __m128i x = ascii_to_lower16(ascii_load16(lhs + i));
+    const __m128i y = ascii_to_lower16(ascii_load16(rhs + i));
+    const auto equal = unsigned(_mm_movemask_epi8(_mm_cmpeq_epi8(x, y)));
+    if (equal != 0xFFFF) {
+      return i + std::size_t(countr_zero(~equal & 0xFFFF));
+    }
+  }
+#endif
+  for (; i + 8 <= size; i += 8) {
+    const std::uint64_t diff = ascii_to_lower8(load_u64_le(lhs + i))
+        ^ ascii_to_lower8(load_u64_le(rhs + i));
+    if (diff != 0) {
+      return i + std::size_t(countr_zero(diff) / 8);
+    }
+  }
+  for (; i < size; ++i) {
+    if (ascii_to_lower(lhs[i]) != ascii_to_lower(rhs[i])) {
+      break;
+    }
+  }
+  return i;
+}
+
+inline std::size_t ascii_ifind(const char* str,
+                               std::size_t size,
+                               const char* needle,
+                               std::size_t needle_size,
+                               std::size_t index) noexcept
+{
+  const auto npos = std::size_t(-1);
+  if (needle_size > size || index > size - needle_size) {
+    return npos;
+  }
+  if (needle_size == 0) {
+    return index;
+  }
+
+  const std::size_t last_index = size - needle_size;
+  const std::size_t tail = needle_size - 1;
+  const char first_char = ascii_to_lower(needle[0]);
+  const char last_char = ascii_to_lower(needle[tail]);
+  std::size_t i = index;
+#ifdef GUL_HAS_SSE2
+  // Candidates must match both the first and the last character of the
+  // needle, which filters out most positions before the full comparison.
+  const __m128i first_block = _mm_set1_epi8(first_char);
+  const __m128i last_block = _mm_set1_epi8(last_char);
+  for (; i + 16 <= last_index + 1; i += 16) {
+    const __m128i first_eq = _mm_cmpeq_epi8(
+        ascii_to_lower16(ascii_load16(str + i)), first_block);
+    const __m128i last_eq = _mm_cmpeq_epi8(
+        ascii_to_lower16(ascii_load16(str + i + tail)), last_block);
+    auto candidates
+        = unsigned(_mm_movemask_epi8(_mm_and_si128(first_eq, last_eq)));
+    while (candidates != 0) {
+      const std::size_t pos = i + std::size_t(countr_zero(candidates));
+      if (ascii_imismatch(str + pos, needle, needle_size) == needle_size) {
+        return pos;
+      }
+      candidates &= candidates - 1;
+    }
+  }
+#endif
+  for (; i <= last_index; ++i) {
+    if (ascii_to_lower(str[i]) == first_char
+        && ascii_to_lower(str[i + tail]) == last_char
+        && ascii_imismatch(str + i, needle, needle_size) == needle_size) {
+      return i;
+    }
+  }
+  return npos;
+}
+
+struct ascii_icase_hash_reader {
+  std::uint64_t read8(const unsigned char* p) const noexcept
+  {
+    return ascii_to_lower8(load_u64_le(p));
+  }
+
+  std::uint64_t read4(const unsigned char* p) const noexcept
+  {
+    return ascii_to_lower8(load_u32_le(p));
+  }
+
+  std::uint64_t read1(const unsigned char* p) const noexcept
+  {
+    return static_cast<unsigned char>(ascii_to_lower(static_cast<char>(*p)));
+  }
+};
+
+}
+
+GUL_NAMESPACE_END
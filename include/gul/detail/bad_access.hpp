@@ -0,0 +1,61 @@
+//
+// Copyright (c) 2022 Ramirisu (labyrinth dot ramirisu at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#pragma once
+
+#include <gul/config.hpp>
+
+#include <cstdlib>
+#include <exception>
+#include <utility>
+
+#if GUL_BAD_ACCESS == GUL_BAD_ACCESS_TRAP && defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+GUL_NAMESPACE_BEGIN
+
+namespace detail {
+
+// Ends the program for a failed access that is not reported by an exception.
+// A trap is emitted inline, since it is shorter than a call.
+#if GUL_BAD_ACCESS == GUL_BAD_ACCESS_TRAP                                      \
+    && (defined(__GNUC__) || defined(__clang__))
+[[noreturn]] inline void bad_access_fail() noexcept
+{
+  __builtin_trap();
+}
+#elif GUL_BAD_ACCESS == GUL_BAD_ACCESS_TRAP && defined(_MSC_VER)
+[[noreturn]] inline void bad_access_fail() noexcept
+{
+  // FAST_FAIL_FATAL_APP_EXIT
+  __fastfail(7);
+}
+#else
+[[noreturn]] GUL_COLD GUL_NOINLINE inline void bad_access_fail() noexcept
+{
+#if GUL_BAD_ACCESS == GUL_BAD_ACCESS_TERMINATE
+  std::terminate();
+#else
+  std::abort();
+#endif
+}
+#endif
+
+#if !GUL_NO_EXCEPTIONS
+// Kept out of line, so that callers only carry a call instead of the
+// construction of the exception and its unwinding data.
+template <typename Exception, typename... Args>
+[[noreturn]] GUL_COLD GUL_NOINLINE void throw_bad_access(Args&&... args)
+{
+  throw Exception(std::forward<Args>(args)...);
+}
+#endif
+
+}
+
+GUL_NAMESPACE_END
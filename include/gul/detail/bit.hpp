@@ -0,0 +1,238 @@
+//
+// Copyright (c) 2022 Ramirisu (labyrinth dot ramirisu at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#pragma once
+
+#include <gul/config.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(GUL_CXX_COMPILER_MSVC)
+#include <intrin.h>
+#endif
+
+#if defined(__BYTE_ORDER__) && defined(__ORDER_BIG_ENDIAN__)                   \
+    && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+#define GUL_BIG_ENDIAN 1
+#else
+#define GUL_BIG_ENDIAN 0
+#endif
+
+#if defined(__SIZEOF_INT128__)
+#define GUL_HAS_INT128
+#endif
+
+#if !defined(GUL_NO_SIMD)                                                      \
+    && (defined(__SSE2__) || defined(_M_X64)                                   \
+        || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define GUL_HAS_SSE2
+#include <emmintrin.h>
+#endif
+
+#if defined(GUL_HAS_SSE2) && (defined(__SSSE3__) || defined(__AVX__))
+#define GUL_HAS_SSSE3
+#include <tmmintrin.h>
+#endif
+
+#if !defined(GUL_NO_SIMD) && defined(__AVX2__)
+#define GUL_HAS_AVX2
+#include <immintrin.h>
+#endif
+
+GUL_NAMESPACE_BEGIN
+
+namespace detail {
+
+#ifdef GUL_HAS_INT128
+__extension__ typedef unsigned __int128 uint128_t;
+#endif
+
+struct uint128 {
+  std::uint64_t high;
+  std::uint64_t low;
+};
+
+inline uint128 umul128(std::uint64_t x, std::uint64_t y) noexcept
+{
+#if defined(GUL_HAS_INT128)
+  const auto r = uint128_t(x) * uint128_t(y);
+  return uint128 { std::uint64_t(r >> 64), std::uint64_t(r) };
+#elif defined(GUL_CXX_COMPILER_MSVC) && defined(_M_X64)
+  std::uint64_t high;
+  const std::uint64_t low = _umul128(x, y, &high);
+  return uint128 { high, low };
+#else
+  const std::uint64_t xl = x & 0xFFFFFFFF;
+  const std::uint64_t xh = x >> 32;
+  const std::uint64_t yl = y & 0xFFFFFFFF;
+  const std::uint64_t yh = y >> 32;
+  const std::uint64_t ll = xl * yl;
+  const std::uint64_t lh = xl * yh;
+  const std::uint64_t hl = xh * yl;
+  const std::uint64_t hh = xh * yh;
+  const std::uint64_t mid = (ll >> 32) + (lh & 0xFFFFFFFF) + (hl & 0xFFFFFFFF);
+  return uint128 { hh + (lh >> 32) + (hl >> 32) + (mid >> 32),
+                   (mid << 32) | (ll & 0xFFFFFFFF) };
+#endif
+}
+
+inline std::uint64_t umul128_high(std::uint64_t x, std::uint64_t y) noexcept
+{
+  return umul128(x, y).high;
+}
+
+inline int countl_zero(std::uint64_t x) noexcept
+{
+  if (x == 0) {
+    return 64;
+  }
+#if defined(__GNUC__) || defined(__clang__)
+  return __builtin_clzll(x);
+#elif defined(GUL_CXX_COMPILER_MSVC) && defined(_M_X64)
+  unsigned long index;
+  _BitScanReverse64(&index, x);
+  return 63 - static_cast<int>(index);
+#else
+  int n = 0;
+  for (std::uint64_t mask = std::uint64_t(1) << 63; (x & mask) == 0;
+       mask >>= 1) {
+    ++n;
+  }
+  return n;
+#endif
+}
+
+inline int countr_zero(std::uint64_t x) noexcept
+{
+  if (x == 0) {
+    return 64;
+  }
+#if defined(__GNUC__) || defined(__clang__)
+  return __builtin_ctzll(x);
+#elif defined(GUL_CXX_COMPILER_MSVC) && defined(_M_X64)
+  unsigned long index;
+  _BitScanForward64(&index, x);
+  return static_cast<int>(index);
+#else
+  int n = 0;
+  for (; (x & 1) == 0; x >>= 1) {
+    ++n;
+  }
+  return n;
+#endif
+}
+
+inline int popcount(std::uint64_t x) noexcept
+{
+#if defined(__GNUC__) || defined(__clang__)
+  return __builtin_popcountll(x);
+#else
+  x = x - ((x >> 1) & 0x5555555555555555);
+  x = (x & 0x3333333333333333) + ((x >> 2) & 0x3333333333333333);
+  x = (x + (x >> 4)) & 0x0F0F0F0F0F0F0F0F;
+  return static_cast<int>((x * 0x0101010101010101) >> 56);
+#endif
+}
+
+// Counts the set bits of `n` words. Without a popcnt instruction, the SWAR
+// steps are independent shifts, masks and adds per word, which vectorize.
+// Byte counts are summed over at most 31 words so that no byte overflows.
+inline std::size_t popcount_words(const std::uint64_t* p,
+                                  std::size_t n) noexcept
+{
+  std::size_t count = 0;
+#if defined(__POPCNT__)
+  for (std::size_t i = 0; i < n; ++i) {
+    count += static_cast<std::size_t>(__builtin_popcountll(p[i]));
+  }
+#else
+  while (n != 0) {
+    const std::size_t block = n < 31 ? n : 31;
+    std::uint64_t bytes = 0;
+    for (std::size_t i = 0; i < block; ++i) {
+      std::uint64_t x = p[i];
+      x = x - ((x >> 1) & 0x5555555555555555);
+      x = (x & 0x3333333333333333) + ((x >> 2) & 0x3333333333333333);
+      bytes += (x + (x >> 4)) & 0x0F0F0F0F0F0F0F0F;
+    }
+    bytes = (bytes & 0x00FF00FF00FF00FF) + ((bytes >> 8) & 0x00FF00FF00FF00FF);
+    count += static_cast<std::size_t>((bytes * 0x0001000100010001) >> 48);
+    p += block;
+    n -= block;
+  }
+#endif
+  return count;
+}
+
+inline std::uint16_t byteswap16(std::uint16_t x) noexcept
+{
+#if defined(__GNUC__) || defined(__clang__)
+  return __builtin_bswap16(x);
+#elif defined(GUL_CXX_COMPILER_MSVC)
+  return _byteswap_ushort(x);
+#else
+  return std::uint16_t((x << 8) | (x >> 8));
+#endif
+}
+
+inline std::uint32_t byteswap32(std::uint32_t x) noexcept
+{
+#if defined(__GNUC__) || defined(__clang__)
+  return __builtin_bswap32(x);
+#elif defined(GUL_CXX_COMPILER_MSVC)
+  return _byteswap_ulong(x);
+#else
+  return ((x & 0x000000FF) << 24) | ((x & 0x0000FF00) << 8)
+      | ((x & 0x00FF0000) >> 8) | ((x & 0xFF000000) >> 24);
+#endif
+}
+
+inline std::uint64_t byteswap64(std::uint64_t x) noexcept
+{
+#if defined(__GNUC__) || defined(__clang__)
+  return __builtin_bswap64(x);
+#elif defined(GUL_CXX_COMPILER_MSVC)
+  return _byteswap_uint64(x);
+#else
+  return (std::uint64_t(byteswap32(std::uint32_t(x))) << 32)
+      | byteswap32(std::uint32_t(x >> 32));
+#endif
+}
+
+inline std::uint64_t load_u64_le(const void* p) noexcept
+{
+  std::uint64_t x;
+  std::memcpy(&x, p, sizeof(x));
+#if GUL_BIG_ENDIAN
+  x = byteswap64(x);
+#endif
+  return x;
+}
+
+inline std::uint32_t load_u32_le(const void* p) noexcept
+{
+  std::uint32_t x;
+  std::memcpy(&x, p, sizeof(x));
+#if GUL_BIG_ENDIAN
+  x = byteswap32(x);
+#endif
+  return x;
+}
+
+inline void store_u64_le(void* p, std::uint64_t x) noexcept
+{
+#if GUL_BIG_ENDIAN
+  x = byteswap64(x);
+#endif
+  std::memcpy(p, &x, sizeof(x));
+}
+
+}
+
+GUL_NAMESPACE_END
@@ -0,0 +1,118 @@
+//
+// Copyright (c) 2022 Ramirisu (labyrinth dot ramirisu at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#pragma once
+
+#include <gul/config.hpp>
+
+#include <gul/detail/bit.hpp>
+
+#include <cstddef>
+#include <cstdint>
+
+GUL_NAMESPACE_BEGIN
+
+namespace detail {
+
+struct hash_secret {
+  static constexpr std::uint64_t s0 = 0xa0761d6478bd642f;
+  static constexpr std::uint64_t s1 = 0xe7037ed1a0b428db;
+  static constexpr std::uint64_t s2 = 0x8ebc6af09c88c6e3;
+  static constexpr std::uint64_t s3 = 0x589965cc75374cc3;
+};
+
+inline std::uint64_t hash_mix(std::uint64_t a, std::uint64_t b) noexcept
+{
+  const auto r = umul128(a, b);
+  return r.high ^ r.low;
+}
+
+struct hash_byte_reader {
+  std::uint64_t read8(const unsigned char* p) const noexcept
+  {
+    return load_u64_le(p);
+  }
+
+  std::uint64_t read4(const unsigned char* p) const noexcept
+  {
+    return load_u32_le(p);
+  }
+
+  std::uint64_t read1(const unsigned char* p) const noexcept
+  {
+    return *p;
+  }
+};
+
+// wyhash (final 3): short keys are covered by at most two overlapping
+// loads, long keys are consumed 48 bytes per iteration by three independent
+// multiply lanes.
+template <typename Reader>
+inline std::uint64_t hash_bytes(const void* data,
+                                std::size_t size,
+                                std::uint64_t seed,
+                                Reader reader) noexcept
+{
+  const auto* p = static_cast<const unsigned char*>(data);
+  const std::uint64_t len = size;
+  seed ^= hash_secret::s0;
+
+  std::uint64_t a;
+  std::uint64_t b;
+  if (size <= 16) {
+    if (size >= 4) {
+      const std::size_t offset = (size >> 3) << 2;
+      a = (reader.read4(p) << 32) | reader.read4(p + offset);
+      b = (reader.read4(p + size - 4) << 32)
+          | reader.read4(p + size - 4 - offset);
+    } else if (size > 0) {
+      a = (reader.read1(p) << 16) | (reader.read1(p + (size >> 1)) << 8)
+          | reader.read1(p + size - 1);
+      b = 0;
+    } else {
+      a = 0;
+      b = 0;
+    }
+  } else {
+    if (size > 48) {
+      std::uint64_t seed1 = seed;
+      std::uint64_t seed2 = seed;
+      do {
+        seed = hash_mix(reader.read8(p) ^ hash_secret::s1,
+                        reader.read8(p + 8) ^ seed);
+        seed1 = hash_mix(reader.read8(p + 16) ^ hash_secret::s2,
+                         reader.read8(p + 24) ^ seed1);
+        seed2 = hash_mix(reader.read8(p + 32) ^ hash_secret::s3,
+                         reader.read8(p + 40) ^ seed2);
+        p += 48;
+        size -= 48;
+      } while (size > 48);
+      seed ^= seed1 ^ seed2;
+    }
+    while (size > 16) {
+      seed = hash_mix(reader.read8(p) ^ hash_secret::s1,
+                      reader.read8(p + 8) ^ seed);
+      p += 16;
+      size -= 16;
+    }
+    a = reader.read8(p + size - 16);
+    b = reader.read8(p + size - 8);
+  }
+
+  return hash_mix(hash_secret::s1 ^ len,
+                  hash_mix(a ^ hash_secret::s1, b ^ seed));
+}
+
+inline std::uint64_t
+hash_bytes(const void* data, std::size_t size, std::uint64_t seed) noexcept
+{
+  return hash_bytes(data, size, seed, hash_byte_reader {});
+}
+
+}
+
+GUL_NAMESPACE_END
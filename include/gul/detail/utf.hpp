@@ -0,0 +1,553 @@
+//
+// Copyright (c) 2022 Ramirisu (labyrinth dot ramirisu at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#pragma once
+
+#include <gul/config.hpp>
+
+#include <gul/detail/bit.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <system_error>
+
+#if defined(GUL_HAS_SSE2)
+#if defined(GUL_HAS_SSSE3)
+#define GUL_UTF8_SSSE3
+#define GUL_UTF8_TARGET
+#elif defined(GUL_CXX_COMPILER_MSVC)
+#define GUL_UTF8_SSSE3
+#define GUL_UTF8_SSSE3_DISPATCH
+#define GUL_UTF8_TARGET
+#elif (defined(__clang__) && __clang_major__ >= 4)                             \
+    || (!defined(__clang__) && defined(__GNUC__) && __GNUC__ >= 5)
+#define GUL_UTF8_SSSE3
+#define GUL_UTF8_SSSE3_DISPATCH
+#define GUL_UTF8_TARGET __attribute__((target("ssse3")))
+#endif
+#endif
+
+#ifdef GUL_UTF8_SSSE3
+#include <tmmintrin.h>
+#endif
+
+GUL_NAMESPACE_BEGIN
+
+namespace detail {
+
+inline bool is_ascii16(const unsigned char* p) noexcept
+{
+  return ((load_u64_le(p) | load_u64_le(p + 8)) & 0x8080808080808080) == 0;
+}
+
+// Decodes one code point following Unicode Table 3-7 (well-formed UTF-8 byte
+// sequences). Returns the length of the sequence, or 0 if it is ill-formed.
+inline std::size_t utf8_decode(const unsigned char* p,
+                               std::size_t size,
+                               char32_t& code_point) noexcept
+{
+  const unsigned b0 = p[0];
+  if (b0 < 0x80) {
+    code_point = b0;
+    return 1;
+  }
+  if (b0 < 0xC2) {
+    return 0;
+  }
+  if (b0 < 0xE0) {
+    if (size < 2 || (p[1] & 0xC0) != 0x80) {
+      return 0;
+    }
+    code_point = char32_t(((b0 & 0x1F) << 6) | (p[1] & 0x3F));
+    return 2;
+  }
+  if (b0 < 0xF0) {
+    if (size < 3) {
+      return 0;
+    }
+    const unsigned b1 = p[1];
+    const unsigned lower = b0 == 0xE0 ? 0xA0 : 0x80;
+    const unsigned upper = b0 == 0xED ? 0x9F : 0xBF;
+    if (b1 < lower || b1 > upper || (p[2] & 0xC0) != 0x80) {
+      return 0;
+    }
+    code_point
+        = char32_t(((b0 & 0x0F) << 12) | ((b1 & 0x3F) << 6) | (p[2] & 0x3F));
+    return 3;
+  }
+  if (b0 < 0xF5) {
+    if (size < 4) {
+      return 0;
+    }
+    const unsigned b1 = p[1];
+    const unsigned lower = b0 == 0xF0 ? 0x90 : 0x80;
+    const unsigned upper = b0 == 0xF4 ? 0x8F : 0xBF;
+    if (b1 < lower || b1 > upper || (p[2] & 0xC0) != 0x80
+        || (p[3] & 0xC0) != 0x80) {
+      return 0;
+    }
+    code_point = char32_t(((b0 & 0x07) << 18) | ((b1 & 0x3F) << 12)
+                          | ((p[2] & 0x3F) << 6) | (p[3] & 0x3F));
+    return 4;
+  }
+  return 0;
+}
+
+inline bool utf8_validate_scalar(const unsigned char* p,
+                                 std::size_t size) noexcept
+{
+  std::size_t i = 0;
+  while (i < size) {
+    if (i + 16 <= size && is_ascii16(p + i)) {
+      i += 16;
+      continue;
+    }
+    char32_t code_point;
+    const std::size_t length = utf8_decode(p + i, size - i, code_point);
+    if (length == 0) {
+      return false;
+    }
+    i += length;
+  }
+  return true;
+}
+
+#ifdef GUL_UTF8_SSSE3
+// The lookup algorithm from "Validating UTF-8 In Less Than One Instruction
+// Per Byte" (Keiser and Lemire): three nibble lookups classify every pair of
+// adjacent bytes, and the lengths of multi-byte sequences are checked against
+// the continuation bytes two and three positions later.
+struct utf8_error_bits {
+  static constexpr int too_short = 1 << 0;
+  static constexpr int too_long = 1 << 1;
+  static constexpr int overlong_3 = 1 << 2;
+  static constexpr int too_large = 1 << 3;
+  static constexpr int surrogate = 1 << 4;
+  static constexpr int overlong_2 = 1 << 5;
+  static constexpr int too_large_1000 = 1 << 6;
+  static constexpr int overlong_4 = 1 << 6;
+  static constexpr int two_conts = 1 << 7;
+  static constexpr int carry = too_short | too_long | two_conts;
+};
+
+template <typename... Bytes>
+GUL_UTF8_TARGET inline __m128i utf8_setr(Bytes... bytes) noexcept
+{
+  return _mm_setr_epi8(static_cast<char>(bytes)...);
+}
+
+GUL_UTF8_TARGET inline __m128i utf8_high_nibbles(__m128i x) noexcept
+{
+  return _mm_and_si128(_mm_srli_epi16(x, 4), _mm_set1_epi8(0x0F));
+}
+
+GUL_UTF8_TARGET inline __m128i utf8_check_block(__m128i input,
+                                                __m128i prev_input) noexcept
+{
+  using e = utf8_error_bits;
+  const __m128i byte_1_high_table = utf8_setr(
+      e::too_long, e::too_long, e::too_long, e::too_long, e::too_long,
+      e::too_long, e::too_long, e::too_long, e::two_conts, e::two_conts,
+      e::two_conts, e::two_conts, e::too_short | e::overlong_2, e::too_short,
+      e::too_short | e::overlong_3 | e::surrogate,
+      e::too_short | e::too_large | e::too_large_1000 | e::overlong_4);
+  const __m128i byte_1_low_table = utf8_setr(
+      e::carry | e::overlong_3 | e::overlong_2 | e::overlong_4,
+      e::carry | e::overlong_2, e::carry, e::carry, e::carry | e::too_large,
+      e::carry | e::too_large | e::too_large_1000,
+      e::carry | e::too_large | e::too_large_1000,
+      e::carry | e::too_large | e::too_large_1000,
+      e::carry | e::too_large | e::too_large_1000,
+      e::carry | e::too_large | e::too_large_1000,
+      e::carry | e::too_large | e::too_large_1000,
+      e::carry | e::too_large | e::too_large_1000,
+      e::carry | e::too_large | e::too_large_1000,
+      e::carry | e::too_large | e::too_large_1000 | e::surrogate,
+      e::carry | e::too_large | e::too_large_1000,
+      e::carry | e::too_large | e::too_large_1000);
+  const __m128i byte_2_high_table = utf8_setr(
+      e::too_short, e::too_short, e::too_short, e::too_short, e::too_short,
+      e::too_short, e::too_short, e::too_short,
+      e::too_long | e::overlong_2 | e::two_conts | e::overlong_3
+          | e::too_large_1000 | e::overlong_4,
+      e::too_long | e::overlong_2 | e::two_conts | e::overlong_3
+          | e::too_large,
+      e::too_long | e::overlong_2 | e::two_conts | e::surrogate | e::too_large,
+      e::too_long | e::overlong_2 | e::two_conts | e::surrogate | e::too_large,
+      e::too_short, e::too_short, e::too_short, e::too_short);
+
+  const __m128i prev1 = _mm_alignr_epi8(input, prev_input, 15);
+  const __m128i special_cases = _mm_and_si128(
+      _mm_and_si128(
+          _mm_shuffle_epi8(byte_1_high_table, utf8_high_nibbles(prev1)),
+          _mm_shuffle_epi8(byte_1_low_table,
+                           _mm_and_si128(prev1, _mm_set1_epi8(0x0F)))),
+      _mm_shuffle_epi8(byte_2_high_table, utf8_high_nibbles(input)));
+
+  // Only the third byte after 111_____ and the fourth byte after 1111____
+  // end up with the high bit set.
+  const __m128i prev2 = _mm_alignr_epi8(input, prev_input, 14);
+  const __m128i prev3 = _mm_alignr_epi8(input, prev_input, 13);
+  const __m128i must_be_continuation
+      = _mm_or_si128(_mm_subs_epu8(prev2, _mm_set1_epi8(0xE0 - 0x80)),
+                     _mm_subs_epu8(prev3, _mm_set1_epi8(0xF0 - 0x80)));
+  return _mm_xor_si128(
+      _mm_and_si128(must_be_continuation,
+                    _mm_set1_epi8(static_cast<char>(0x80))),
+      special_cases);
+}
+
+GUL_UTF8_TARGET inline void utf8_check_next(__m128i input,
+                                            __m128i& prev_input,
+                                            __m128i& prev_incomplete,
+                                            __m128i& error) noexcept
+{
+  if (_mm_movemask_epi8(input) == 0) {
+    error = _mm_or_si128(error, prev_incomplete);
+  } else {
+    error = _mm_or_si128(error, utf8_check_block(input, prev_input));
+    // A lead byte in the last three positions whose sequence does not fit
+    // into the block.
+    prev_incomplete = _mm_subs_epu8(
+        input, utf8_setr(0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+                         0xFF, 0xFF, 0xFF, 0xFF, 0xF0 - 1, 0xE0 - 1, 0xC0 - 1));
+  }
+  prev_input = input;
+}
+
+GUL_UTF8_TARGET inline bool utf8_validate_ssse3(const unsigned char* p,
+                                                std::size_t size) noexcept
+{
+  __m128i error = _mm_setzero_si128();
+  __m128i prev_input = _mm_setzero_si128();
+  __m128i prev_incomplete = _mm_setzero_si128();
+
+  std::size_t i = 0;
+  for (; i + 32 <= size; i += 32) {
+    const __m128i first
+        = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+    const __m128i second
+        = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i + 16));
+    if (_mm_movemask_epi8(_mm_or_si128(first, second)) == 0) {
+      error = _mm_or_si128(error, prev_incomplete);
+      prev_input = second;
+      continue;
+    }
+    utf8_check_next(first, prev_input, prev_incomplete, error);
+    utf8_check_next(second, prev_input, prev_incomplete, error);
+  }
+
+  if (i < size) {
+    unsigned char tail[32] = {};
+    std::memcpy(tail, p + i, size - i);
+    utf8_check_next(_mm_loadu_si128(reinterpret_cast<const __m128i*>(tail)),
+                    prev_input, prev_incomplete, error);
+    utf8_check_next(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(tail + 16)),
+        prev_input, prev_incomplete, error);
+  }
+  error = _mm_or_si128(error, prev_incomplete);
+
+  return _mm_movemask_epi8(_mm_cmpeq_epi8(error, _mm_setzero_si128()))
+      == 0xFFFF;
+}
+#endif
+
+#ifdef GUL_UTF8_SSSE3_DISPATCH
+inline bool cpu_has_ssse3() noexcept
+{
+#if defined(GUL_CXX_COMPILER_MSVC)
+  int info[4];
+  __cpuid(info, 1);
+  return (info[2] & (1 << 9)) != 0;
+#else
+  return __builtin_cpu_supports("ssse3") != 0;
+#endif
+}
+#endif
+
+inline bool utf8_validate(const unsigned char* p, std::size_t size) noexcept
+{
+#if defined(GUL_UTF8_SSSE3_DISPATCH)
+  static const bool has_ssse3 = cpu_has_ssse3();
+  return has_ssse3 ? utf8_validate_ssse3(p, size)
+                   : utf8_validate_scalar(p, size);
+#elif defined(GUL_UTF8_SSSE3)
+  return utf8_validate_ssse3(p, size);
+#else
+  return utf8_validate_scalar(p, size);
+#endif
+}
+
+inline bool is_surrogate(char32_t c) noexcept
+{
+  return c >= 0xD800 && c <= 0xDFFF;
+}
+
+inline bool utf16_validate(const char16_t* p, std::size_t size) noexcept
+{
+  for (std::size_t i = 0; i < size; ++i) {
+    if (p[i] >= 0xD800 && p[i] <= 0xDFFF) {
+      if (p[i] > 0xDBFF || i + 1 == size || p[i + 1] < 0xDC00
+          || p[i + 1] > 0xDFFF) {
+        return false;
+      }
+      ++i;
+    }
+  }
+  return true;
+}
+
+inline bool utf32_validate(const char32_t* p, std::size_t size) noexcept
+{
+  for (std::size_t i = 0; i < size; ++i) {
+    if (p[i] > 0x10FFFF || is_surrogate(p[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Decodes one code point from well-formed or ill-formed UTF-16. Returns the
+// number of code units consumed, or 0 on an unpaired surrogate.
+inline std::size_t utf16_decode(const char16_t* p,
+                                std::size_t size,
+                                char32_t& code_point) noexcept
+{
+  const char32_t c = p[0];
+  if (!is_surrogate(c)) {
+    code_point = c;
+    return 1;
+  }
+  if (c > 0xDBFF || size < 2 || p[1] < 0xDC00 || p[1] > 0xDFFF) {
+    return 0;
+  }
+  code_point = 0x10000 + ((c - 0xD800) << 10) + (p[1] - 0xDC00);
+  return 2;
+}
+
+inline std::size_t utf8_length(char32_t c) noexcept
+{
+  return c < 0x80 ? 1 : c < 0x800 ? 2 : c < 0x10000 ? 3 : 4;
+}
+
+template <typename CharT>
+inline void utf8_encode(CharT* out, char32_t c, std::size_t length) noexcept
+{
+  switch (length) {
+  case 1:
+    out[0] = static_cast<CharT>(c);
+    break;
+  case 2:
+    out[0] = static_cast<CharT>(0xC0 | (c >> 6));
+    out[1] = static_cast<CharT>(0x80 | (c & 0x3F));
+    break;
+  case 3:
+    out[0] = static_cast<CharT>(0xE0 | (c >> 12));
+    out[1] = static_cast<CharT>(0x80 | ((c >> 6) & 0x3F));
+    out[2] = static_cast<CharT>(0x80 | (c & 0x3F));
+    break;
+  default:
+    out[0] = static_cast<CharT>(0xF0 | (c >> 18));
+    out[1] = static_cast<CharT>(0x80 | ((c >> 12) & 0x3F));
+    out[2] = static_cast<CharT>(0x80 | ((c >> 6) & 0x3F));
+    out[3] = static_cast<CharT>(0x80 | (c & 0x3F));
+    break;
+  }
+}
+
+inline std::size_t utf16_length(char32_t c) noexcept
+{
+  return c < 0x10000 ? 1 : 2;
+}
+
+inline void utf16_encode(char16_t* out, char32_t c, std::size_t length) noexcept
+{
+  if (length == 1) {
+    out[0] = static_cast<char16_t>(c);
+  } else {
+    c -= 0x10000;
+    out[0] = static_cast<char16_t>(0xD800 + (c >> 10));
+    out[1] = static_cast<char16_t>(0xDC00 + (c & 0x3FF));
+  }
+}
+
+template <typename OutChar>
+inline bool utf8_copy_ascii16(const unsigned char* src,
+                              std::size_t size,
+                              std::size_t& i,
+                              OutChar* dst,
+                              std::size_t capacity,
+                              std::size_t& j) noexcept
+{
+  if (i + 16 > size || j + 16 > capacity || !is_ascii16(src + i)) {
+    return false;
+  }
+  for (std::size_t k = 0; k < 16; ++k) {
+    dst[j + k] = static_cast<OutChar>(src[i + k]);
+  }
+  i += 16;
+  j += 16;
+  return true;
+}
+
+inline std::errc utf8_to_utf16(const unsigned char* src,
+                               std::size_t size,
+                               char16_t* dst,
+                               std::size_t capacity,
+                               std::size_t& written) noexcept
+{
+  std::size_t i = 0;
+  std::size_t j = 0;
+  while (i < size) {
+    if (utf8_copy_ascii16(src, size, i, dst, capacity, j)) {
+      continue;
+    }
+    char32_t c;
+    const std::size_t length = utf8_decode(src + i, size - i, c);
+    if (length == 0) {
+      return std::errc::illegal_byte_sequence;
+    }
+    const std::size_t out_length = utf16_length(c);
+    if (out_length > capacity - j) {
+      return std::errc::value_too_large;
+    }
+    utf16_encode(dst + j, c, out_length);
+    i += length;
+    j += out_length;
+  }
+  written = j;
+  return std::errc();
+}
+
+inline std::errc utf8_to_utf32(const unsigned char* src,
+                               std::size_t size,
+                               char32_t* dst,
+                               std::size_t capacity,
+                               std::size_t& written) noexcept
+{
+  std::size_t i = 0;
+  std::size_t j = 0;
+  while (i < size) {
+    if (utf8_copy_ascii16(src, size, i, dst, capacity, j)) {
+      continue;
+    }
+    char32_t c;
+    const std::size_t length = utf8_decode(src + i, size - i, c);
+    if (length == 0) {
+      return std::errc::illegal_byte_sequence;
+    }
+    if (j == capacity) {
+      return std::errc::value_too_large;
+    }
+    dst[j++] = c;
+    i += length;
+  }
+  written = j;
+  return std::errc();
+}
+
+template <typename CharT>
+inline std::errc utf16_to_utf8(const char16_t* src,
+                               std::size_t size,
+                               CharT* dst,
+                               std::size_t capacity,
+                               std::size_t& written) noexcept
+{
+  std::size_t j = 0;
+  for (std::size_t i = 0; i < size;) {
+    char32_t c;
+    const std::size_t length = utf16_decode(src + i, size - i, c);
+    if (length == 0) {
+      return std::errc::illegal_byte_sequence;
+    }
+    const std::size_t out_length = utf8_length(c);
+    if (out_length > capacity - j) {
+      return std::errc::value_too_large;
+    }
+    utf8_encode(dst + j, c, out_length);
+    i += length;
+    j += out_length;
+  }
+  written = j;
+  return std::errc();
+}
+
+inline std::errc utf16_to_utf32(const char16_t* src,
+                                std::size_t size,
+                                char32_t* dst,
+                                std::size_t capacity,
+                                std::size_t& written) noexcept
+{
+  std::size_t j = 0;
+  for (std::size_t i = 0; i < size; ++j) {
+    char32_t c;
+    const std::size_t length = utf16_decode(src + i, size - i, c);
+    if (length == 0) {
+      return std::errc::illegal_byte_sequence;
+    }
+    if (j == capacity) {
+      return std::errc::value_too_large;
+    }
+    dst[j] = c;
+    i += length;
+  }
+  written = j;
+  return std::errc();
+}
+
+template <typename CharT>
+inline std::errc utf32_to_utf8(const char32_t* src,
+                               std::size_t size,
+                               CharT* dst,
+                               std::size_t capacity,
+                               std::size_t& written) noexcept
+{
+  std::size_t j = 0;
+  for (std::size_t i = 0; i < size; ++i) {
+    const char32_t c = src[i];
+    if (c > 0x10FFFF || is_surrogate(c)) {
+      return std::errc::illegal_byte_sequence;
+    }
+    const std::size_t out_length = utf8_length(c);
+    if (out_length > capacity - j) {
+      return std::errc::value_too_large;
+    }
+    utf8_encode(dst + j, c, out_length);
+    j += out_length;
+  }
+  written = j;
+  return std::errc();
+}
+
+inline std::errc utf32_to_utf16(const char32_t* src,
+                                std::size_t size,
+                                char16_t* dst,
+                                std::size_t capacity,
+                                std::size_t& written) noexcept
+{
+  std::size_t j = 0;
+  for (std::size_t i = 0; i < size; ++i) {
+    const char32_t c = src[i];
+    if (c > 0x10FFFF || is_surrogate(c)) {
+      return std::errc::illegal_byte_sequence;
+    }
+    const std::size_t out_length = utf16_length(c);
+    if (out_length > capacity - j) {
+      return std::errc::value_too_large;
+    }
+    utf16_encode(dst + j, c, out_length);
+    j += out_length;
+  }
+  written = j;
+  return std::errc();
+}
+
+}
+
+GUL_NAMESPACE_END
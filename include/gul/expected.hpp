@@ -9,14 +9,26 @@
 
 #include <gul/config.hpp>
 
+#include <gul/detail/bad_access.hpp>
 #include <gul/detail/constructor_base.hpp>
 
 #include <gul/fwd.hpp>
 
 #include <gul/invoke.hpp>
+#include <gul/niche.hpp>
 #include <gul/type_traits.hpp>
 #include <gul/utility.hpp>
 
+// Coroutine support relies on the result of `get_return_object()` being
+// converted to the return type only after the coroutine body has run, which
+// GCC does but other compilers, e.g. MSVC, do not.
+#if defined(GUL_HAS_CXX20) && defined(__cpp_impl_coroutine)                   \
+    && defined(GUL_CXX_COMPILER_GCC)
+#define GUL_HAS_EXPECTED_COROUTINE
+#include <coroutine>
+#include <new>
+#endif
+
 GUL_NAMESPACE_BEGIN
 
 struct unexpect_t {
@@ -194,13 +206,14 @@ namespace detail {
 
 template <typename E>
 struct expected_throw_base {
-  void throw_bad_expected_access(E err) const
+  template <typename Err>
+  [[noreturn]] static void throw_bad_expected_access(Err&& err)
   {
-#if GUL_NO_EXCEPTIONS
-    GUL_UNUSED(err);
-    std::abort();
+#if GUL_BAD_ACCESS == GUL_BAD_ACCESS_THROW && !GUL_NO_EXCEPTIONS
+    throw_bad_access<bad_expected_access<E>>(std::forward<Err>(err));
 #else
-    throw bad_expected_access<E>(err);
+    GUL_UNUSED(err);
+    bad_access_fail();
 #endif
   }
 };
@@ -210,7 +223,9 @@ template <typename T,
           bool = std::is_reference<T>::value,
           bool = disjunction<std::is_void<T>,
                              std::is_trivially_destructible<T>>::value,
-          bool = std::is_trivially_destructible<E>::value>
+          bool = std::is_trivially_destructible<E>::value,
+          bool = conjunction<std::is_void<T>,
+                             has_expected_error_niche<E>>::value>
 struct expected_destruct_base : expected_throw_base<E> {
   union {
     char nul_;
@@ -240,10 +255,20 @@ struct expected_destruct_base : expected_throw_base<E> {
       , has_(false)
   {
   }
+
+  GUL_CXX14_CONSTEXPR bool has_value() const noexcept
+  {
+    return has_;
+  }
+
+  GUL_CXX14_CONSTEXPR void set_has_value(bool has) noexcept
+  {
+    has_ = has;
+  }
 };
 
 template <typename T, typename E>
-struct expected_destruct_base<T, E, false, true, false>
+struct expected_destruct_base<T, E, false, true, false, false>
     : expected_throw_base<E> {
   union {
     char nul_;
@@ -274,6 +299,16 @@ struct expected_destruct_base<T, E, false, true, false>
   {
   }
 
+  GUL_CXX14_CONSTEXPR bool has_value() const noexcept
+  {
+    return has_;
+  }
+
+  GUL_CXX14_CONSTEXPR void set_has_value(bool has) noexcept
+  {
+    has_ = has;
+  }
+
   ~expected_destruct_base()
   {
     if (!has_) {
@@ -283,7 +318,7 @@ struct expected_destruct_base<T, E, false, true, false>
 };
 
 template <typename T, typename E>
-struct expected_destruct_base<T, E, false, false, true>
+struct expected_destruct_base<T, E, false, false, true, false>
     : expected_throw_base<E> {
   union {
     char nul_;
@@ -314,6 +349,16 @@ struct expected_destruct_base<T, E, false, false, true>
   {
   }
 
+  GUL_CXX14_CONSTEXPR bool has_value() const noexcept
+  {
+    return has_;
+  }
+
+  GUL_CXX14_CONSTEXPR void set_has_value(bool has) noexcept
+  {
+    has_ = has;
+  }
+
   ~expected_destruct_base()
   {
     if (has_) {
@@ -323,7 +368,7 @@ struct expected_destruct_base<T, E, false, false, true>
 };
 
 template <typename T, typename E>
-struct expected_destruct_base<T, E, false, false, false>
+struct expected_destruct_base<T, E, false, false, false, false>
     : expected_throw_base<E> {
   union {
     char nul_;
@@ -354,6 +399,16 @@ struct expected_destruct_base<T, E, false, false, false>
   {
   }
 
+  GUL_CXX14_CONSTEXPR bool has_value() const noexcept
+  {
+    return has_;
+  }
+
+  GUL_CXX14_CONSTEXPR void set_has_value(bool has) noexcept
+  {
+    has_ = has;
+  }
+
   ~expected_destruct_base()
   {
     if (has_) {
@@ -365,7 +420,7 @@ struct expected_destruct_base<T, E, false, false, false>
 };
 
 template <typename T, typename E, bool Unused>
-struct expected_destruct_base<T, E, true, Unused, true>
+struct expected_destruct_base<T, E, true, Unused, true, false>
     : expected_throw_base<E> {
   union {
     remove_reference_t<T>* valptr_;
@@ -393,10 +448,20 @@ struct expected_destruct_base<T, E, true, Unused, true>
       , has_(false)
   {
   }
+
+  GUL_CXX14_CONSTEXPR bool has_value() const noexcept
+  {
+    return has_;
+  }
+
+  GUL_CXX14_CONSTEXPR void set_has_value(bool has) noexcept
+  {
+    has_ = has;
+  }
 };
 
 template <typename T, typename E, bool Unused>
-struct expected_destruct_base<T, E, true, Unused, false>
+struct expected_destruct_base<T, E, true, Unused, false, false>
     : expected_throw_base<E> {
   union {
     remove_reference_t<T>* valptr_;
@@ -425,6 +490,16 @@ struct expected_destruct_base<T, E, true, Unused, false>
   {
   }
 
+  GUL_CXX14_CONSTEXPR bool has_value() const noexcept
+  {
+    return has_;
+  }
+
+  GUL_CXX14_CONSTEXPR void set_has_value(bool has) noexcept
+  {
+    has_ = has;
+  }
+
   ~expected_destruct_base()
   {
     if (!has_) {
@@ -433,6 +508,50 @@ struct expected_destruct_base<T, E, true, Unused, false>
   }
 };
 
+// The error doubles as the discriminator, its reserved value meaning that
+// there is no error.
+template <typename T, typename E, bool TrivialE>
+struct expected_destruct_base<T, E, false, true, TrivialE, true>
+    : expected_throw_base<E> {
+  static_assert(TrivialE,
+                "expected_error_niche requires E to be trivially destructible");
+
+  using niche_type = expected_error_niche<E>;
+
+  E err_;
+
+  GUL_CXX14_CONSTEXPR expected_destruct_base() noexcept
+      : err_(niche_type::success_value())
+  {
+  }
+
+  GUL_CXX14_CONSTEXPR explicit expected_destruct_base(in_place_t) noexcept
+      : err_(niche_type::success_value())
+  {
+  }
+
+  template <typename... Args>
+  GUL_CXX14_CONSTEXPR explicit expected_destruct_base(unexpect_t,
+                                                      Args&&... args)
+      : err_(std::forward<Args>(args)...)
+  {
+    GUL_ASSERT(!has_value());
+  }
+
+  GUL_CXX14_CONSTEXPR bool has_value() const noexcept
+  {
+    return niche_type::is_success(err_);
+  }
+
+  GUL_CXX14_CONSTEXPR void set_has_value(bool has) noexcept
+  {
+    if (has) {
+      ::new (std::addressof(err_)) E(niche_type::success_value());
+    }
+    GUL_ASSERT(has_value() == has);
+  }
+};
+
 template <typename T, typename E, bool = std::is_reference<T>::value>
 struct expected_storage_base : expected_destruct_base<T, E> {
   using expected_destruct_base<T, E>::expected_destruct_base;
@@ -469,14 +588,9 @@ struct expected_storage_base : expected_destruct_base<T, E> {
   }
 #endif
 
-  GUL_CXX14_CONSTEXPR bool has_value() const noexcept
-  {
-    return this->has_;
-  }
-
   GUL_CXX14_CONSTEXPR T& value() &
   {
-    if (!this->has_) {
+    if (!this->has_value()) {
       this->throw_bad_expected_access(get_err());
     }
     return this->val_;
@@ -484,7 +598,7 @@ struct expected_storage_base : expected_destruct_base<T, E> {
 
   GUL_CXX14_CONSTEXPR const T& value() const&
   {
-    if (!this->has_) {
+    if (!this->has_value()) {
       this->throw_bad_expected_access(get_err());
     }
     return this->val_;
@@ -492,7 +606,7 @@ struct expected_storage_base : expected_destruct_base<T, E> {
 
   GUL_CXX14_CONSTEXPR T&& value() &&
   {
-    if (!this->has_) {
+    if (!this->has_value()) {
       this->throw_bad_expected_access(std::move(get_err()));
     }
     return std::move(this->val_);
@@ -501,7 +615,7 @@ struct expected_storage_base : expected_destruct_base<T, E> {
 #if !defined(GUL_CXX_COMPILER_GCC48)
   GUL_CXX14_CONSTEXPR const T&& value() const&&
   {
-    if (!this->has_) {
+    if (!this->has_value()) {
       this->throw_bad_expected_access(std::move(get_err()));
     }
     return std::move(this->val_);
@@ -535,7 +649,7 @@ struct expected_storage_base : expected_destruct_base<T, E> {
   {
     auto& val
         = *(::new (std::addressof(this->val_)) T(std::forward<Args>(args)...));
-    this->has_ = true;
+    this->set_has_value(true);
     return val;
   }
 
@@ -544,7 +658,7 @@ struct expected_storage_base : expected_destruct_base<T, E> {
   {
     auto& err
         = *(::new (std::addressof(this->err_)) E(std::forward<Args>(args)...));
-    this->has_ = false;
+    this->set_has_value(false);
     return err;
   }
 
@@ -571,7 +685,7 @@ struct expected_storage_base : expected_destruct_base<T, E> {
   template <typename Other>
   GUL_CXX14_CONSTEXPR void assign_from(Other&& other)
   {
-    if (this->has_) {
+    if (this->has_value()) {
       if (other.has_value()) {
         this->val_ = std::forward<Other>(other).value();
       } else {
@@ -695,14 +809,9 @@ struct expected_storage_base<T, E, true> : expected_destruct_base<T, E> {
   }
 #endif
 
-  GUL_CXX14_CONSTEXPR bool has_value() const noexcept
-  {
-    return this->has_;
-  }
-
   GUL_CXX14_CONSTEXPR T& value() const&
   {
-    if (!has_value()) {
+    if (!this->has_value()) {
       this->throw_bad_expected_access(get_err());
     }
     return *this->valptr_;
@@ -711,7 +820,7 @@ struct expected_storage_base<T, E, true> : expected_destruct_base<T, E> {
 #if !defined(GUL_CXX_COMPILER_GCC48)
   GUL_CXX14_CONSTEXPR T&& value() const&&
   {
-    if (!has_value()) {
+    if (!this->has_value()) {
       this->throw_bad_expected_access(std::move(get_err()));
     }
     return std::forward<T>(*this->valptr_);
@@ -743,7 +852,7 @@ struct expected_storage_base<T, E, true> : expected_destruct_base<T, E> {
   GUL_CXX14_CONSTEXPR T& construct_val(remove_reference_t<T>& arg)
   {
     this->valptr_ = std::addressof(arg);
-    this->has_ = true;
+    this->set_has_value(true);
     return *this->valptr_;
   }
 
@@ -752,7 +861,7 @@ struct expected_storage_base<T, E, true> : expected_destruct_base<T, E> {
   {
     auto& err
         = *(::new (std::addressof(this->err_)) E(std::forward<Args>(args)...));
-    this->has_ = false;
+    this->set_has_value(false);
     return err;
   }
 
@@ -779,7 +888,7 @@ struct expected_storage_base<T, E, true> : expected_destruct_base<T, E> {
   template <typename Other>
   GUL_CXX14_CONSTEXPR void assign_from(Other&& other)
   {
-    if (this->has_) {
+    if (this->has_value()) {
       if (other.has_value()) {
         this->valptr_ = std::addressof(std::forward<Other>(other).value());
       } else {
@@ -815,28 +924,23 @@ struct expected_storage_base<void, E, false> : expected_destruct_base<void, E> {
 
   GUL_CXX14_CONSTEXPR void operator*() && noexcept { }
 
-  GUL_CXX14_CONSTEXPR bool has_value() const noexcept
-  {
-    return this->has_;
-  }
-
   GUL_CXX14_CONSTEXPR void value() &
   {
-    if (!this->has_) {
+    if (!this->has_value()) {
       this->throw_bad_expected_access(get_err());
     }
   }
 
   GUL_CXX14_CONSTEXPR void value() const&
   {
-    if (!this->has_) {
+    if (!this->has_value()) {
       this->throw_bad_expected_access(get_err());
     }
   }
 
   GUL_CXX14_CONSTEXPR void value() &&
   {
-    if (!this->has_) {
+    if (!this->has_value()) {
       this->throw_bad_expected_access(std::move(get_err()));
     }
   }
@@ -844,7 +948,7 @@ struct expected_storage_base<void, E, false> : expected_destruct_base<void, E> {
 #if !defined(GUL_CXX_COMPILER_GCC48)
   GUL_CXX14_CONSTEXPR void value() const&&
   {
-    if (!this->has_) {
+    if (!this->has_value()) {
       this->throw_bad_expected_access(std::move(get_err()));
     }
   }
@@ -874,7 +978,7 @@ struct expected_storage_base<void, E, false> : expected_destruct_base<void, E> {
 
   GUL_CXX14_CONSTEXPR void construct_val() noexcept
   {
-    this->has_ = true;
+    this->set_has_value(true);
   }
 
   template <typename... Args>
@@ -882,7 +986,7 @@ struct expected_storage_base<void, E, false> : expected_destruct_base<void, E> {
   {
     auto& err
         = *(::new (std::addressof(this->err_)) E(std::forward<Args>(args)...));
-    this->has_ = false;
+    this->set_has_value(false);
     return err;
   }
 
@@ -906,7 +1010,7 @@ struct expected_storage_base<void, E, false> : expected_destruct_base<void, E> {
   template <typename Other>
   GUL_CXX14_CONSTEXPR void assign_from(Other&& other)
   {
-    if (this->has_) {
+    if (this->has_value()) {
       if (other.has_value()) {
       } else {
         destroy_val();
@@ -1120,16 +1224,48 @@ using expected_enable_move_assign_base = detail::move_assign_base<
                                         std::is_move_assignable<T>>>,
                 std::is_move_constructible<E>,
                 std::is_move_assignable<E>>::value>;
+
+// As for `optional`, trivially copyable value and error types take the
+// storage base directly.
+template <typename T>
+struct expected_is_trivial
+    : conjunction<std::is_trivially_destructible<T>,
+                  detail::is_trivially_copy_constructible<T>,
+                  detail::is_trivially_move_constructible<T>,
+                  detail::is_trivially_copy_assignable<T>,
+                  detail::is_trivially_move_assignable<T>> { };
+
+template <typename T,
+          typename E,
+          bool = conjunction<disjunction<std::is_void<T>,
+                                         expected_is_trivial<T>>,
+                             expected_is_trivial<E>>::value>
+struct expected_bases {
+  using storage = expected_storage_base<T, E>;
+  using copy_construct = detail::copy_construct_base<true>;
+  using move_construct = detail::move_construct_base<true>;
+  using copy_assign = detail::copy_assign_base<true>;
+  using move_assign = detail::move_assign_base<true>;
+};
+
+template <typename T, typename E>
+struct expected_bases<T, E, false> {
+  using storage = expected_move_assign_base<T, E>;
+  using copy_construct = expected_enable_copy_construct_base<T, E>;
+  using move_construct = expected_enable_move_construct_base<T, E>;
+  using copy_assign = expected_enable_copy_assign_base<T, E>;
+  using move_assign = expected_enable_move_assign_base<T, E>;
+};
 }
 
 template <typename T, typename E>
-class expected : private detail::expected_move_assign_base<T, E>,
+class expected : private detail::expected_bases<T, E>::storage,
                  private detail::expected_enable_default_construct_base<T>,
-                 private detail::expected_enable_copy_construct_base<T, E>,
-                 private detail::expected_enable_move_construct_base<T, E>,
-                 private detail::expected_enable_copy_assign_base<T, E>,
-                 private detail::expected_enable_move_assign_base<T, E> {
-  using base_type = detail::expected_move_assign_base<T, E>;
+                 private detail::expected_bases<T, E>::copy_construct,
+                 private detail::expected_bases<T, E>::move_construct,
+                 private detail::expected_bases<T, E>::copy_assign,
+                 private detail::expected_bases<T, E>::move_assign {
+  using base_type = typename detail::expected_bases<T, E>::storage;
   using dc_base_type = detail::expected_enable_default_construct_base<T>;
 
   template <typename T2, typename E2>
@@ -1514,7 +1650,6 @@ public:
     } else {
       (*this).destroy_err();
       (*this).construct_val(std::forward<U>(u));
-      (*this).has_ = true;
     }
 
     return *this;
@@ -1529,7 +1664,6 @@ public:
   {
     if (has_value()) {
       (*this).destroy_val();
-      (*this).has_ = false;
       (*this).construct_err(une.error());
     } else {
       (*this).get_err() = une.error();
@@ -1547,7 +1681,6 @@ public:
   {
     if (has_value()) {
       (*this).destroy_val();
-      (*this).has_ = false;
       (*this).construct_err(std::move(une).error());
     } else {
       (*this).get_err() = std::move(une).error();
@@ -1668,7 +1801,6 @@ public:
       (*this).destroy_err();
     }
 
-    (*this).has_ = true;
     return (*this).construct_val(std::forward<Args>(args)...);
   }
 
@@ -1687,7 +1819,6 @@ public:
       (*this).destroy_err();
     }
 
-    (*this).has_ = true;
     return (*this).construct_val(init, std::forward<Args>(args)...);
   }
 
@@ -2000,8 +2131,217 @@ GUL_CXX14_CONSTEXPR bool operator!=(const expected<T1, E1>& lhs,
   return !(lhs == rhs);
 }
 
+namespace detail {
+
+// Converts to any `expected<U, G>` holding the error of the wrapped
+// `expected`, so that the error is moved (or copied for an lvalue) exactly
+// once, directly into the caller's return value.
+template <typename Exp>
+class expected_error_forwarder {
+public:
+  explicit expected_error_forwarder(remove_reference_t<Exp>* exp) noexcept
+      : exp_(exp)
+  {
+  }
+
+  template <typename U, typename G>
+  operator expected<U, G>() &&
+  {
+    return expected<U, G>(unexpect, std::forward<Exp>(*exp_).error());
+  }
+
+private:
+  remove_reference_t<Exp>* exp_;
+};
+
+template <typename Exp>
+expected_error_forwarder<Exp> forward_expected_error(Exp&& exp) noexcept
+{
+  return expected_error_forwarder<Exp>(std::addressof(exp));
+}
+
+#ifdef GUL_HAS_EXPECTED_COROUTINE
+
+template <typename T, typename E>
+struct expected_promise;
+
+// Receives the result of an `expected` coroutine. It is converted to
+// `expected<T, E>` only after the coroutine has run to completion or has
+// been cancelled by a failed `co_await`, see `GUL_HAS_EXPECTED_COROUTINE`.
+template <typename T, typename E>
+class expected_return_object {
+public:
+  explicit expected_return_object(expected_promise<T, E>& promise) noexcept
+      : promise_(&promise)
+  {
+    promise_->result = this;
+  }
+
+  expected_return_object(expected_return_object&& other) noexcept
+      : promise_(other.promise_)
+  {
+    GUL_ASSERT(!other.has_value_);
+    promise_->result = this;
+  }
+
+  expected_return_object(const expected_return_object&) = delete;
+
+  expected_return_object& operator=(const expected_return_object&) = delete;
+
+  ~expected_return_object()
+  {
+    if (has_value_) {
+      value_.~expected<T, E>();
+    }
+  }
+
+  template <typename... Args>
+  void emplace(Args&&... args)
+  {
+    GUL_ASSERT(!has_value_);
+    ::new (static_cast<void*>(std::addressof(value_)))
+        expected<T, E>(std::forward<Args>(args)...);
+    has_value_ = true;
+  }
+
+  operator expected<T, E>() &&
+  {
+    GUL_ASSERT(has_value_);
+    return std::move(value_);
+  }
+
+private:
+  expected_promise<T, E>* promise_;
+  union {
+    expected<T, E> value_;
+  };
+  bool has_value_ = false;
+};
+
+template <typename Exp>
+struct expected_awaiter {
+  remove_reference_t<Exp>* exp;
+
+  bool await_ready() const noexcept
+  {
+    return exp->has_value();
+  }
+
+  // Stores the error and destroys the coroutine frame, which also ends the
+  // lifetime of this awaiter.
+  template <typename Promise>
+  void await_suspend(std::coroutine_handle<Promise> handle)
+  {
+    handle.promise().result->emplace(unexpect,
+                                     std::forward<Exp>(*exp).error());
+    handle.destroy();
+  }
+
+  decltype(*std::declval<Exp>()) await_resume() const noexcept
+  {
+    return *std::forward<Exp>(*exp);
+  }
+};
+
+template <typename T, typename E>
+struct expected_promise_base {
+  expected_return_object<T, E>* result = nullptr;
+
+  expected_return_object<T, E> get_return_object() noexcept
+  {
+    return expected_return_object<T, E>(
+        static_cast<expected_promise<T, E>&>(*this));
+  }
+
+  std::suspend_never initial_suspend() const noexcept
+  {
+    return {};
+  }
+
+  std::suspend_never final_suspend() const noexcept
+  {
+    return {};
+  }
+
+  void unhandled_exception() const
+  {
+    GUL_RETHROW();
+  }
+
+  template <typename Exp,
+            GUL_REQUIRES(is_specialization_of<remove_cvref_t<Exp>,
+                                              expected>::value)>
+  expected_awaiter<Exp> await_transform(Exp&& exp) const noexcept
+  {
+    return { std::addressof(exp) };
+  }
+};
+
+template <typename T, typename E>
+struct expected_promise : expected_promise_base<T, E> {
+  template <typename U>
+  void return_value(U&& value)
+  {
+    this->result->emplace(std::forward<U>(value));
+  }
+};
+
+template <typename E>
+struct expected_promise<void, E> : expected_promise_base<void, E> {
+  void return_void()
+  {
+    this->result->emplace();
+  }
+};
+
+#endif
+
+}
+
+// Evaluates the `expected` expression `...`. On error, returns the error
+// from the enclosing function, whose return type must be an `expected`
+// constructible from it. Otherwise initializes the declaration `var` with
+// the value, e.g. `GUL_TRY_EXPECTED(auto v, parse(s));`. The error and the
+// value of an rvalue expression are moved exactly once and never copied.
+#define GUL_TRY_EXPECTED(var, ...)                                             \
+  GUL_DETAIL_TRY_EXPECTED(GUL_DETAIL_CONCAT(gul_try_, __LINE__), var,          \
+                          __VA_ARGS__)
+
+// As `GUL_TRY_EXPECTED`, for an expression whose value is discarded,
+// including `expected<void, E>`.
+#define GUL_TRY_EXPECTED_VOID(...)                                             \
+  GUL_DETAIL_TRY_EXPECTED_VOID(GUL_DETAIL_CONCAT(gul_try_, __LINE__),          \
+                               __VA_ARGS__)
+
+#define GUL_DETAIL_CONCAT_IMPL(a, b) a##b
+#define GUL_DETAIL_CONCAT(a, b) GUL_DETAIL_CONCAT_IMPL(a, b)
+
+#define GUL_DETAIL_TRY_EXPECTED_VOID(tmp, ...)                                 \
+  auto&& tmp = (__VA_ARGS__);                                                  \
+  if (!tmp.has_value()) {                                                      \
+    return ::gul::detail::forward_expected_error(                              \
+        std::forward<decltype(tmp)>(tmp));                                     \
+  }
+
+#define GUL_DETAIL_TRY_EXPECTED(tmp, var, ...)                                 \
+  GUL_DETAIL_TRY_EXPECTED_VOID(tmp, __VA_ARGS__)                               \
+  var = *std::forward<decltype(tmp)>(tmp)
+
 GUL_NAMESPACE_END
 
+#ifdef GUL_HAS_EXPECTED_COROUTINE
+// Makes a function returning `expected<T, E>` a coroutine when it uses
+// `co_await` or `co_return`. `co_await` on an `expected` yields its value,
+// or returns its error from the coroutine. The frame may be heap allocated,
+// so `GUL_TRY_EXPECTED` remains the choice for hot paths.
+namespace std {
+template <typename T, typename E, typename... Args>
+struct coroutine_traits<gul::expected<T, E>, Args...> {
+  using promise_type = gul::detail::expected_promise<T, E>;
+};
+}
+#endif
+
 #include <gul/optional.hpp>
 
 #include <gul/impl/expected.ipp>
@@ -0,0 +1,334 @@
+//
+// Copyright (c) 2022 Ramirisu (labyrinth dot ramirisu at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#pragma once
+
+#include <gul/config.hpp>
+
+#include <gul/invoke.hpp>
+#include <gul/type_traits.hpp>
+#include <gul/utility.hpp>
+
+#include <cstddef>
+#include <new>
+
+GUL_NAMESPACE_BEGIN
+
+namespace detail {
+
+#if defined(GUL_CXX_COMPILER_GCC48)
+using max_align_t = ::max_align_t;
+#else
+using max_align_t = std::max_align_t;
+#endif
+
+template <typename F>
+bool function_is_null(std::true_type, const F& f) noexcept
+{
+  return f == nullptr;
+}
+
+template <typename F>
+bool function_is_null(std::false_type, const F&) noexcept
+{
+  return false;
+}
+
+// Whether `f` is a null function or member pointer, which leaves an
+// `inplace_function` empty, as it does `std::function`.
+template <typename F>
+bool function_is_null(const F& f) noexcept
+{
+  return function_is_null(
+      disjunction<std::is_pointer<F>, std::is_member_pointer<F>>(), f);
+}
+
+template <typename R, typename F, typename... Args>
+R function_invoke(std::false_type, F& f, Args&&... args)
+{
+  return gul::invoke(f, std::forward<Args>(args)...);
+}
+
+// Discards the result, as `std::function<void(Args...)>` does.
+template <typename R, typename F, typename... Args>
+R function_invoke(std::true_type, F& f, Args&&... args)
+{
+  gul::invoke(f, std::forward<Args>(args)...);
+}
+
+template <typename R, typename F, typename... Args>
+R function_call(F& f, Args&&... args)
+{
+  return function_invoke<R>(std::is_void<R>(), f, std::forward<Args>(args)...);
+}
+
+template <typename R, typename... Args>
+struct inplace_function_vtable {
+  R (*call)(void*, Args&&...);
+  // Move constructs into the first buffer and destroys the second one.
+  void (*relocate)(void*, void*);
+  void (*destroy)(void*);
+};
+
+template <typename F, typename R, typename... Args>
+struct inplace_function_ops {
+  static R call(void* f, Args&&... args)
+  {
+    return function_call<R>(*static_cast<F*>(f), std::forward<Args>(args)...);
+  }
+
+  static void relocate(void* dst, void* src) noexcept
+  {
+    ::new (dst) F(std::move(*static_cast<F*>(src)));
+    static_cast<F*>(src)->~F();
+  }
+
+  static void destroy(void* f) noexcept
+  {
+    static_cast<F*>(f)->~F();
+  }
+
+  static const inplace_function_vtable<R, Args...> vtable;
+};
+
+template <typename F, typename R, typename... Args>
+const inplace_function_vtable<R, Args...>
+    inplace_function_ops<F, R, Args...>::vtable
+    = { &inplace_function_ops::call, &inplace_function_ops::relocate,
+        &inplace_function_ops::destroy };
+
+}
+
+template <typename Signature>
+class function_ref;
+
+// A non-owning reference to a callable, two pointers in size. It does not
+// extend the lifetime of the callable, so it is meant for parameters: a
+// `function_ref` bound to a temporary is dangling after the full-expression.
+// Functions and function pointers are stored by value.
+template <typename R, typename... Args>
+class function_ref<R(Args...)> {
+  union storage {
+    constexpr storage(void* o) noexcept
+        : obj(o)
+    {
+    }
+
+    constexpr storage(void (*f)()) noexcept
+        : fn(f)
+    {
+    }
+
+    void* obj;
+    void (*fn)();
+  };
+
+public:
+  template <typename F,
+            GUL_REQUIRES(
+                conjunction<
+                    negation<std::is_same<remove_cvref_t<F>, function_ref>>,
+                    negation<std::is_function<remove_reference_t<F>>>,
+                    negation<std::is_pointer<remove_reference_t<F>>>,
+                    is_invocable_r<R, F&, Args...>>::value)>
+  function_ref(F&& f) noexcept
+      : storage_(const_cast<void*>(
+          static_cast<const volatile void*>(std::addressof(f))))
+      , call_(&call_object<remove_reference_t<F>>)
+  {
+  }
+
+  template <typename F,
+            GUL_REQUIRES(conjunction<std::is_function<F>,
+                                     is_invocable_r<R, F&, Args...>>::value)>
+  function_ref(F* f) noexcept
+      : storage_(reinterpret_cast<void (*)()>(f))
+      , call_(&call_function<F>)
+  {
+    GUL_ASSERT(f != nullptr);
+  }
+
+  R operator()(Args... args) const
+  {
+    return call_(storage_, std::forward<Args>(args)...);
+  }
+
+private:
+  template <typename F>
+  static R call_object(storage s, Args&&... args)
+  {
+    return detail::function_call<R>(*static_cast<F*>(s.obj),
+                                    std::forward<Args>(args)...);
+  }
+
+  template <typename F>
+  static R call_function(storage s, Args&&... args)
+  {
+    return detail::function_call<R>(*reinterpret_cast<F*>(s.fn),
+                                    std::forward<Args>(args)...);
+  }
+
+  storage storage_;
+  R (*call_)(storage, Args&&...);
+};
+
+template <typename Signature,
+          std::size_t Capacity = 4 * sizeof(void*),
+          std::size_t Alignment = alignof(detail::max_align_t)>
+class inplace_function;
+
+// An owning, move-only callable wrapper that stores the callable in a
+// `Capacity` byte buffer inside the object and never allocates. A callable
+// that does not fit, or whose move constructor may throw, is rejected at
+// compile time. Move-only callables are supported.
+template <typename R,
+          typename... Args,
+          std::size_t Capacity,
+          std::size_t Alignment>
+class inplace_function<R(Args...), Capacity, Alignment> {
+  template <typename F>
+  using ops = detail::inplace_function_ops<F, R, Args...>;
+
+public:
+  static constexpr std::size_t capacity = Capacity;
+
+  static constexpr std::size_t alignment = Alignment;
+
+  inplace_function() noexcept = default;
+
+  inplace_function(std::nullptr_t) noexcept { }
+
+  template <typename F,
+            GUL_REQUIRES(conjunction<
+                         negation<std::is_same<decay_t<F>, inplace_function>>,
+                         negation<std::is_same<decay_t<F>, std::nullptr_t>>,
+                         is_invocable_r<R, decay_t<F>&, Args...>>::value)>
+  inplace_function(F&& f)
+  {
+    using type = decay_t<F>;
+    static_assert(sizeof(type) <= Capacity,
+                  "the callable does not fit into the inplace_function");
+    static_assert(Alignment % alignof(type) == 0,
+                  "the callable is over-aligned for the inplace_function");
+    static_assert(std::is_nothrow_move_constructible<type>::value,
+                  "the callable must be nothrow move constructible");
+    if (detail::function_is_null(f)) {
+      return;
+    }
+    ::new (static_cast<void*>(buffer_)) type(std::forward<F>(f));
+    vtable_ = &ops<type>::vtable;
+  }
+
+  inplace_function(inplace_function&& other) noexcept
+  {
+    take(other);
+  }
+
+  inplace_function(const inplace_function&) = delete;
+
+  ~inplace_function()
+  {
+    reset();
+  }
+
+  inplace_function& operator=(inplace_function&& other) noexcept
+  {
+    if (this != &other) {
+      reset();
+      take(other);
+    }
+    return *this;
+  }
+
+  inplace_function& operator=(const inplace_function&) = delete;
+
+  inplace_function& operator=(std::nullptr_t) noexcept
+  {
+    reset();
+    return *this;
+  }
+
+  template <typename F,
+            GUL_REQUIRES(conjunction<
+                         negation<std::is_same<decay_t<F>, inplace_function>>,
+                         negation<std::is_same<decay_t<F>, std::nullptr_t>>,
+                         is_invocable_r<R, decay_t<F>&, Args...>>::value)>
+  inplace_function& operator=(F&& f)
+  {
+    return *this = inplace_function(std::forward<F>(f));
+  }
+
+  explicit operator bool() const noexcept
+  {
+    return vtable_ != nullptr;
+  }
+
+  R operator()(Args... args) const
+  {
+    GUL_ASSERT(vtable_ != nullptr);
+    return vtable_->call(buffer_, std::forward<Args>(args)...);
+  }
+
+  void swap(inplace_function& other) noexcept
+  {
+    inplace_function temp(std::move(other));
+    other = std::move(*this);
+    *this = std::move(temp);
+  }
+
+  friend void swap(inplace_function& lhs, inplace_function& rhs) noexcept
+  {
+    lhs.swap(rhs);
+  }
+
+  friend bool operator==(const inplace_function& f, std::nullptr_t) noexcept
+  {
+    return !f;
+  }
+
+  friend bool operator!=(const inplace_function& f, std::nullptr_t) noexcept
+  {
+    return static_cast<bool>(f);
+  }
+
+private:
+  void reset() noexcept
+  {
+    if (vtable_ != nullptr) {
+      vtable_->destroy(buffer_);
+      vtable_ = nullptr;
+    }
+  }
+
+  void take(inplace_function& other) noexcept
+  {
+    if (other.vtable_ != nullptr) {
+      other.vtable_->relocate(buffer_, other.buffer_);
+      vtable_ = other.vtable_;
+      other.vtable_ = nullptr;
+    }
+  }
+
+  const detail::inplace_function_vtable<R, Args...>* vtable_ = nullptr;
+  alignas(Alignment) mutable unsigned char buffer_[Capacity];
+};
+
+template <typename R,
+          typename... Args,
+          std::size_t Capacity,
+          std::size_t Alignment>
+constexpr std::size_t
+    inplace_function<R(Args...), Capacity, Alignment>::capacity;
+
+template <typename R,
+          typename... Args,
+          std::size_t Capacity,
+          std::size_t Alignment>
+constexpr std::size_t
+    inplace_function<R(Args...), Capacity, Alignment>::alignment;
+
+GUL_NAMESPACE_END
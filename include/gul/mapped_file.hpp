@@ -0,0 +1,307 @@
+//
+// Copyright (c) 2022 Ramirisu (labyrinth dot ramirisu at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#pragma once
+
+#include <gul/config.hpp>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define GUL_HAS_MAPPED_FILE
+#endif
+
+#ifdef GUL_HAS_MAPPED_FILE
+
+#include <gul/byte.hpp>
+#include <gul/expected.hpp>
+#include <gul/span.hpp>
+#include <gul/string_view.hpp>
+#include <gul/utility.hpp>
+
+#include <cerrno>
+#include <cstddef>
+#include <string>
+#include <system_error>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+GUL_NAMESPACE_BEGIN
+
+enum class mapped_file_mode {
+  read_only,
+  // Writes are carried through to the file.
+  read_write,
+  // Writes are private to the mapping and never reach the file.
+  copy_on_write,
+};
+
+enum class mapped_file_flags : unsigned int {
+  none = 0,
+  // Pre-faults the whole mapping while opening.
+  populate = 1,
+  // Asks the kernel to back the mapping with transparent huge pages.
+  huge_pages = 2,
+};
+
+constexpr mapped_file_flags operator|(mapped_file_flags lhs,
+                                      mapped_file_flags rhs) noexcept
+{
+  return static_cast<mapped_file_flags>(static_cast<unsigned int>(lhs)
+                                        | static_cast<unsigned int>(rhs));
+}
+
+constexpr mapped_file_flags operator&(mapped_file_flags lhs,
+                                      mapped_file_flags rhs) noexcept
+{
+  return static_cast<mapped_file_flags>(static_cast<unsigned int>(lhs)
+                                        & static_cast<unsigned int>(rhs));
+}
+
+enum class mapped_file_advice {
+  normal,
+  sequential,
+  random,
+  willneed,
+  dontneed,
+};
+
+namespace detail {
+
+inline unexpected<std::errc> mapped_file_error() noexcept
+{
+  return unexpected<std::errc>(static_cast<std::errc>(errno));
+}
+
+inline bool has_flag(mapped_file_flags flags, mapped_file_flags flag) noexcept
+{
+  return (flags & flag) != mapped_file_flags::none;
+}
+
+inline int to_madvise(mapped_file_advice advice) noexcept
+{
+  switch (advice) {
+  case mapped_file_advice::sequential:
+    return MADV_SEQUENTIAL;
+  case mapped_file_advice::random:
+    return MADV_RANDOM;
+  case mapped_file_advice::willneed:
+    return MADV_WILLNEED;
+  case mapped_file_advice::dontneed:
+    return MADV_DONTNEED;
+  case mapped_file_advice::normal:
+  default:
+    return MADV_NORMAL;
+  }
+}
+
+}
+
+class mapped_file {
+public:
+  using size_type = std::size_t;
+
+  constexpr mapped_file() noexcept = default;
+
+  mapped_file(const mapped_file&) = delete;
+
+  mapped_file(mapped_file&& other) noexcept
+      : data_(exchange(other.data_, nullptr))
+      , size_(exchange(other.size_, 0))
+      , mode_(other.mode_)
+      , open_(exchange(other.open_, false))
+  {
+  }
+
+  mapped_file& operator=(const mapped_file&) = delete;
+
+  mapped_file& operator=(mapped_file&& other) noexcept
+  {
+    if (this != &other) {
+      close();
+      data_ = exchange(other.data_, nullptr);
+      size_ = exchange(other.size_, 0);
+      mode_ = other.mode_;
+      open_ = exchange(other.open_, false);
+    }
+    return *this;
+  }
+
+  ~mapped_file()
+  {
+    close();
+  }
+
+  // Maps the whole file at `path`. An empty file yields an empty mapping.
+  static auto open(const char* path,
+                   mapped_file_mode mode = mapped_file_mode::read_only,
+                   mapped_file_flags flags = mapped_file_flags::none) noexcept
+      -> expected<mapped_file, std::errc>
+  {
+    const int fd = ::open(
+        path, (mode == mapped_file_mode::read_write ? O_RDWR : O_RDONLY)
+            | O_CLOEXEC);
+    if (fd < 0) {
+      return detail::mapped_file_error();
+    }
+    auto result = map(fd, mode, flags);
+    ::close(fd);
+    return result;
+  }
+
+  static auto open(const std::string& path,
+                   mapped_file_mode mode = mapped_file_mode::read_only,
+                   mapped_file_flags flags = mapped_file_flags::none) noexcept
+      -> expected<mapped_file, std::errc>
+  {
+    return open(path.c_str(), mode, flags);
+  }
+
+  // True for an empty file too, which has no mapping.
+  bool is_open() const noexcept
+  {
+    return open_;
+  }
+
+  const byte* data() const noexcept
+  {
+    return static_cast<const byte*>(data_);
+  }
+
+  size_type size() const noexcept
+  {
+    return size_;
+  }
+
+  bool empty() const noexcept
+  {
+    return size_ == 0;
+  }
+
+  mapped_file_mode mode() const noexcept
+  {
+    return mode_;
+  }
+
+  span<const byte> bytes() const noexcept
+  {
+    return span<const byte>(data(), size());
+  }
+
+  span<byte> writable_bytes() noexcept
+  {
+    GUL_ASSERT(mode_ != mapped_file_mode::read_only);
+    return span<byte>(static_cast<byte*>(data_), size());
+  }
+
+  string_view view() const noexcept
+  {
+    return string_view(static_cast<const char*>(data_), size());
+  }
+
+  // Applies `advice` to the pages covering [offset, offset + count).
+  auto advise(mapped_file_advice advice,
+              size_type offset = 0,
+              size_type count = size_type(-1)) const noexcept
+      -> expected<void, std::errc>
+  {
+    GUL_ASSERT(offset <= size_);
+    if (count > size_ - offset) {
+      count = size_ - offset;
+    }
+    if (count == 0) {
+      return {};
+    }
+    // madvise() requires a page-aligned address.
+    const auto page = static_cast<size_type>(::sysconf(_SC_PAGESIZE));
+    const size_type aligned = offset - offset % page;
+    if (::madvise(static_cast<char*>(data_) + aligned,
+                  count + offset - aligned, detail::to_madvise(advice))
+        != 0) {
+      return detail::mapped_file_error();
+    }
+    return {};
+  }
+
+  // Writes modified pages of a read_write mapping back to the file.
+  auto flush(bool wait = true) noexcept -> expected<void, std::errc>
+  {
+    if (size_ != 0 && ::msync(data_, size_, wait ? MS_SYNC : MS_ASYNC) != 0) {
+      return detail::mapped_file_error();
+    }
+    return {};
+  }
+
+  void close() noexcept
+  {
+    if (data_ != nullptr) {
+      ::munmap(data_, size_);
+      data_ = nullptr;
+      size_ = 0;
+    }
+    open_ = false;
+  }
+
+private:
+  static auto map(int fd, mapped_file_mode mode, mapped_file_flags flags)
+      -> expected<mapped_file, std::errc>
+  {
+    struct stat info;
+    if (::fstat(fd, &info) != 0) {
+      return detail::mapped_file_error();
+    }
+    if (info.st_size == 0) {
+      return mapped_file(nullptr, 0, mode);
+    }
+
+    const auto size = static_cast<size_type>(info.st_size);
+    const int protection = mode == mapped_file_mode::read_only
+        ? PROT_READ
+        : PROT_READ | PROT_WRITE;
+    int map_flags
+        = mode == mapped_file_mode::read_write ? MAP_SHARED : MAP_PRIVATE;
+#ifdef MAP_POPULATE
+    if (detail::has_flag(flags, mapped_file_flags::populate)) {
+      map_flags |= MAP_POPULATE;
+    }
+#endif
+    void* data = ::mmap(nullptr, size, protection, map_flags, fd, 0);
+    if (data == MAP_FAILED) {
+      return detail::mapped_file_error();
+    }
+#ifndef MAP_POPULATE
+    if (detail::has_flag(flags, mapped_file_flags::populate)) {
+      ::madvise(data, size, MADV_WILLNEED);
+    }
+#endif
+#ifdef MADV_HUGEPAGE
+    // Best effort, kernels without file-backed THP support reject it.
+    if (detail::has_flag(flags, mapped_file_flags::huge_pages)) {
+      ::madvise(data, size, MADV_HUGEPAGE);
+    }
+#endif
+    return mapped_file(data, size, mode);
+  }
+
+  mapped_file(void* data, size_type size, mapped_file_mode mode) noexcept
+      : data_(data)
+      , size_(size)
+      , mode_(mode)
+      , open_(true)
+  {
+  }
+
+  void* data_ = nullptr;
+  size_type size_ = 0;
+  mapped_file_mode mode_ = mapped_file_mode::read_only;
+  bool open_ = false;
+};
+
+GUL_NAMESPACE_END
+
+#endif
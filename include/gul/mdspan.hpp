@@ -0,0 +1,1164 @@
+//
+// Copyright (c) 2022 Ramirisu (labyrinth dot ramirisu at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#pragma once
+
+#include <gul/config.hpp>
+
+#include <gul/span.hpp>
+#include <gul/type_traits.hpp>
+#include <gul/utility.hpp>
+
+#include <array>
+#include <cstddef>
+#include <utility>
+
+GUL_NAMESPACE_BEGIN
+
+namespace detail {
+
+template <std::size_t... Extents>
+struct static_extents_list;
+
+template <>
+struct static_extents_list<> {
+  static constexpr std::size_t rank_dynamic = 0;
+
+  static constexpr std::size_t get(std::size_t) noexcept
+  {
+    return 0;
+  }
+
+  static constexpr std::size_t dynamic_index(std::size_t) noexcept
+  {
+    return 0;
+  }
+
+  static constexpr std::size_t rank_index(std::size_t, std::size_t) noexcept
+  {
+    return 0;
+  }
+};
+
+template <std::size_t Extent, std::size_t... Extents>
+struct static_extents_list<Extent, Extents...> {
+  using next = static_extents_list<Extents...>;
+
+  static constexpr std::size_t rank_dynamic
+      = (Extent == dynamic_extent ? 1 : 0) + next::rank_dynamic;
+
+  static constexpr std::size_t get(std::size_t r) noexcept
+  {
+    return r == 0 ? Extent : next::get(r - 1);
+  }
+
+  // Number of dynamic extents before rank index r.
+  static constexpr std::size_t dynamic_index(std::size_t r) noexcept
+  {
+    return r == 0 ? 0
+                  : (Extent == dynamic_extent ? 1 : 0)
+            + next::dynamic_index(r - 1);
+  }
+
+  // Rank index of the d-th dynamic extent.
+  static constexpr std::size_t rank_index(std::size_t d,
+                                          std::size_t offset = 0) noexcept
+  {
+    return Extent == dynamic_extent
+        ? (d == 0 ? offset : next::rank_index(d - 1, offset + 1))
+        : next::rank_index(d, offset + 1);
+  }
+};
+
+template <typename IndexType, std::size_t N>
+struct index_array {
+  constexpr index_array() noexcept
+      : values {}
+  {
+  }
+
+  template <typename... Values>
+  constexpr index_array(in_place_t, Values... vs) noexcept
+      : values { static_cast<IndexType>(vs)... }
+  {
+  }
+
+  constexpr IndexType get(std::size_t i) const noexcept
+  {
+    return values[i];
+  }
+
+  IndexType values[N];
+};
+
+template <typename IndexType>
+struct index_array<IndexType, 0> {
+  constexpr index_array() noexcept = default;
+
+  template <typename... Values>
+  constexpr index_array(in_place_t, Values...) noexcept
+  {
+  }
+
+  constexpr IndexType get(std::size_t) const noexcept
+  {
+    return 0;
+  }
+};
+
+struct extents_dynamic_tag { };
+struct extents_all_tag { };
+
+// Whether `extents<I, Extents...>` can be built from
+// `extents<J, OtherExtents...>`, and whether that fixes a dynamic extent to a
+// static one, which only an explicit conversion may do.
+template <typename Lhs, typename Rhs, typename = void>
+struct extents_conversion {
+  static constexpr bool compatible = false;
+  static constexpr bool narrowing = false;
+};
+
+template <std::size_t... Extents, std::size_t... OtherExtents>
+struct extents_conversion<
+    index_sequence<Extents...>,
+    index_sequence<OtherExtents...>,
+    enable_if_t<sizeof...(Extents) == sizeof...(OtherExtents), void>> {
+  static constexpr bool compatible
+      = conjunction<bool_constant<Extents == dynamic_extent
+                                  || OtherExtents == dynamic_extent
+                                  || Extents == OtherExtents>...>::value;
+  static constexpr bool narrowing
+      = disjunction<bool_constant<Extents != dynamic_extent
+                                  && OtherExtents == dynamic_extent>...>::value;
+};
+
+}
+
+template <typename IndexType, std::size_t... Extents>
+class extents
+    : private detail::index_array<
+          IndexType,
+          detail::static_extents_list<Extents...>::rank_dynamic> {
+  static_assert(std::is_integral<IndexType>::value,
+                "[extents] IndexType must be an integral type");
+
+  using list_type = detail::static_extents_list<Extents...>;
+  using storage_type = detail::index_array<IndexType, list_type::rank_dynamic>;
+
+  template <typename, std::size_t...>
+  friend class extents;
+
+public:
+  using index_type = IndexType;
+  using size_type = typename std::make_unsigned<IndexType>::type;
+  using rank_type = std::size_t;
+
+  static constexpr rank_type rank() noexcept
+  {
+    return sizeof...(Extents);
+  }
+
+  static constexpr rank_type rank_dynamic() noexcept
+  {
+    return list_type::rank_dynamic;
+  }
+
+  static constexpr std::size_t static_extent(rank_type r) noexcept
+  {
+    return list_type::get(r);
+  }
+
+  constexpr index_type extent(rank_type r) const noexcept
+  {
+    return static_extent(r) == dynamic_extent
+        ? storage_type::get(list_type::dynamic_index(r))
+        : static_cast<index_type>(static_extent(r));
+  }
+
+  constexpr extents() noexcept = default;
+
+  template <typename... Sizes,
+            GUL_REQUIRES(sizeof...(Sizes) != 0
+                         && (sizeof...(Sizes) == rank_dynamic()
+                             || sizeof...(Sizes) == rank())
+                         && conjunction<
+                             std::is_convertible<Sizes, index_type>...>::value)>
+  constexpr explicit extents(Sizes... sizes) noexcept
+      : extents(conditional_t<sizeof...(Sizes) == rank_dynamic(),
+                              detail::extents_dynamic_tag,
+                              detail::extents_all_tag> {},
+                sizes...)
+  {
+  }
+
+  template <typename OtherIndexType,
+            std::size_t N,
+            GUL_REQUIRES((N == rank_dynamic() || N == rank())
+                         && std::is_convertible<const OtherIndexType&,
+                                                index_type>::value)>
+  GUL_CXX14_CONSTEXPR GUL_CXX20_EXPLICIT(N != rank_dynamic())
+      extents(const std::array<OtherIndexType, N>& sizes) noexcept
+      : extents(sizes, make_index_sequence<N> {})
+  {
+  }
+
+  template <typename OtherIndexType,
+            std::size_t... OtherExtents,
+            GUL_REQUIRES(detail::extents_conversion<
+                         index_sequence<Extents...>,
+                         index_sequence<OtherExtents...>>::compatible)>
+  GUL_CXX14_CONSTEXPR GUL_CXX20_EXPLICIT(
+      (detail::extents_conversion<index_sequence<Extents...>,
+                                  index_sequence<OtherExtents...>>::narrowing))
+      extents(const extents<OtherIndexType, OtherExtents...>& other) noexcept
+      : extents(other, make_index_sequence<list_type::rank_dynamic> {})
+  {
+    for (rank_type r = 0; r < rank(); ++r) {
+      GUL_ASSERT(static_extent(r) == dynamic_extent
+                 || static_cast<std::size_t>(other.extent(r))
+                     == static_extent(r));
+    }
+  }
+
+  template <typename OtherIndexType, std::size_t... OtherExtents>
+  friend GUL_CXX14_CONSTEXPR bool
+  operator==(const extents& lhs,
+             const extents<OtherIndexType, OtherExtents...>& rhs) noexcept
+  {
+    if (lhs.rank() != rhs.rank()) {
+      return false;
+    }
+    for (rank_type r = 0; r < lhs.rank(); ++r) {
+      if (static_cast<std::size_t>(lhs.extent(r))
+          != static_cast<std::size_t>(rhs.extent(r))) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  template <typename OtherIndexType, std::size_t... OtherExtents>
+  friend GUL_CXX14_CONSTEXPR bool
+  operator!=(const extents& lhs,
+             const extents<OtherIndexType, OtherExtents...>& rhs) noexcept
+  {
+    return !(lhs == rhs);
+  }
+
+private:
+  template <typename... Sizes>
+  constexpr extents(detail::extents_dynamic_tag, Sizes... sizes) noexcept
+      : storage_type(in_place, sizes...)
+  {
+  }
+
+  template <typename... Sizes>
+  constexpr extents(detail::extents_all_tag, Sizes... sizes) noexcept
+      : extents(detail::index_array<index_type, sizeof...(Extents)>(in_place,
+                                                                   sizes...),
+                make_index_sequence<list_type::rank_dynamic> {})
+  {
+  }
+
+  template <std::size_t... Ds>
+  constexpr extents(
+      const detail::index_array<index_type, sizeof...(Extents)>& sizes,
+      index_sequence<Ds...>) noexcept
+      : storage_type(in_place, sizes.get(list_type::rank_index(Ds))...)
+  {
+  }
+
+  template <typename OtherIndexType, std::size_t N, std::size_t... Is>
+  GUL_CXX14_CONSTEXPR extents(const std::array<OtherIndexType, N>& sizes,
+                              index_sequence<Is...>) noexcept
+      : extents(static_cast<index_type>(sizes[Is])...)
+  {
+  }
+
+  template <typename OtherIndexType,
+            std::size_t... OtherExtents,
+            std::size_t... Ds>
+  constexpr extents(const extents<OtherIndexType, OtherExtents...>& other,
+                    index_sequence<Ds...>) noexcept
+      : storage_type(in_place, other.extent(list_type::rank_index(Ds))...)
+  {
+  }
+};
+
+namespace detail {
+
+template <typename IndexType, std::size_t Rank, std::size_t... Extents>
+struct make_dextents
+    : make_dextents<IndexType, Rank - 1, dynamic_extent, Extents...> { };
+
+template <typename IndexType, std::size_t... Extents>
+struct make_dextents<IndexType, 0, Extents...> {
+  using type = extents<IndexType, Extents...>;
+};
+
+template <typename Extents>
+GUL_CXX14_CONSTEXPR typename Extents::index_type
+extents_product(const Extents& e, std::size_t first, std::size_t last) noexcept
+{
+  typename Extents::index_type product = 1;
+  for (std::size_t r = first; r < last; ++r) {
+    product *= e.extent(r);
+  }
+  return product;
+}
+
+}
+
+template <typename IndexType, std::size_t Rank>
+using dextents = typename detail::make_dextents<IndexType, Rank>::type;
+
+struct layout_right {
+  template <typename Extents>
+  class mapping;
+};
+
+struct layout_left {
+  template <typename Extents>
+  class mapping;
+};
+
+struct layout_stride {
+  template <typename Extents>
+  class mapping;
+};
+
+template <typename Extents>
+class layout_right::mapping : private Extents {
+public:
+  using extents_type = Extents;
+  using index_type = typename extents_type::index_type;
+  using size_type = typename extents_type::size_type;
+  using rank_type = typename extents_type::rank_type;
+  using layout_type = layout_right;
+
+  constexpr mapping() noexcept = default;
+
+  constexpr mapping(const extents_type& e) noexcept
+      : extents_type(e)
+  {
+  }
+
+  template <typename OtherExtents,
+            GUL_REQUIRES(std::is_constructible<extents_type,
+                                               OtherExtents>::value)>
+  constexpr GUL_CXX20_EXPLICIT(
+      (!std::is_convertible<OtherExtents, extents_type>::value))
+      mapping(const mapping<OtherExtents>& other) noexcept
+      : extents_type(other.extents())
+  {
+  }
+
+  constexpr const extents_type& extents() const noexcept
+  {
+    return *this;
+  }
+
+  GUL_CXX14_CONSTEXPR index_type required_span_size() const noexcept
+  {
+    return detail::extents_product(extents(), 0, extents_type::rank());
+  }
+
+  template <typename... Indices,
+            GUL_REQUIRES(sizeof...(Indices) == extents_type::rank()
+                         && conjunction<std::is_convertible<Indices,
+                                                            index_type>...>::
+                             value)>
+  constexpr index_type operator()(Indices... indices) const noexcept
+  {
+    return offset<0>(index_type(0), static_cast<index_type>(indices)...);
+  }
+
+  static constexpr bool is_always_unique() noexcept
+  {
+    return true;
+  }
+
+  static constexpr bool is_always_exhaustive() noexcept
+  {
+    return true;
+  }
+
+  static constexpr bool is_always_strided() noexcept
+  {
+    return true;
+  }
+
+  static constexpr bool is_unique() noexcept
+  {
+    return true;
+  }
+
+  static constexpr bool is_exhaustive() noexcept
+  {
+    return true;
+  }
+
+  static constexpr bool is_strided() noexcept
+  {
+    return true;
+  }
+
+  GUL_CXX14_CONSTEXPR index_type stride(rank_type r) const noexcept
+  {
+    GUL_ASSERT(r < extents_type::rank());
+    return detail::extents_product(extents(), r + 1, extents_type::rank());
+  }
+
+  template <typename OtherExtents>
+  friend GUL_CXX14_CONSTEXPR bool
+  operator==(const mapping& lhs, const mapping<OtherExtents>& rhs) noexcept
+  {
+    return lhs.extents() == rhs.extents();
+  }
+
+  template <typename OtherExtents>
+  friend GUL_CXX14_CONSTEXPR bool
+  operator!=(const mapping& lhs, const mapping<OtherExtents>& rhs) noexcept
+  {
+    return !(lhs == rhs);
+  }
+
+private:
+  template <std::size_t R>
+  constexpr index_type offset(index_type result) const noexcept
+  {
+    return result;
+  }
+
+  template <std::size_t R, typename... Indices>
+  constexpr index_type
+  offset(index_type result, index_type index, Indices... indices) const noexcept
+  {
+    return offset<R + 1>(result * extents_type::extent(R) + index, indices...);
+  }
+};
+
+template <typename Extents>
+class layout_left::mapping : private Extents {
+public:
+  using extents_type = Extents;
+  using index_type = typename extents_type::index_type;
+  using size_type = typename extents_type::size_type;
+  using rank_type = typename extents_type::rank_type;
+  using layout_type = layout_left;
+
+  constexpr mapping() noexcept = default;
+
+  constexpr mapping(const extents_type& e) noexcept
+      : extents_type(e)
+  {
+  }
+
+  template <typename OtherExtents,
+            GUL_REQUIRES(std::is_constructible<extents_type,
+                                               OtherExtents>::value)>
+  constexpr GUL_CXX20_EXPLICIT(
+      (!std::is_convertible<OtherExtents, extents_type>::value))
+      mapping(const mapping<OtherExtents>& other) noexcept
+      : extents_type(other.extents())
+  {
+  }
+
+  constexpr const extents_type& extents() const noexcept
+  {
+    return *this;
+  }
+
+  GUL_CXX14_CONSTEXPR index_type required_span_size() const noexcept
+  {
+    return detail::extents_product(extents(), 0, extents_type::rank());
+  }
+
+  template <typename... Indices,
+            GUL_REQUIRES(sizeof...(Indices) == extents_type::rank()
+                         && conjunction<std::is_convertible<Indices,
+                                                            index_type>...>::
+                             value)>
+  constexpr index_type operator()(Indices... indices) const noexcept
+  {
+    return offset<0>(static_cast<index_type>(indices)...);
+  }
+
+  static constexpr bool is_always_unique() noexcept
+  {
+    return true;
+  }
+
+  static constexpr bool is_always_exhaustive() noexcept
+  {
+    return true;
+  }
+
+  static constexpr bool is_always_strided() noexcept
+  {
+    return true;
+  }
+
+  static constexpr bool is_unique() noexcept
+  {
+    return true;
+  }
+
+  static constexpr bool is_exhaustive() noexcept
+  {
+    return true;
+  }
+
+  static constexpr bool is_strided() noexcept
+  {
+    return true;
+  }
+
+  GUL_CXX14_CONSTEXPR index_type stride(rank_type r) const noexcept
+  {
+    GUL_ASSERT(r < extents_type::rank());
+    return detail::extents_product(extents(), 0, r);
+  }
+
+  template <typename OtherExtents>
+  friend GUL_CXX14_CONSTEXPR bool
+  operator==(const mapping& lhs, const mapping<OtherExtents>& rhs) noexcept
+  {
+    return lhs.extents() == rhs.extents();
+  }
+
+  template <typename OtherExtents>
+  friend GUL_CXX14_CONSTEXPR bool
+  operator!=(const mapping& lhs, const mapping<OtherExtents>& rhs) noexcept
+  {
+    return !(lhs == rhs);
+  }
+
+private:
+  template <std::size_t R>
+  constexpr index_type offset() const noexcept
+  {
+    return 0;
+  }
+
+  template <std::size_t R, typename... Indices>
+  constexpr index_type offset(index_type index,
+                              Indices... indices) const noexcept
+  {
+    return index + extents_type::extent(R) * offset<R + 1>(indices...);
+  }
+};
+
+template <typename Extents>
+class layout_stride::mapping {
+public:
+  using extents_type = Extents;
+  using index_type = typename extents_type::index_type;
+  using size_type = typename extents_type::size_type;
+  using rank_type = typename extents_type::rank_type;
+  using layout_type = layout_stride;
+
+  GUL_CXX14_CONSTEXPR mapping() noexcept
+      : mapping(layout_right::mapping<extents_type>())
+  {
+  }
+
+  template <typename OtherIndexType,
+            GUL_REQUIRES(std::is_convertible<const OtherIndexType&,
+                                             index_type>::value)>
+  GUL_CXX14_CONSTEXPR
+  mapping(const extents_type& e,
+          const std::array<OtherIndexType, extents_type::rank()>& s) noexcept
+      : mapping(e, s, make_index_sequence<extents_type::rank()> {})
+  {
+  }
+
+  template <typename StridedMapping,
+            GUL_REQUIRES(std::is_constructible<
+                             extents_type,
+                             typename StridedMapping::extents_type>::value
+                         && StridedMapping::is_always_strided()
+                         && !std::is_same<StridedMapping, mapping>::value)>
+  GUL_CXX14_CONSTEXPR mapping(const StridedMapping& other) noexcept
+      : mapping(other, make_index_sequence<extents_type::rank()> {})
+  {
+  }
+
+  constexpr const extents_type& extents() const noexcept
+  {
+    return extents_;
+  }
+
+  GUL_CXX14_CONSTEXPR std::array<index_type, extents_type::rank()>
+  strides() const noexcept
+  {
+    std::array<index_type, extents_type::rank()> result {};
+    for (rank_type r = 0; r < extents_type::rank(); ++r) {
+      result[r] = strides_.get(r);
+    }
+    return result;
+  }
+
+  GUL_CXX14_CONSTEXPR index_type required_span_size() const noexcept
+  {
+    index_type size = 1;
+    for (rank_type r = 0; r < extents_type::rank(); ++r) {
+      if (extents_.extent(r) == 0) {
+        return 0;
+      }
+      size += (extents_.extent(r) - 1) * strides_.get(r);
+    }
+    return size;
+  }
+
+  template <typename... Indices,
+            GUL_REQUIRES(sizeof...(Indices) == extents_type::rank()
+                         && conjunction<std::is_convertible<Indices,
+                                                            index_type>...>::
+                             value)>
+  constexpr index_type operator()(Indices... indices) const noexcept
+  {
+    return offset<0>(static_cast<index_type>(indices)...);
+  }
+
+  static constexpr bool is_always_unique() noexcept
+  {
+    return true;
+  }
+
+  static constexpr bool is_always_exhaustive() noexcept
+  {
+    return false;
+  }
+
+  static constexpr bool is_always_strided() noexcept
+  {
+    return true;
+  }
+
+  static constexpr bool is_unique() noexcept
+  {
+    return true;
+  }
+
+  GUL_CXX14_CONSTEXPR bool is_exhaustive() const noexcept
+  {
+    return required_span_size()
+        == detail::extents_product(extents_, 0, extents_type::rank());
+  }
+
+  static constexpr bool is_strided() noexcept
+  {
+    return true;
+  }
+
+  constexpr index_type stride(rank_type r) const noexcept
+  {
+    return strides_.get(r);
+  }
+
+  template <typename OtherExtents>
+  friend GUL_CXX14_CONSTEXPR bool
+  operator==(const mapping& lhs, const mapping<OtherExtents>& rhs) noexcept
+  {
+    if (lhs.extents() != rhs.extents()) {
+      return false;
+    }
+    for (rank_type r = 0; r < extents_type::rank(); ++r) {
+      if (lhs.stride(r) != rhs.stride(r)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  template <typename OtherExtents>
+  friend GUL_CXX14_CONSTEXPR bool
+  operator!=(const mapping& lhs, const mapping<OtherExtents>& rhs) noexcept
+  {
+    return !(lhs == rhs);
+  }
+
+private:
+  template <typename OtherIndexType, std::size_t... Is>
+  GUL_CXX14_CONSTEXPR
+  mapping(const extents_type& e,
+          const std::array<OtherIndexType, extents_type::rank()>& s,
+          index_sequence<Is...>) noexcept
+      : extents_(e)
+      , strides_(in_place, s[Is]...)
+  {
+  }
+
+  template <typename StridedMapping, std::size_t... Is>
+  GUL_CXX14_CONSTEXPR mapping(const StridedMapping& other,
+                              index_sequence<Is...>) noexcept
+      : extents_(other.extents())
+      , strides_(in_place, other.stride(Is)...)
+  {
+  }
+
+  template <std::size_t R>
+  constexpr index_type offset() const noexcept
+  {
+    return 0;
+  }
+
+  template <std::size_t R, typename... Indices>
+  constexpr index_type offset(index_type index,
+                              Indices... indices) const noexcept
+  {
+    return index * strides_.get(R) + offset<R + 1>(indices...);
+  }
+
+  extents_type extents_;
+  detail::index_array<index_type, extents_type::rank()> strides_;
+};
+
+namespace detail {
+
+template <std::size_t R, typename Extents>
+constexpr bool mdspan_in_bounds(const Extents&) noexcept
+{
+  return true;
+}
+
+template <std::size_t R, typename Extents, typename... Indices>
+constexpr bool mdspan_in_bounds(const Extents& e,
+                                typename Extents::index_type index,
+                                Indices... indices) noexcept
+{
+  return static_cast<typename Extents::size_type>(index)
+      < static_cast<typename Extents::size_type>(e.extent(R))
+      && mdspan_in_bounds<R + 1>(e, indices...);
+}
+
+}
+
+template <typename T, typename Extents, typename LayoutPolicy = layout_right>
+class mdspan
+    : private LayoutPolicy::template mapping<Extents> {
+public:
+  using extents_type = Extents;
+  using layout_type = LayoutPolicy;
+  using mapping_type = typename layout_type::template mapping<extents_type>;
+  using element_type = T;
+  using value_type = remove_cv_t<T>;
+  using index_type = typename extents_type::index_type;
+  using size_type = typename extents_type::size_type;
+  using rank_type = typename extents_type::rank_type;
+  using data_handle_type = T*;
+  using reference = T&;
+
+  static constexpr rank_type rank() noexcept
+  {
+    return extents_type::rank();
+  }
+
+  static constexpr rank_type rank_dynamic() noexcept
+  {
+    return extents_type::rank_dynamic();
+  }
+
+  static constexpr std::size_t static_extent(rank_type r) noexcept
+  {
+    return extents_type::static_extent(r);
+  }
+
+  constexpr index_type extent(rank_type r) const noexcept
+  {
+    return extents().extent(r);
+  }
+
+  constexpr mdspan() noexcept = default;
+
+  template <typename... Sizes,
+            GUL_REQUIRES((sizeof...(Sizes) == extents_type::rank_dynamic()
+                          || sizeof...(Sizes) == extents_type::rank())
+                         && conjunction<
+                             std::is_convertible<Sizes, index_type>...>::value)>
+  constexpr explicit mdspan(data_handle_type pointer, Sizes... sizes) noexcept
+      : mapping_type(extents_type(sizes...))
+      , pointer_(pointer)
+  {
+  }
+
+  constexpr mdspan(data_handle_type pointer, const extents_type& e) noexcept
+      : mapping_type(e)
+      , pointer_(pointer)
+  {
+  }
+
+  constexpr mdspan(data_handle_type pointer, const mapping_type& m) noexcept
+      : mapping_type(m)
+      , pointer_(pointer)
+  {
+  }
+
+  template <std::size_t N,
+            typename... Sizes,
+            GUL_REQUIRES((sizeof...(Sizes) == extents_type::rank_dynamic()
+                          || sizeof...(Sizes) == extents_type::rank())
+                         && conjunction<
+                             std::is_convertible<Sizes, index_type>...>::value)>
+  GUL_CXX14_CONSTEXPR explicit mdspan(span<element_type, N> s,
+                                      Sizes... sizes) noexcept
+      : mdspan(s.data(), sizes...)
+  {
+    GUL_ASSERT(static_cast<std::size_t>(mapping().required_span_size())
+               <= s.size());
+  }
+
+  template <std::size_t N>
+  GUL_CXX14_CONSTEXPR mdspan(span<element_type, N> s,
+                             const extents_type& e) noexcept
+      : mdspan(s.data(), e)
+  {
+    GUL_ASSERT(static_cast<std::size_t>(mapping().required_span_size())
+               <= s.size());
+  }
+
+  template <typename OtherT,
+            typename OtherExtents,
+            typename OtherLayoutPolicy,
+            GUL_REQUIRES(
+                std::is_convertible<OtherT (*)[], T (*)[]>::value
+                && std::is_constructible<
+                    mapping_type,
+                    const typename OtherLayoutPolicy::template mapping<
+                        OtherExtents>&>::value)>
+  constexpr GUL_CXX20_EXPLICIT(
+      (!std::is_convertible<
+          const typename OtherLayoutPolicy::template mapping<OtherExtents>&,
+          mapping_type>::value))
+      mdspan(
+          const mdspan<OtherT, OtherExtents, OtherLayoutPolicy>& other) noexcept
+      : mapping_type(other.mapping())
+      , pointer_(other.data_handle())
+  {
+  }
+
+  template <typename... Indices,
+            GUL_REQUIRES(sizeof...(Indices) == extents_type::rank()
+                         && conjunction<std::is_convertible<Indices,
+                                                            index_type>...>::
+                             value)>
+  GUL_CXX14_CONSTEXPR reference operator()(Indices... indices) const
+  {
+    GUL_ASSERT(detail::mdspan_in_bounds<0>(
+        extents(), static_cast<index_type>(indices)...));
+    return pointer_[mapping()(static_cast<index_type>(indices)...)];
+  }
+
+  template <typename OtherIndexType,
+            GUL_REQUIRES(std::is_convertible<const OtherIndexType&,
+                                             index_type>::value)>
+  GUL_CXX14_CONSTEXPR reference operator()(
+      const std::array<OtherIndexType, extents_type::rank()>& indices) const
+  {
+    return access(indices, make_index_sequence<extents_type::rank()> {});
+  }
+
+  GUL_CXX14_CONSTEXPR size_type size() const noexcept
+  {
+    return static_cast<size_type>(
+        detail::extents_product(extents(), 0, rank()));
+  }
+
+  GUL_CXX14_CONSTEXPR bool empty() const noexcept
+  {
+    return size() == 0;
+  }
+
+  constexpr const data_handle_type& data_handle() const noexcept
+  {
+    return pointer_;
+  }
+
+  constexpr const mapping_type& mapping() const noexcept
+  {
+    return *this;
+  }
+
+  constexpr const extents_type& extents() const noexcept
+  {
+    return mapping().extents();
+  }
+
+  static constexpr bool is_always_unique() noexcept
+  {
+    return mapping_type::is_always_unique();
+  }
+
+  static constexpr bool is_always_exhaustive() noexcept
+  {
+    return mapping_type::is_always_exhaustive();
+  }
+
+  static constexpr bool is_always_strided() noexcept
+  {
+    return mapping_type::is_always_strided();
+  }
+
+  constexpr bool is_unique() const noexcept
+  {
+    return mapping().is_unique();
+  }
+
+  constexpr bool is_exhaustive() const noexcept
+  {
+    return mapping().is_exhaustive();
+  }
+
+  constexpr bool is_strided() const noexcept
+  {
+    return mapping().is_strided();
+  }
+
+  constexpr index_type stride(rank_type r) const noexcept
+  {
+    return mapping().stride(r);
+  }
+
+private:
+  template <typename OtherIndexType, std::size_t... Is>
+  GUL_CXX14_CONSTEXPR reference
+  access(const std::array<OtherIndexType, extents_type::rank()>& indices,
+         index_sequence<Is...>) const
+  {
+    return (*this)(static_cast<index_type>(indices[Is])...);
+  }
+
+  data_handle_type pointer_ = nullptr;
+};
+
+#ifdef GUL_HAS_CXX17
+
+template <typename T,
+          typename... Integrals,
+          GUL_REQUIRES((sizeof...(Integrals) > 0)
+                       && conjunction<std::is_convertible<Integrals,
+                                                          std::size_t>...>::
+                           value)>
+explicit mdspan(T*, Integrals...)
+    -> mdspan<T, dextents<std::size_t, sizeof...(Integrals)>>;
+
+template <typename T, typename IndexType, std::size_t... Extents>
+mdspan(T*, const extents<IndexType, Extents...>&)
+    -> mdspan<T, extents<IndexType, Extents...>>;
+
+template <typename T, typename Mapping>
+mdspan(T*, const Mapping&) -> mdspan<T,
+                                     typename Mapping::extents_type,
+                                     typename Mapping::layout_type>;
+
+#endif
+
+struct full_extent_t {
+  explicit full_extent_t() = default;
+};
+
+GUL_CXX17_INLINE constexpr full_extent_t full_extent {};
+
+namespace detail {
+
+struct slice_index_tag { };
+struct slice_full_tag { };
+struct slice_range_tag { };
+
+template <typename Slice, typename IndexType>
+using slice_tag_t = conditional_t<
+    std::is_same<remove_cvref_t<Slice>, full_extent_t>::value,
+    slice_full_tag,
+    conditional_t<std::is_convertible<Slice, IndexType>::value,
+                  slice_index_tag,
+                  slice_range_tag>>;
+
+template <typename Extents, std::size_t Extent, typename Tag>
+struct submdspan_append;
+
+template <typename IndexType, std::size_t... Extents, std::size_t Extent>
+struct submdspan_append<extents<IndexType, Extents...>,
+                        Extent,
+                        slice_index_tag> {
+  using type = extents<IndexType, Extents...>;
+};
+
+template <typename IndexType, std::size_t... Extents, std::size_t Extent>
+struct submdspan_append<extents<IndexType, Extents...>,
+                        Extent,
+                        slice_full_tag> {
+  using type = extents<IndexType, Extents..., Extent>;
+};
+
+template <typename IndexType, std::size_t... Extents, std::size_t Extent>
+struct submdspan_append<extents<IndexType, Extents...>,
+                        Extent,
+                        slice_range_tag> {
+  using type = extents<IndexType, Extents..., dynamic_extent>;
+};
+
+template <typename Result, typename StaticExtents, typename... Slices>
+struct submdspan_extents_impl;
+
+template <typename Result>
+struct submdspan_extents_impl<Result, index_sequence<>> {
+  using type = Result;
+};
+
+template <typename Result,
+          std::size_t Extent,
+          std::size_t... Extents,
+          typename Slice,
+          typename... Slices>
+struct submdspan_extents_impl<Result,
+                              index_sequence<Extent, Extents...>,
+                              Slice,
+                              Slices...>
+    : submdspan_extents_impl<
+          typename submdspan_append<
+              Result,
+              Extent,
+              slice_tag_t<Slice, typename Result::index_type>>::type,
+          index_sequence<Extents...>,
+          Slices...> { };
+
+template <typename Extents, typename... Slices>
+struct submdspan_extents;
+
+template <typename IndexType, std::size_t... Extents, typename... Slices>
+struct submdspan_extents<extents<IndexType, Extents...>, Slices...>
+    : submdspan_extents_impl<extents<IndexType>,
+                             index_sequence<Extents...>,
+                             Slices...> { };
+
+template <typename IndexType, std::size_t Rank, std::size_t SubRank>
+struct submdspan_state {
+  std::array<IndexType, Rank> firsts;
+  std::array<IndexType, SubRank> extents;
+  std::array<IndexType, SubRank> strides;
+};
+
+template <std::size_t R,
+          std::size_t S,
+          typename Mapping,
+          typename State,
+          typename Slice>
+void submdspan_fill_one(const Mapping& mapping,
+                        State& state,
+                        const Slice& slice,
+                        slice_index_tag)
+{
+  using index_type = typename Mapping::index_type;
+  const auto index = static_cast<index_type>(slice);
+  GUL_ASSERT(index < mapping.extents().extent(R));
+  GUL_UNUSED(mapping);
+  state.firsts[R] = index;
+}
+
+template <std::size_t R,
+          std::size_t S,
+          typename Mapping,
+          typename State,
+          typename Slice>
+void submdspan_fill_one(const Mapping& mapping,
+                        State& state,
+                        const Slice&,
+                        slice_full_tag)
+{
+  state.firsts[R] = 0;
+  state.extents[S] = mapping.extents().extent(R);
+  state.strides[S] = mapping.stride(R);
+}
+
+template <std::size_t R,
+          std::size_t S,
+          typename Mapping,
+          typename State,
+          typename Slice>
+void submdspan_fill_one(const Mapping& mapping,
+                        State& state,
+                        const Slice& slice,
+                        slice_range_tag)
+{
+  static_assert(is_specialization_of<Slice, std::pair>::value,
+                "[submdspan] slice must be an index, full_extent or a pair of "
+                "indices");
+  using index_type = typename Mapping::index_type;
+  const auto first = static_cast<index_type>(slice.first);
+  const auto last = static_cast<index_type>(slice.second);
+  GUL_ASSERT(first <= last && last <= mapping.extents().extent(R));
+  state.firsts[R] = first;
+  state.extents[S] = last - first;
+  state.strides[S] = mapping.stride(R);
+}
+
+template <std::size_t R, std::size_t S, typename Mapping, typename State>
+void submdspan_fill(const Mapping&, State&)
+{
+}
+
+template <std::size_t R,
+          std::size_t S,
+          typename Mapping,
+          typename State,
+          typename Slice,
+          typename... Slices>
+void submdspan_fill(const Mapping& mapping,
+                    State& state,
+                    const Slice& slice,
+                    const Slices&... slices)
+{
+  using tag = slice_tag_t<Slice, typename Mapping::index_type>;
+  submdspan_fill_one<R, S>(mapping, state, slice, tag {});
+  submdspan_fill<R + 1,
+                 S + (std::is_same<tag, slice_index_tag>::value ? 0 : 1)>(
+      mapping, state, slices...);
+}
+
+template <typename Mapping,
+          typename IndexType,
+          std::size_t N,
+          std::size_t... Is>
+typename Mapping::index_type submdspan_offset(
+    const Mapping& mapping,
+    const std::array<IndexType, N>& firsts,
+    index_sequence<Is...>)
+{
+  return mapping(firsts[Is]...);
+}
+
+}
+
+template <typename T,
+          typename Extents,
+          typename LayoutPolicy,
+          typename... Slices>
+auto submdspan(const mdspan<T, Extents, LayoutPolicy>& src, Slices... slices)
+    -> mdspan<T,
+              typename detail::submdspan_extents<Extents, Slices...>::type,
+              layout_stride>
+{
+  static_assert(sizeof...(Slices) == Extents::rank(),
+                "[submdspan] the number of slices must equal the rank");
+  using index_type = typename Extents::index_type;
+  using sub_extents_type =
+      typename detail::submdspan_extents<Extents, Slices...>::type;
+  using sub_mapping_type = layout_stride::mapping<sub_extents_type>;
+
+  detail::submdspan_state<index_type, Extents::rank(),
+                          sub_extents_type::rank()>
+      state {};
+  detail::submdspan_fill<0, 0>(src.mapping(), state, slices...);
+  const auto offset = detail::submdspan_offset(
+      src.mapping(), state.firsts, make_index_sequence<Extents::rank()> {});
+  return mdspan<T, sub_extents_type, layout_stride>(
+      src.data_handle() + offset,
+      sub_mapping_type(sub_extents_type(state.extents), state.strides));
+}
+
+GUL_NAMESPACE_END
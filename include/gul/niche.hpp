@@ -0,0 +1,154 @@
+//
+// Copyright (c) 2022 Ramirisu (labyrinth dot ramirisu at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#pragma once
+
+#include <gul/config.hpp>
+
+#include <gul/type_traits.hpp>
+#include <gul/utility.hpp>
+
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+GUL_NAMESPACE_BEGIN
+
+// Specialize to let `optional<T>` mark "empty" with a reserved value of `T`
+// instead of a separate flag, so that `sizeof(optional<T>) == sizeof(T)`. A
+// specialization provides
+//
+//   static T empty_value();
+//   static bool is_empty(const T& value);
+//
+// `T` must be trivially destructible, and engaging an `optional<T>` with a
+// value for which `is_empty` holds is a precondition violation.
+//
+// Since a specialization applies program-wide, it is best put on a dedicated
+// type rather than on `int` or `double` themselves.
+template <typename T>
+struct optional_niche { };
+
+// Reserves the constant `Value` of an integral or enumeration type, e.g. -1
+// for an index.
+template <typename T, T Value>
+struct optional_niche_value {
+  static constexpr T empty_value() noexcept
+  {
+    return Value;
+  }
+
+  static constexpr bool is_empty(const T& value) noexcept
+  {
+    return value == Value;
+  }
+};
+
+// Reserves `std::numeric_limits<T>::max()`.
+template <typename T>
+struct optional_niche_max
+    : optional_niche_value<T, std::numeric_limits<T>::max()> { };
+
+// Reserves the null value of a pointer or pointer-like type.
+template <typename T>
+struct optional_niche_null {
+  static constexpr T empty_value() noexcept
+  {
+    return T(nullptr);
+  }
+
+  static constexpr bool is_empty(const T& value) noexcept
+  {
+    return value == nullptr;
+  }
+};
+
+// Reserves one quiet NaN bit pattern of `float` or `double`. Other NaNs,
+// such as the result of 0.0 / 0.0, remain ordinary values.
+template <typename T>
+struct optional_niche_nan {
+  static_assert(std::is_floating_point<T>::value
+                    && std::numeric_limits<T>::is_iec559
+                    && (sizeof(T) == 4 || sizeof(T) == 8),
+                "T must be an IEEE 754 float or double");
+
+  using bits_type = conditional_t<sizeof(T) == 4, std::uint32_t, std::uint64_t>;
+
+  static T empty_value() noexcept
+  {
+    const bits_type bits = pattern();
+    T value;
+    std::memcpy(&value, &bits, sizeof(T));
+    return value;
+  }
+
+  static bool is_empty(const T& value) noexcept
+  {
+    bits_type bits;
+    std::memcpy(&bits, &value, sizeof(T));
+    return bits == pattern();
+  }
+
+private:
+  static constexpr bits_type pattern() noexcept
+  {
+    return sizeof(T) == 4 ? bits_type(0x7fc0deadU)
+                          : bits_type(0x7ff800000000deadULL);
+  }
+};
+
+// Specialize to let `expected<void, E>` mean success with a reserved value of
+// `E`, e.g. `std::errc {}` for error codes, instead of a separate flag. A
+// specialization provides
+//
+//   static E success_value();
+//   static bool is_success(const E& error);
+//
+// `E` must be trivially destructible, and constructing an unexpected `E` for
+// which `is_success` holds is a precondition violation. This is independent
+// of `optional_niche<E>`: an `optional<E>` can still hold the success value.
+template <typename E>
+struct expected_error_niche { };
+
+// Reserves the constant `Value` of an integral or enumeration type as
+// success.
+template <typename E, E Value>
+struct expected_error_niche_value {
+  static constexpr E success_value() noexcept
+  {
+    return Value;
+  }
+
+  static constexpr bool is_success(const E& error) noexcept
+  {
+    return error == Value;
+  }
+};
+
+namespace detail {
+
+template <typename T, typename = void>
+struct has_optional_niche : std::false_type { };
+
+template <typename T>
+struct has_optional_niche<
+    T,
+    void_t<decltype(optional_niche<T>::is_empty(std::declval<const T&>()))>>
+    : std::true_type { };
+
+template <typename E, typename = void>
+struct has_expected_error_niche : std::false_type { };
+
+template <typename E>
+struct has_expected_error_niche<
+    E,
+    void_t<decltype(expected_error_niche<E>::is_success(
+        std::declval<const E&>()))>> : std::true_type { };
+
+}
+
+GUL_NAMESPACE_END
@@ -9,10 +9,12 @@
 
 #include <gul/config.hpp>
 
+#include <gul/detail/bad_access.hpp>
 #include <gul/detail/constructor_base.hpp>
 
 #include <gul/fwd.hpp>
 #include <gul/invoke.hpp>
+#include <gul/niche.hpp>
 #include <gul/type_traits.hpp>
 #include <gul/utility.hpp>
 
@@ -48,17 +50,19 @@ public:
 
 namespace detail {
 struct optional_throw_base {
-  void throw_bad_optional_access() const
+  [[noreturn]] static void throw_bad_optional_access()
   {
-#if GUL_NO_EXCEPTIONS
-    std::abort();
+#if GUL_BAD_ACCESS == GUL_BAD_ACCESS_THROW && !GUL_NO_EXCEPTIONS
+    throw_bad_access<bad_optional_access>();
 #else
-    throw bad_optional_access();
+    bad_access_fail();
 #endif
   }
 };
 
-template <typename T, bool = std::is_trivially_destructible<T>::value>
+template <typename T,
+          bool = std::is_trivially_destructible<T>::value,
+          bool = has_optional_niche<T>::value>
 struct optional_destruct_base : optional_throw_base {
   union {
     char nul_;
@@ -89,10 +93,15 @@ struct optional_destruct_base : optional_throw_base {
   {
     has_ = false;
   }
+
+  GUL_CXX14_CONSTEXPR void set_has_value(bool has) noexcept
+  {
+    has_ = has;
+  }
 };
 
 template <typename T>
-struct optional_destruct_base<T, false> : optional_throw_base {
+struct optional_destruct_base<T, false, false> : optional_throw_base {
   union {
     char nul_;
     T val_;
@@ -132,6 +141,53 @@ struct optional_destruct_base<T, false> : optional_throw_base {
       has_ = false;
     }
   }
+
+  GUL_CXX14_CONSTEXPR void set_has_value(bool has) noexcept
+  {
+    has_ = has;
+  }
+};
+
+// Without a flag, the reserved value is kept in `val_` while empty.
+template <typename T, bool B>
+struct optional_destruct_base<T, B, true> : optional_throw_base {
+  static_assert(std::is_trivially_destructible<T>::value,
+                "optional_niche requires T to be trivially destructible");
+
+  using niche_type = optional_niche<T>;
+
+  T val_;
+
+  GUL_CXX14_CONSTEXPR optional_destruct_base() noexcept
+      : val_(niche_type::empty_value())
+  {
+  }
+
+  template <typename... Args>
+  GUL_CXX14_CONSTEXPR explicit optional_destruct_base(in_place_t,
+                                                      Args&&... args)
+      : val_(std::forward<Args>(args)...)
+  {
+    GUL_ASSERT(has_value());
+  }
+
+  GUL_CXX14_CONSTEXPR bool has_value() const noexcept
+  {
+    return !niche_type::is_empty(val_);
+  }
+
+  GUL_CXX14_CONSTEXPR void reset() noexcept
+  {
+    set_has_value(false);
+  }
+
+  GUL_CXX14_CONSTEXPR void set_has_value(bool has) noexcept
+  {
+    if (!has) {
+      ::new (std::addressof(val_)) T(niche_type::empty_value());
+    }
+    GUL_ASSERT(has_value() == has);
+  }
 };
 
 template <typename T, bool = std::is_reference<T>::value>
@@ -140,45 +196,45 @@ struct optional_storage_base : optional_destruct_base<T> {
 
   GUL_CXX14_CONSTEXPR add_pointer_t<T> operator->() noexcept
   {
-    GUL_ASSERT(this->has_);
+    GUL_ASSERT(this->has_value());
     return std::addressof(this->val_);
   }
 
   GUL_CXX14_CONSTEXPR add_pointer_t<const T> operator->() const noexcept
   {
-    GUL_ASSERT(this->has_);
+    GUL_ASSERT(this->has_value());
     return std::addressof(this->val_);
   }
 
   GUL_CXX14_CONSTEXPR T& operator*() & noexcept
   {
-    GUL_ASSERT(this->has_);
+    GUL_ASSERT(this->has_value());
     return this->val_;
   }
 
   GUL_CXX14_CONSTEXPR const T& operator*() const& noexcept
   {
-    GUL_ASSERT(this->has_);
+    GUL_ASSERT(this->has_value());
     return this->val_;
   }
 
   GUL_CXX14_CONSTEXPR T&& operator*() && noexcept
   {
-    GUL_ASSERT(this->has_);
+    GUL_ASSERT(this->has_value());
     return std::move(this->val_);
   }
 
 #if !defined(GUL_CXX_COMPILER_GCC48)
   GUL_CXX14_CONSTEXPR const T&& operator*() const&& noexcept
   {
-    GUL_ASSERT(this->has_);
+    GUL_ASSERT(this->has_value());
     return std::move(this->val_);
   }
 #endif
 
   GUL_CXX14_CONSTEXPR T& value() &
   {
-    if (!this->has_) {
+    if (!this->has_value()) {
       this->throw_bad_optional_access();
     }
     return this->val_;
@@ -186,7 +242,7 @@ struct optional_storage_base : optional_destruct_base<T> {
 
   GUL_CXX14_CONSTEXPR const T& value() const&
   {
-    if (!this->has_) {
+    if (!this->has_value()) {
       this->throw_bad_optional_access();
     }
     return this->val_;
@@ -194,7 +250,7 @@ struct optional_storage_base : optional_destruct_base<T> {
 
   GUL_CXX14_CONSTEXPR T&& value() &&
   {
-    if (!this->has_) {
+    if (!this->has_value()) {
       this->throw_bad_optional_access();
     }
     return std::move(this->val_);
@@ -203,7 +259,7 @@ struct optional_storage_base : optional_destruct_base<T> {
 #if !defined(GUL_CXX_COMPILER_GCC48)
   GUL_CXX14_CONSTEXPR const T&& value() const&&
   {
-    if (!this->has_) {
+    if (!this->has_value()) {
       this->throw_bad_optional_access();
     }
     return std::move(this->val_);
@@ -213,18 +269,18 @@ struct optional_storage_base : optional_destruct_base<T> {
   template <typename... Args>
   GUL_CXX14_CONSTEXPR T& construct(Args&&... args)
   {
-    GUL_ASSERT(!this->has_);
+    GUL_ASSERT(!this->has_value());
     auto& val
         = *(::new (std::addressof(this->val_)) T(std::forward<Args>(args)...));
-    this->has_ = true;
+    this->set_has_value(true);
     return val;
   }
 
   GUL_CXX14_CONSTEXPR void destroy()
   {
-    GUL_ASSERT(this->has_);
+    GUL_ASSERT(this->has_value());
     this->val_.~T();
-    this->has_ = false;
+    this->set_has_value(false);
   }
 
   template <typename Other>
@@ -238,20 +294,20 @@ struct optional_storage_base : optional_destruct_base<T> {
   template <typename U>
   GUL_CXX14_CONSTEXPR T& assign(U&& u)
   {
-    if (this->has_) {
+    if (this->has_value()) {
       this->val_ = std::forward<U>(u);
     } else {
       ::new (std::addressof(this->val_)) T(std::forward<U>(u));
     }
 
-    this->has_ = true;
+    this->set_has_value(true);
     return this->val_;
   }
 
   template <typename Other>
   GUL_CXX14_CONSTEXPR void assign_from(Other&& other)
   {
-    if (this->has_) {
+    if (this->has_value()) {
       if (other.has_value()) {
         this->val_ = std::forward<Other>(other).value();
       } else {
@@ -260,7 +316,6 @@ struct optional_storage_base : optional_destruct_base<T> {
     } else {
       if (other.has_value()) {
         construct(std::forward<Other>(other).value());
-        this->has_ = true;
       }
     }
   }
@@ -276,15 +331,11 @@ struct optional_storage_base : optional_destruct_base<T> {
       } else {
         other.construct(std::move(value()));
         (*this).destroy();
-        (*this).has_ = false;
-        other.has_ = true;
       }
     } else {
       if (other.has_value()) {
         (*this).construct(std::move(other.value()));
         other.destroy();
-        (*this).has_ = true;
-        other.has_ = false;
       }
     }
   }
@@ -631,6 +682,19 @@ struct optional_move_assign_base<T, false> : optional_copy_assign_base<T> {
   }
 };
 
+// Trivially copyable types and void take the storage base directly,
+// skipping the copy and move layers and the deleted-member bases, which are
+// all no-ops for them. This keeps `optional<T>` cheap to instantiate in the
+// common case.
+template <typename T>
+struct optional_is_trivial
+    : disjunction<std::is_void<T>,
+                  conjunction<std::is_trivially_destructible<T>,
+                              detail::is_trivially_copy_constructible<T>,
+                              detail::is_trivially_move_constructible<T>,
+                              detail::is_trivially_copy_assignable<T>,
+                              detail::is_trivially_move_assignable<T>>> { };
+
 template <typename T>
 using optional_enable_copy_construct_base = detail::copy_construct_base<
     disjunction<std::is_void<T>, std::is_copy_constructible<T>>::value>;
@@ -650,15 +714,33 @@ using optional_enable_move_assign_base = detail::move_assign_base<
     disjunction<std::is_void<T>,
                 conjunction<std::is_move_constructible<T>,
                             std::is_move_assignable<T>>>::value>;
+
+template <typename T, bool = optional_is_trivial<T>::value>
+struct optional_bases {
+  using storage = optional_storage_base<T>;
+  using copy_construct = detail::copy_construct_base<true>;
+  using move_construct = detail::move_construct_base<true>;
+  using copy_assign = detail::copy_assign_base<true>;
+  using move_assign = detail::move_assign_base<true>;
+};
+
+template <typename T>
+struct optional_bases<T, false> {
+  using storage = optional_move_assign_base<T>;
+  using copy_construct = optional_enable_copy_construct_base<T>;
+  using move_construct = optional_enable_move_construct_base<T>;
+  using copy_assign = optional_enable_copy_assign_base<T>;
+  using move_assign = optional_enable_move_assign_base<T>;
+};
 }
 
 template <typename T>
-class optional : private detail::optional_move_assign_base<T>,
-                 private detail::optional_enable_copy_construct_base<T>,
-                 private detail::optional_enable_move_construct_base<T>,
-                 private detail::optional_enable_copy_assign_base<T>,
-                 private detail::optional_enable_move_assign_base<T> {
-  using base_type = detail::optional_move_assign_base<T>;
+class optional : private detail::optional_bases<T>::storage,
+                 private detail::optional_bases<T>::copy_construct,
+                 private detail::optional_bases<T>::move_construct,
+                 private detail::optional_bases<T>::copy_assign,
+                 private detail::optional_bases<T>::move_assign {
+  using base_type = typename detail::optional_bases<T>::storage;
 
   template <typename U>
   struct is_optional_constructible
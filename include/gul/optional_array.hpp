@@ -0,0 +1,260 @@
+//
+// Copyright (c) 2022 Ramirisu (labyrinth dot ramirisu at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#pragma once
+
+#include <gul/config.hpp>
+
+#include <gul/detail/algorithm.hpp>
+#include <gul/detail/bit.hpp>
+
+#include <gul/optional.hpp>
+#include <gul/span.hpp>
+#include <gul/type_traits.hpp>
+#include <gul/utility.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+GUL_NAMESPACE_BEGIN
+
+// A nullable column: the values are stored contiguously, null slots
+// included, and validity is kept as a bitmap with bit `i % 64` of word
+// `i / 64` set when element `i` holds a value. On little-endian targets the
+// bitmap has the byte layout of an Arrow validity buffer. Bits past `size()`
+// are always zero.
+template <typename T>
+class optional_array {
+  static_assert(!std::is_same<remove_cv_t<T>, bool>::value,
+                "[optional_array] the values are exposed as a span, which "
+                "std::vector<bool> cannot provide; store unsigned char "
+                "instead");
+
+public:
+  using value_type = T;
+  using size_type = std::size_t;
+  using reference = optional<T&>;
+  using const_reference = optional<const T&>;
+  using word_type = std::uint64_t;
+
+  static constexpr size_type bits_per_word = 64;
+
+  optional_array() = default;
+
+  // Creates `count` null elements.
+  explicit optional_array(size_type count)
+      : values_(count)
+      , validity_(word_count(count))
+  {
+  }
+
+  size_type size() const noexcept
+  {
+    return values_.size();
+  }
+
+  bool empty() const noexcept
+  {
+    return values_.empty();
+  }
+
+  size_type valid_count() const noexcept
+  {
+    return detail::popcount_words(validity_.data(), validity_.size());
+  }
+
+  size_type null_count() const noexcept
+  {
+    return size() - valid_count();
+  }
+
+  bool has_value(size_type index) const noexcept
+  {
+    GUL_ASSERT(index < size());
+    return ((validity_[index / bits_per_word] >> (index % bits_per_word)) & 1)
+        != 0;
+  }
+
+  reference operator[](size_type index) noexcept
+  {
+    if (!has_value(index)) {
+      return nullopt;
+    }
+    return values_[index];
+  }
+
+  const_reference operator[](size_type index) const noexcept
+  {
+    if (!has_value(index)) {
+      return nullopt;
+    }
+    return values_[index];
+  }
+
+  void set(size_type index, const T& value)
+  {
+    GUL_ASSERT(index < size());
+    values_[index] = value;
+    set_valid(index);
+  }
+
+  void set(size_type index, T&& value)
+  {
+    GUL_ASSERT(index < size());
+    values_[index] = std::move(value);
+    set_valid(index);
+  }
+
+  // Marks the element null. Its slot keeps the previous contents.
+  void reset(size_type index) noexcept
+  {
+    GUL_ASSERT(index < size());
+    validity_[index / bits_per_word]
+        &= ~(word_type(1) << (index % bits_per_word));
+  }
+
+  void push_back(const T& value)
+  {
+    values_.push_back(value);
+    grow_validity();
+    set_valid(size() - 1);
+  }
+
+  void push_back(T&& value)
+  {
+    values_.push_back(std::move(value));
+    grow_validity();
+    set_valid(size() - 1);
+  }
+
+  void push_back(nullopt_t)
+  {
+    values_.emplace_back();
+    grow_validity();
+  }
+
+  void push_back(const optional<T>& value)
+  {
+    if (value.has_value()) {
+      push_back(*value);
+    } else {
+      push_back(nullopt);
+    }
+  }
+
+  void reserve(size_type count)
+  {
+    values_.reserve(count);
+    validity_.reserve(word_count(count));
+  }
+
+  void clear() noexcept
+  {
+    values_.clear();
+    validity_.clear();
+  }
+
+  // All slots, including the ones of null elements.
+  span<T> values() noexcept
+  {
+    return span<T>(values_.data(), values_.size());
+  }
+
+  span<const T> values() const noexcept
+  {
+    return span<const T>(values_.data(), values_.size());
+  }
+
+  span<const word_type> validity() const noexcept
+  {
+    return span<const word_type>(validity_.data(), validity_.size());
+  }
+
+private:
+  static size_type word_count(size_type count) noexcept
+  {
+    return (count + bits_per_word - 1) / bits_per_word;
+  }
+
+  void set_valid(size_type index) noexcept
+  {
+    validity_[index / bits_per_word] |= word_type(1)
+        << (index % bits_per_word);
+  }
+
+  void grow_validity()
+  {
+    if (validity_.size() < word_count(size())) {
+      validity_.push_back(0);
+    }
+  }
+
+  std::vector<T> values_;
+  std::vector<word_type> validity_;
+};
+
+template <typename T>
+constexpr std::size_t optional_array<T>::bits_per_word;
+
+// Sums the non-null elements. Runs of fully valid words are summed as
+// contiguous blocks, and words with nulls substitute `T()` for them without
+// branching, so both go through the vectorized kernel.
+template <typename T, typename U>
+U reduce(const optional_array<T>& array, U init)
+{
+  static_assert(std::is_arithmetic<T>::value, "T must be arithmetic");
+  using word_type = typename optional_array<T>::word_type;
+  const std::size_t bits = optional_array<T>::bits_per_word;
+  const T* values = array.values().data();
+  const auto validity = array.validity();
+  std::size_t w = 0;
+  while (w < validity.size()) {
+    if (validity[w] == ~word_type(0)) {
+      std::size_t last = w + 1;
+      while (last < validity.size() && validity[last] == ~word_type(0)) {
+        ++last;
+      }
+      init = detail::sum_kernel(values + w * bits, (last - w) * bits, init);
+      w = last;
+      continue;
+    }
+    if (validity[w] != 0) {
+      const std::size_t count = array.size() - w * bits < bits
+          ? array.size() - w * bits
+          : bits;
+      T masked[64];
+      for (std::size_t i = 0; i < count; ++i) {
+        masked[i] = ((validity[w] >> i) & 1) != 0 ? values[w * bits + i] : T();
+      }
+      init = detail::sum_kernel(masked, count, init);
+    }
+    ++w;
+  }
+  return init;
+}
+
+// Folds the non-null elements in order with `op`, skipping null runs a word
+// at a time.
+template <typename T, typename U, typename BinaryOp>
+U reduce(const optional_array<T>& array, U init, BinaryOp op)
+{
+  const std::size_t bits = optional_array<T>::bits_per_word;
+  const T* values = array.values().data();
+  const auto validity = array.validity();
+  for (std::size_t w = 0; w < validity.size(); ++w) {
+    auto word = validity[w];
+    while (word != 0) {
+      init = op(std::move(init),
+                values[w * bits + std::size_t(detail::countr_zero(word))]);
+      word &= word - 1;
+    }
+  }
+  return init;
+}
+
+GUL_NAMESPACE_END
@@ -0,0 +1,365 @@
+//
+// Copyright (c) 2022 Ramirisu (labyrinth dot ramirisu at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#pragma once
+
+#include <gul/config.hpp>
+
+#include <gul/expected.hpp>
+#include <gul/invoke.hpp>
+#include <gul/optional.hpp>
+#include <gul/type_traits.hpp>
+#include <gul/utility.hpp>
+
+GUL_NAMESPACE_BEGIN
+
+namespace detail {
+
+// The error side of an `optional` is represented by `nullopt`, so that
+// `optional` and `expected` pipelines share one implementation.
+template <typename T>
+nullopt_t pipe_error(const optional<T>&) noexcept
+{
+  return nullopt;
+}
+
+template <typename Exp,
+          GUL_REQUIRES(is_specialization_of<remove_cvref_t<Exp>,
+                                            expected>::value)>
+auto pipe_error(Exp&& exp) -> decltype(std::forward<Exp>(exp).error())
+{
+  return std::forward<Exp>(exp).error();
+}
+
+template <typename F>
+auto pipe_recover(F& f, nullopt_t) -> decltype(gul::invoke(f))
+{
+  return gul::invoke(f);
+}
+
+template <typename F, typename E>
+auto pipe_recover(F& f, E&& err)
+    -> decltype(gul::invoke(f, std::forward<E>(err)))
+{
+  return gul::invoke(f, std::forward<E>(err));
+}
+
+template <typename ValueRef, typename ErrorRef>
+using pipe_result_t
+    = conditional_t<std::is_same<remove_cvref_t<ErrorRef>, nullopt_t>::value,
+                    optional<remove_cvref_t<ValueRef>>,
+                    expected<remove_cvref_t<ValueRef>,
+                             remove_cvref_t<ErrorRef>>>;
+
+template <typename F>
+struct pipe_and_then {
+  F f;
+
+  template <typename V, typename Err>
+  struct types {
+    using result_type = remove_cvref_t<invoke_result_t<F&, V>>;
+    using value_ref = decltype(*std::declval<result_type>());
+    using error_ref = Err;
+    static_assert(std::is_same<remove_cvref_t<decltype(pipe_error(
+                                   std::declval<result_type>()))>,
+                               remove_cvref_t<Err>>::value,
+                  "and_then must not change the error type");
+  };
+
+  template <typename R, typename V, typename KV, typename KE>
+  R on_value(V&& value, KV& kv, KE& ke)
+  {
+    auto&& result = gul::invoke(f, std::forward<V>(value));
+    if (result.has_value()) {
+      return kv(*std::move(result));
+    }
+    return ke(pipe_error(std::move(result)));
+  }
+
+  template <typename R, typename Err, typename KV, typename KE>
+  R on_error(Err&& err, KV&, KE& ke)
+  {
+    return ke(std::forward<Err>(err));
+  }
+};
+
+template <typename F>
+struct pipe_transform {
+  F f;
+
+  template <typename V, typename Err>
+  struct types {
+    using value_ref = invoke_result_t<F&, V>;
+    using error_ref = Err;
+    static_assert(!std::is_void<value_ref>::value,
+                  "transform must return a value");
+  };
+
+  template <typename R, typename V, typename KV, typename KE>
+  R on_value(V&& value, KV& kv, KE&)
+  {
+    return kv(gul::invoke(f, std::forward<V>(value)));
+  }
+
+  template <typename R, typename Err, typename KV, typename KE>
+  R on_error(Err&& err, KV&, KE& ke)
+  {
+    return ke(std::forward<Err>(err));
+  }
+};
+
+template <typename F>
+struct pipe_or_else {
+  F f;
+
+  template <typename V, typename Err>
+  struct types {
+    using result_type
+        = remove_cvref_t<decltype(pipe_recover(std::declval<F&>(),
+                                               std::declval<Err>()))>;
+    using value_ref = V;
+    using error_ref = decltype(pipe_error(std::declval<result_type>()));
+    static_assert(std::is_same<typename result_type::value_type,
+                               remove_cvref_t<V>>::value,
+                  "or_else must not change the value type");
+  };
+
+  template <typename R, typename V, typename KV, typename KE>
+  R on_value(V&& value, KV& kv, KE&)
+  {
+    return kv(std::forward<V>(value));
+  }
+
+  template <typename R, typename Err, typename KV, typename KE>
+  R on_error(Err&& err, KV& kv, KE& ke)
+  {
+    auto&& result = pipe_recover(f, std::forward<Err>(err));
+    if (result.has_value()) {
+      return kv(*std::move(result));
+    }
+    return ke(pipe_error(std::move(result)));
+  }
+};
+
+template <typename F>
+struct pipe_transform_error {
+  F f;
+
+  template <typename V, typename Err>
+  struct types {
+    static_assert(!std::is_same<remove_cvref_t<Err>, nullopt_t>::value,
+                  "transform_error requires an expected");
+    using value_ref = V;
+    using error_ref = invoke_result_t<F&, Err>;
+  };
+
+  template <typename R, typename V, typename KV, typename KE>
+  R on_value(V&& value, KV& kv, KE&)
+  {
+    return kv(std::forward<V>(value));
+  }
+
+  template <typename R, typename Err, typename KV, typename KE>
+  R on_error(Err&& err, KV&, KE& ke)
+  {
+    return ke(gul::invoke(f, std::forward<Err>(err)));
+  }
+};
+
+template <typename T>
+struct is_pipe_stage : std::false_type { };
+
+template <typename F>
+struct is_pipe_stage<pipe_and_then<F>> : std::true_type { };
+
+template <typename F>
+struct is_pipe_stage<pipe_transform<F>> : std::true_type { };
+
+template <typename F>
+struct is_pipe_stage<pipe_or_else<F>> : std::true_type { };
+
+template <typename F>
+struct is_pipe_stage<pipe_transform_error<F>> : std::true_type { };
+
+template <typename R, typename Stage, typename KV, typename KE>
+struct pipe_value_cont {
+  Stage& stage;
+  KV& kv;
+  KE& ke;
+
+  template <typename V>
+  R operator()(V&& value) const
+  {
+    return stage.template on_value<R>(std::forward<V>(value), kv, ke);
+  }
+};
+
+template <typename R, typename Stage, typename KV, typename KE>
+struct pipe_error_cont {
+  Stage& stage;
+  KV& kv;
+  KE& ke;
+
+  template <typename Err>
+  R operator()(Err&& err) const
+  {
+    return stage.template on_error<R>(std::forward<Err>(err), kv, ke);
+  }
+};
+
+template <typename R>
+struct pipe_finish_value {
+  template <typename V>
+  R operator()(V&& value) const
+  {
+    return R(in_place, std::forward<V>(value));
+  }
+};
+
+template <typename R>
+struct pipe_finish_error {
+  R operator()(nullopt_t) const
+  {
+    return R(nullopt);
+  }
+
+  template <typename Err>
+  R operator()(Err&& err) const
+  {
+    return R(unexpect, std::forward<Err>(err));
+  }
+};
+
+template <typename Source>
+struct pipe_source {
+  remove_reference_t<Source>* source;
+
+  using value_ref = decltype(*std::declval<Source>());
+  using error_ref = decltype(pipe_error(std::declval<Source>()));
+
+  template <typename R, typename KV, typename KE>
+  R run(KV& kv, KE& ke) const
+  {
+    if (source->has_value()) {
+      return kv(*std::forward<Source>(*source));
+    }
+    return ke(pipe_error(std::forward<Source>(*source)));
+  }
+};
+
+// Owns the previous node and the stage, so that only the source is referred
+// to.
+template <typename Prev, typename Stage>
+struct pipe_node {
+  Prev prev;
+  Stage stage;
+
+  using types = typename Stage::template types<typename Prev::value_ref,
+                                               typename Prev::error_ref>;
+  using value_ref = typename types::value_ref;
+  using error_ref = typename types::error_ref;
+
+  template <typename R, typename KV, typename KE>
+  R run(KV& kv, KE& ke)
+  {
+    pipe_value_cont<R, Stage, KV, KE> on_value { stage, kv, ke };
+    pipe_error_cont<R, Stage, KV, KE> on_error { stage, kv, ke };
+    return prev.template run<R>(on_value, on_error);
+  }
+};
+
+}
+
+// A lazily evaluated chain of `and_then`, `transform`, `or_else` and
+// `transform_error` over an `optional` or `expected`. Each stage hands its
+// value or error straight to the next one, so only the final result is
+// constructed, holding the decayed value type. A pipeline owns its stages
+// but refers to its source, which has to outlive it. It is run once, either
+// by `run()` or by converting to `result_type`.
+template <typename Node>
+class pipeline {
+public:
+  using result_type = detail::pipe_result_t<typename Node::value_ref,
+                                            typename Node::error_ref>;
+
+  pipeline(Node node)
+      : node_(std::move(node))
+  {
+  }
+
+  pipeline(pipeline&&) = default;
+
+  pipeline& operator=(pipeline&&) = default;
+
+  result_type run() &&
+  {
+    detail::pipe_finish_value<result_type> on_value;
+    detail::pipe_finish_error<result_type> on_error;
+    return node_.template run<result_type>(on_value, on_error);
+  }
+
+  operator result_type() &&
+  {
+    return std::move(*this).run();
+  }
+
+  template <typename Stage,
+            GUL_REQUIRES(detail::is_pipe_stage<decay_t<Stage>>::value)>
+  pipeline<detail::pipe_node<Node, decay_t<Stage>>> operator|(Stage&& stage) &&
+  {
+    return { detail::pipe_node<Node, decay_t<Stage>> {
+        std::move(node_), std::forward<Stage>(stage) } };
+  }
+
+private:
+  Node node_;
+};
+
+template <typename Opt,
+          GUL_REQUIRES(disjunction<
+                       detail::is_specialization_of<remove_cvref_t<Opt>,
+                                                    optional>,
+                       detail::is_specialization_of<remove_cvref_t<Opt>,
+                                                    expected>>::value)>
+pipeline<detail::pipe_source<Opt>> pipe(Opt&& source) noexcept
+{
+  static_assert(!std::is_void<typename remove_cvref_t<Opt>::value_type>::value,
+                "pipe does not support a void value type");
+  return { detail::pipe_source<Opt> { std::addressof(source) } };
+}
+
+// The stages live in their own namespace, as their names are generic, e.g.
+// `gul::transform` is an algorithm.
+namespace pipes {
+
+template <typename F>
+detail::pipe_and_then<decay_t<F>> and_then(F&& f)
+{
+  return { std::forward<F>(f) };
+}
+
+template <typename F>
+detail::pipe_transform<decay_t<F>> transform(F&& f)
+{
+  return { std::forward<F>(f) };
+}
+
+template <typename F>
+detail::pipe_or_else<decay_t<F>> or_else(F&& f)
+{
+  return { std::forward<F>(f) };
+}
+
+template <typename F>
+detail::pipe_transform_error<decay_t<F>> transform_error(F&& f)
+{
+  return { std::forward<F>(f) };
+}
+
+}
+
+GUL_NAMESPACE_END
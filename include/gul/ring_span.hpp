@@ -0,0 +1,408 @@
+//
+// Copyright (c) 2022 Ramirisu (labyrinth dot ramirisu at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#pragma once
+
+#include <gul/config.hpp>
+
+#include <gul/optional.hpp>
+#include <gul/span.hpp>
+#include <gul/type_traits.hpp>
+#include <gul/utility.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+
+GUL_NAMESPACE_BEGIN
+
+// A readable or writable region of a ring, which is contiguous unless it
+// wraps around the end of the storage.
+template <typename T>
+struct ring_segments {
+  span<T> first;
+  span<T> second;
+
+  std::size_t size() const noexcept
+  {
+    return first.size() + second.size();
+  }
+
+  bool empty() const noexcept
+  {
+    return size() == 0;
+  }
+};
+
+namespace detail {
+
+// Positions run over [0, 2 * capacity), so that a full ring and an empty
+// ring can be told apart without sacrificing a slot, and without requiring
+// the capacity to be a power of two.
+inline std::size_t ring_index(std::size_t position,
+                              std::size_t capacity) noexcept
+{
+  return position < capacity ? position : position - capacity;
+}
+
+inline std::size_t ring_advance(std::size_t position,
+                                std::size_t count,
+                                std::size_t capacity) noexcept
+{
+  position += count;
+  return position < 2 * capacity ? position : position - 2 * capacity;
+}
+
+inline std::size_t ring_distance(std::size_t from,
+                                 std::size_t to,
+                                 std::size_t capacity) noexcept
+{
+  return to >= from ? to - from : to + 2 * capacity - from;
+}
+
+template <typename T>
+ring_segments<T>
+ring_region(span<T> storage, std::size_t position, std::size_t count) noexcept
+{
+  const std::size_t index = ring_index(position, storage.size());
+  const std::size_t head = storage.size() - index;
+  if (count <= head) {
+    return { storage.subspan(index, count), span<T>() };
+  }
+  return { storage.subspan(index), storage.first(count - head) };
+}
+
+template <typename T>
+void ring_copy_in(span<T> storage, std::size_t position, span<const T> values)
+{
+  const auto region = ring_region(storage, position, values.size());
+  const auto split = values.data() + region.first.size();
+  std::copy(values.data(), split, region.first.data());
+  std::copy(split, values.data() + values.size(), region.second.data());
+}
+
+template <typename T>
+void ring_move_out(span<T> storage, std::size_t position, span<T> values)
+{
+  const auto region = ring_region(storage, position, values.size());
+  std::move(region.first.data(), region.first.data() + region.first.size(),
+            values.data());
+  std::move(region.second.data(), region.second.data() + region.second.size(),
+            values.data() + region.first.size());
+}
+
+}
+
+// A fixed-capacity FIFO queue over caller-provided storage. The elements of
+// the storage stay alive, pushing assigns and popping moves from them.
+template <typename T>
+class ring_span {
+public:
+  using value_type = T;
+  using size_type = std::size_t;
+  using reference = T&;
+  using const_reference = const T&;
+
+  constexpr ring_span() noexcept = default;
+
+  constexpr explicit ring_span(span<T> storage) noexcept
+      : storage_(storage)
+  {
+  }
+
+  size_type capacity() const noexcept
+  {
+    return storage_.size();
+  }
+
+  size_type size() const noexcept
+  {
+    return detail::ring_distance(read_, write_, capacity());
+  }
+
+  bool empty() const noexcept
+  {
+    return read_ == write_;
+  }
+
+  bool full() const noexcept
+  {
+    return size() == capacity();
+  }
+
+  // Returns the `index`-th element counting from the oldest one.
+  reference operator[](size_type index) const noexcept
+  {
+    GUL_ASSERT(index < size());
+    return storage_[detail::ring_index(
+        detail::ring_advance(read_, index, capacity()), capacity())];
+  }
+
+  reference front() const noexcept
+  {
+    GUL_ASSERT(!empty());
+    return storage_[detail::ring_index(read_, capacity())];
+  }
+
+  reference back() const noexcept
+  {
+    GUL_ASSERT(!empty());
+    return (*this)[size() - 1];
+  }
+
+  // Returns false, leaving the ring unchanged, when it is full.
+  bool push(const T& value)
+  {
+    if (full()) {
+      return false;
+    }
+    storage_[detail::ring_index(write_, capacity())] = value;
+    write_ = detail::ring_advance(write_, 1, capacity());
+    return true;
+  }
+
+  bool push(T&& value)
+  {
+    if (full()) {
+      return false;
+    }
+    storage_[detail::ring_index(write_, capacity())] = std::move(value);
+    write_ = detail::ring_advance(write_, 1, capacity());
+    return true;
+  }
+
+  optional<T> pop()
+  {
+    if (empty()) {
+      return nullopt;
+    }
+    optional<T> result(in_place, std::move(front()));
+    read_ = detail::ring_advance(read_, 1, capacity());
+    return result;
+  }
+
+  optional<T&> peek() const noexcept
+  {
+    if (empty()) {
+      return nullopt;
+    }
+    return front();
+  }
+
+  // Copies as many `values` as fit and returns how many were copied.
+  size_type write(span<const T> values)
+  {
+    const size_type count = std::min(values.size(), capacity() - size());
+    detail::ring_copy_in(storage_, write_, values.first(count));
+    write_ = detail::ring_advance(write_, count, capacity());
+    return count;
+  }
+
+  // Moves up to `values.size()` elements out and returns how many were moved.
+  size_type read(span<T> values)
+  {
+    const size_type count = std::min(values.size(), size());
+    detail::ring_move_out(storage_, read_, values.first(count));
+    read_ = detail::ring_advance(read_, count, capacity());
+    return count;
+  }
+
+  // The elements in FIFO order, for batched processing before `consume`.
+  ring_segments<T> readable() const noexcept
+  {
+    return detail::ring_region(storage_, read_, size());
+  }
+
+  // The free slots in FIFO order, to be filled before `commit`.
+  ring_segments<T> writable() const noexcept
+  {
+    return detail::ring_region(storage_, write_, capacity() - size());
+  }
+
+  // Drops the `count` oldest elements.
+  void consume(size_type count) noexcept
+  {
+    GUL_ASSERT(count <= size());
+    read_ = detail::ring_advance(read_, count, capacity());
+  }
+
+  // Publishes the first `count` slots of `writable()` as elements.
+  void commit(size_type count) noexcept
+  {
+    GUL_ASSERT(count <= capacity() - size());
+    write_ = detail::ring_advance(write_, count, capacity());
+  }
+
+  void clear() noexcept
+  {
+    read_ = write_;
+  }
+
+private:
+  span<T> storage_;
+  size_type read_ = 0;
+  size_type write_ = 0;
+};
+
+// A ring_span for exactly one producer thread and one consumer thread.
+// `push`, `write`, `writable` and `commit` belong to the producer, `pop`,
+// `peek`, `read`, `readable` and `consume` to the consumer. Each side only
+// writes its own position, so no read-modify-write operations are needed.
+template <typename T>
+class spsc_ring_span {
+public:
+  using value_type = T;
+  using size_type = std::size_t;
+  using reference = T&;
+  using const_reference = const T&;
+
+  spsc_ring_span() noexcept = default;
+
+  explicit spsc_ring_span(span<T> storage) noexcept
+      : storage_(storage)
+  {
+  }
+
+  spsc_ring_span(const spsc_ring_span&) = delete;
+
+  spsc_ring_span& operator=(const spsc_ring_span&) = delete;
+
+  size_type capacity() const noexcept
+  {
+    return storage_.size();
+  }
+
+  // Only a snapshot when called while the other side is active.
+  size_type size() const noexcept
+  {
+    return detail::ring_distance(read_.load(std::memory_order_acquire),
+                                 write_.load(std::memory_order_acquire),
+                                 capacity());
+  }
+
+  bool empty() const noexcept
+  {
+    return size() == 0;
+  }
+
+  bool push(const T& value)
+  {
+    const size_type write = write_.load(std::memory_order_relaxed);
+    if (free_slots(write) == 0) {
+      return false;
+    }
+    storage_[detail::ring_index(write, capacity())] = value;
+    write_.store(detail::ring_advance(write, 1, capacity()),
+                 std::memory_order_release);
+    return true;
+  }
+
+  bool push(T&& value)
+  {
+    const size_type write = write_.load(std::memory_order_relaxed);
+    if (free_slots(write) == 0) {
+      return false;
+    }
+    storage_[detail::ring_index(write, capacity())] = std::move(value);
+    write_.store(detail::ring_advance(write, 1, capacity()),
+                 std::memory_order_release);
+    return true;
+  }
+
+  optional<T> pop()
+  {
+    const size_type read = read_.load(std::memory_order_relaxed);
+    if (used_slots(read) == 0) {
+      return nullopt;
+    }
+    optional<T> result(
+        in_place, std::move(storage_[detail::ring_index(read, capacity())]));
+    read_.store(detail::ring_advance(read, 1, capacity()),
+                std::memory_order_release);
+    return result;
+  }
+
+  optional<T&> peek() const noexcept
+  {
+    const size_type read = read_.load(std::memory_order_relaxed);
+    if (used_slots(read) == 0) {
+      return nullopt;
+    }
+    return storage_[detail::ring_index(read, capacity())];
+  }
+
+  size_type write(span<const T> values)
+  {
+    const size_type write = write_.load(std::memory_order_relaxed);
+    const size_type count = std::min(values.size(), free_slots(write));
+    detail::ring_copy_in(storage_, write, values.first(count));
+    write_.store(detail::ring_advance(write, count, capacity()),
+                 std::memory_order_release);
+    return count;
+  }
+
+  size_type read(span<T> values)
+  {
+    const size_type read = read_.load(std::memory_order_relaxed);
+    const size_type count = std::min(values.size(), used_slots(read));
+    detail::ring_move_out(storage_, read, values.first(count));
+    read_.store(detail::ring_advance(read, count, capacity()),
+                std::memory_order_release);
+    return count;
+  }
+
+  ring_segments<T> readable() const noexcept
+  {
+    const size_type read = read_.load(std::memory_order_relaxed);
+    return detail::ring_region(storage_, read, used_slots(read));
+  }
+
+  ring_segments<T> writable() const noexcept
+  {
+    const size_type write = write_.load(std::memory_order_relaxed);
+    return detail::ring_region(storage_, write, free_slots(write));
+  }
+
+  void consume(size_type count) noexcept
+  {
+    const size_type read = read_.load(std::memory_order_relaxed);
+    GUL_ASSERT(count <= used_slots(read));
+    read_.store(detail::ring_advance(read, count, capacity()),
+                std::memory_order_release);
+  }
+
+  void commit(size_type count) noexcept
+  {
+    const size_type write = write_.load(std::memory_order_relaxed);
+    GUL_ASSERT(count <= free_slots(write));
+    write_.store(detail::ring_advance(write, count, capacity()),
+                 std::memory_order_release);
+  }
+
+private:
+  // The acquire loads pair with the other side's release stores, so the
+  // slots it handed over are visible before they are touched.
+  size_type free_slots(size_type write) const noexcept
+  {
+    return capacity()
+        - detail::ring_distance(read_.load(std::memory_order_acquire), write,
+                                capacity());
+  }
+
+  size_type used_slots(size_type read) const noexcept
+  {
+    return detail::ring_distance(read, write_.load(std::memory_order_acquire),
+                                 capacity());
+  }
+
+  span<T> storage_;
+  // Kept on separate cache lines so the two threads do not false-share.
+  alignas(64) std::atomic<size_type> read_ { 0 };
+  alignas(64) std::atomic<size_type> write_ { 0 };
+};
+
+GUL_NAMESPACE_END
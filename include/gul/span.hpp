@@ -11,6 +11,7 @@
 
 #include <gul/detail/constructor_base.hpp>
 
+#include <gul/bounds_check.hpp>
 #include <gul/byte.hpp>
 #include <gul/type_traits.hpp>
 #include <gul/utility.hpp>
@@ -55,7 +56,12 @@ using enable_default_construct_base
     = detail::default_construct_base<Extent == 0 || Extent == dynamic_extent>;
 }
 
-template <typename T, std::size_t Extent = dynamic_extent>
+// `BoundsCheck` is one of the policies of gul/bounds_check.hpp and applies
+// to `operator[]`, `front`, `back`, `first`, `last` and `subspan`. Iterators
+// are never checked.
+template <typename T,
+          std::size_t Extent = dynamic_extent,
+          typename BoundsCheck = bounds_check_default>
 class span : private detail::span_storage_base<T, Extent>,
              private detail::enable_default_construct_base<Extent> {
   using base_type = detail::span_storage_base<T, Extent>;
@@ -76,32 +82,27 @@ class span : private detail::span_storage_base<T, Extent>,
 
     GUL_CXX14_CONSTEXPR reference operator*() noexcept
     {
-      GUL_ASSERT(curr_ != nullptr);
       return *curr_;
     }
 
     GUL_CXX14_CONSTEXPR pointer operator->() noexcept
     {
-      GUL_ASSERT(curr_ != nullptr);
       return curr_;
     }
 
     GUL_CXX14_CONSTEXPR reference operator[](difference_type n)
     {
-      GUL_ASSERT(curr_ != nullptr);
       return *(curr_ + n);
     }
 
     GUL_CXX14_CONSTEXPR iterator_impl& operator++()
     {
-      GUL_ASSERT(curr_ != nullptr);
       ++curr_;
       return *this;
     }
 
     GUL_CXX14_CONSTEXPR iterator_impl operator++(int)
     {
-      GUL_ASSERT(curr_ != nullptr);
       auto it = *this;
       ++*this;
       return it;
@@ -109,14 +110,12 @@ class span : private detail::span_storage_base<T, Extent>,
 
     GUL_CXX14_CONSTEXPR iterator_impl& operator--()
     {
-      GUL_ASSERT(curr_ != nullptr);
       --curr_;
       return *this;
     }
 
     GUL_CXX14_CONSTEXPR iterator_impl operator--(int)
     {
-      GUL_ASSERT(curr_ != nullptr);
       auto it = *this;
       --*this;
       return it;
@@ -125,7 +124,6 @@ class span : private detail::span_storage_base<T, Extent>,
     friend GUL_CXX14_CONSTEXPR iterator_impl& operator+=(iterator_impl& it,
                                                          difference_type n)
     {
-      GUL_ASSERT(it.curr_ != nullptr);
       it.curr_ += n;
       return it;
     }
@@ -133,7 +131,6 @@ class span : private detail::span_storage_base<T, Extent>,
     friend GUL_CXX14_CONSTEXPR iterator_impl& operator-=(iterator_impl& it,
                                                          difference_type n)
     {
-      GUL_ASSERT(it.curr_ != nullptr);
       it.curr_ -= n;
       return it;
     }
@@ -240,8 +237,9 @@ public:
 
   template <typename Iter,
             GUL_REQUIRES(std::is_convertible<
-                         typename std::iterator_traits<Iter>::reference,
-                         element_type&>::value)>
+                             typename std::iterator_traits<Iter>::reference,
+                             element_type&>::value
+                         && !std::is_convertible<Iter, pointer>::value)>
   constexpr GUL_CXX20_EXPLICIT(Extent != dynamic_extent)
       span(Iter first, size_type size)
       : base_type(first.operator->(), size)
@@ -251,8 +249,9 @@ public:
 
   template <typename Iter,
             GUL_REQUIRES(std::is_convertible<
-                         typename std::iterator_traits<Iter>::reference,
-                         element_type&>::value)>
+                             typename std::iterator_traits<Iter>::reference,
+                             element_type&>::value
+                         && !std::is_convertible<Iter, pointer>::value)>
   constexpr GUL_CXX20_EXPLICIT(Extent != dynamic_extent)
       span(Iter first, Iter last)
       : base_type(first.operator->(), size_type(last - first))
@@ -288,25 +287,40 @@ public:
   }
 #endif
 
+  template <typename U,
+            std::size_t N,
+            typename OtherBoundsCheck,
+            GUL_REQUIRES((extent == dynamic_extent || N == dynamic_extent
+                          || N == extent)
+                         && std::is_convertible<U (*)[],
+                                                element_type (*)[]>::value)>
+  constexpr GUL_CXX20_EXPLICIT(extent != dynamic_extent
+                               && N == dynamic_extent)
+      span(const span<U, N, OtherBoundsCheck>& other) noexcept
+      : base_type(other.data(), other.size())
+      , dc_base_type(in_place)
+  {
+  }
+
   GUL_CXX14_CONSTEXPR span(const span&) noexcept = default;
 
   GUL_CXX14_CONSTEXPR span& operator=(const span&) noexcept = default;
 
   GUL_CXX14_CONSTEXPR reference front() const
   {
-    GUL_ASSERT(size() > 0);
+    BoundsCheck::check(size() > 0);
     return *data();
   }
 
   GUL_CXX14_CONSTEXPR reference back() const
   {
-    GUL_ASSERT(size() > 0);
+    BoundsCheck::check(size() > 0);
     return *(data() + size() - 1);
   }
 
   GUL_CXX14_CONSTEXPR reference operator[](size_type index) const
   {
-    GUL_ASSERT(index < size());
+    BoundsCheck::check(index < size());
     return *(data() + index);
   }
 
@@ -331,58 +345,66 @@ public:
   }
 
   template <std::size_t Count>
-  GUL_CXX14_CONSTEXPR span<T, Count> first() const
+  GUL_CXX14_CONSTEXPR span<T, Count, BoundsCheck> first() const
   {
     static_assert(Count <= Extent, "[span::first] Count out of range");
-    GUL_ASSERT(Count <= size());
-    return span<T, Count>(data(), Count);
+    BoundsCheck::check(Count <= size());
+    return span<T, Count, BoundsCheck>(data(), Count);
   }
 
-  GUL_CXX14_CONSTEXPR span<T, dynamic_extent> first(size_type count) const
+  GUL_CXX14_CONSTEXPR span<T, dynamic_extent, BoundsCheck>
+  first(size_type count) const
   {
-    GUL_ASSERT(count <= size());
-    return span<T, dynamic_extent>(data(), count);
+    BoundsCheck::check(count <= size());
+    return span<T, dynamic_extent, BoundsCheck>(data(), count);
   }
 
   template <std::size_t Count>
-  GUL_CXX14_CONSTEXPR span<T, Count> last() const
+  GUL_CXX14_CONSTEXPR span<T, Count, BoundsCheck> last() const
   {
-    static_assert(Count <= Extent, "[span::first] Count out of range");
-    GUL_ASSERT(Count <= size());
-    return span<T, Count>(data() + (size() - Count), Count);
+    static_assert(Count <= Extent, "[span::last] Count out of range");
+    BoundsCheck::check(Count <= size());
+    return span<T, Count, BoundsCheck>(data() + (size() - Count), Count);
   }
 
-  GUL_CXX14_CONSTEXPR span<T, dynamic_extent> last(size_type count) const
+  GUL_CXX14_CONSTEXPR span<T, dynamic_extent, BoundsCheck>
+  last(size_type count) const
   {
-    GUL_ASSERT(count <= size());
-    return span<T, dynamic_extent>(data() + (size() - count), count);
+    BoundsCheck::check(count <= size());
+    return span<T, dynamic_extent, BoundsCheck>(data() + (size() - count),
+                                                count);
   }
 
   template <std::size_t Offset, std::size_t Count = dynamic_extent>
   GUL_CXX14_CONSTEXPR span<element_type,
                            (Count != dynamic_extent        ? Count
                                 : Extent != dynamic_extent ? Extent - Offset
-                                                           : dynamic_extent)>
+                                                           : dynamic_extent),
+                           BoundsCheck>
   subspan() const
   {
     static_assert(Offset <= Extent, "[span::subspan] Offset out of range");
-    static_assert(Count != dynamic_extent && Count + Offset <= Extent,
+    static_assert(Count == dynamic_extent || Extent == dynamic_extent
+                      || Count <= Extent - Offset,
                   "[span::subspan] Count out of range");
-    GUL_ASSERT(Offset <= size());
-    GUL_ASSERT(Count != dynamic_extent && Count + Offset <= size());
+    BoundsCheck::check(Offset <= size());
+    BoundsCheck::check(Count == dynamic_extent || Count <= size() - Offset);
     return span<element_type,
                 (Count != dynamic_extent        ? Count
                      : Extent != dynamic_extent ? Extent - Offset
-                                                : dynamic_extent)>(
-        data() + Offset, Count);
+                                                : dynamic_extent),
+                BoundsCheck>(data() + Offset, Count != dynamic_extent
+                                                  ? Count
+                                                  : size() - Offset);
   }
 
-  GUL_CXX14_CONSTEXPR span<element_type, dynamic_extent>
+  GUL_CXX14_CONSTEXPR span<element_type, dynamic_extent, BoundsCheck>
   subspan(size_type offset, size_type count = dynamic_extent) const
   {
-    GUL_ASSERT(offset <= size());
-    GUL_ASSERT(count != dynamic_extent && count + offset <= size());
-    return span<element_type, dynamic_extent>(data() + offset, count);
+    BoundsCheck::check(offset <= size());
+    BoundsCheck::check(count == dynamic_extent || count <= size() - offset);
+    return span<element_type, dynamic_extent, BoundsCheck>(
+        data() + offset, count != dynamic_extent ? count : size() - offset);
   }
 
   constexpr iterator begin() const noexcept
@@ -406,8 +428,8 @@ public:
   }
 };
 
-template <typename T, std::size_t Extent>
-constexpr std::size_t span<T, Extent>::extent;
+template <typename T, std::size_t Extent, typename BoundsCheck>
+constexpr std::size_t span<T, Extent, BoundsCheck>::extent;
 
 #ifdef GUL_HAS_CXX17
 
@@ -434,20 +456,26 @@ struct extent_multiplier<dynamic_extent, Mul>
     : integral_constant<std::size_t, dynamic_extent> { };
 }
 
-template <class T, std::size_t N>
-auto as_bytes(span<T, N> s) noexcept
-    -> span<const byte, detail::extent_multiplier<N, sizeof(N)>::value>
+template <class T, std::size_t N, class BoundsCheck>
+auto as_bytes(span<T, N, BoundsCheck> s) noexcept
+    -> span<const byte,
+            detail::extent_multiplier<N, sizeof(T)>::value,
+            BoundsCheck>
 {
-  return span<const byte, detail::extent_multiplier<N, sizeof(N)>::value>(
-      reinterpret_cast<const byte*>(s.data()), s.size_bytes());
+  return span<const byte, detail::extent_multiplier<N, sizeof(T)>::value,
+              BoundsCheck>(reinterpret_cast<const byte*>(s.data()),
+                           s.size_bytes());
 }
 
-template <class T, std::size_t N>
-auto as_writable_bytes(span<T, N> s) noexcept
-    -> span<byte, detail::extent_multiplier<N, sizeof(N)>::value>
+template <class T,
+          std::size_t N,
+          class BoundsCheck,
+          GUL_REQUIRES(!std::is_const<T>::value)>
+auto as_writable_bytes(span<T, N, BoundsCheck> s) noexcept
+    -> span<byte, detail::extent_multiplier<N, sizeof(T)>::value, BoundsCheck>
 {
-  return span<byte, detail::extent_multiplier<N, sizeof(N)>::value>(
-      reinterpret_cast<byte*>(s.data()), s.size_bytes());
+  return span<byte, detail::extent_multiplier<N, sizeof(T)>::value,
+              BoundsCheck>(reinterpret_cast<byte*>(s.data()), s.size_bytes());
 }
 
 GUL_NAMESPACE_END
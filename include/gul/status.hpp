@@ -0,0 +1,201 @@
+//
+// Copyright (c) 2022 Ramirisu (labyrinth dot ramirisu at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#pragma once
+
+#include <gul/config.hpp>
+
+#include <gul/niche.hpp>
+#include <gul/string_view.hpp>
+
+#include <cstdint>
+#include <mutex>
+#include <set>
+#include <string>
+#include <system_error>
+
+GUL_NAMESPACE_BEGIN
+
+namespace detail {
+
+struct status_payload {
+  std::uint16_t domain;
+  std::int32_t code;
+  std::string message;
+
+  friend bool operator<(const status_payload& lhs, const status_payload& rhs)
+  {
+    if (lhs.domain != rhs.domain) {
+      return lhs.domain < rhs.domain;
+    }
+    if (lhs.code != rhs.code) {
+      return lhs.code < rhs.code;
+    }
+    return lhs.message < rhs.message;
+  }
+};
+
+// Payloads are interned and live until the program exits, which is what
+// keeps `status` trivially copyable.
+inline const status_payload* intern_status_payload(std::uint16_t domain,
+                                                   std::int32_t code,
+                                                   string_view message)
+{
+  static std::mutex mutex;
+  static std::set<status_payload> payloads;
+  std::lock_guard<std::mutex> lock(mutex);
+  return &*payloads
+               .insert(status_payload {
+                   domain, code, std::string(message.data(), message.size()) })
+               .first;
+}
+
+}
+
+// The domain whose codes are `std::errc` values.
+GUL_CXX17_INLINE constexpr std::uint16_t generic_status_domain = 0;
+
+// A one-word error code for `expected<T, status>`, in place of
+// `std::error_code`. A `status` is either ok, a `(domain, code)` pair packed
+// into the word, or a pointer to an interned payload that additionally holds
+// a message. It is trivially copyable, so `expected<T, status>` is passed in
+// registers, and comparisons do not go through a category.
+//
+// Domains other than `generic_status_domain` are assigned by the
+// application. Messages attached by `with_message` are kept until the
+// program exits, so they should come from a bounded set, e.g. not embed user
+// input.
+class status {
+public:
+  using domain_type = std::uint16_t;
+  using code_type = std::int32_t;
+
+  constexpr status() noexcept
+      : rep_(0)
+  {
+  }
+
+  constexpr status(std::errc code) noexcept
+      : status(generic_status_domain, code_type(code))
+  {
+  }
+
+  constexpr status(domain_type domain, code_type code) noexcept
+      : rep_((std::uint64_t(std::uint32_t(code)) << 32)
+             | (std::uint64_t(domain) << 16) | inline_tag)
+  {
+  }
+
+  static status with_message(domain_type domain,
+                             code_type code,
+                             string_view message)
+  {
+    status s;
+    s.rep_ = std::uint64_t(reinterpret_cast<std::uintptr_t>(
+        detail::intern_status_payload(domain, code, message)));
+    return s;
+  }
+
+  static status with_message(std::errc code, string_view message)
+  {
+    return with_message(generic_status_domain, code_type(code), message);
+  }
+
+  constexpr bool ok() const noexcept
+  {
+    return rep_ == 0;
+  }
+
+  domain_type domain() const noexcept
+  {
+    return has_payload() ? payload()->domain : domain_type(rep_ >> 16);
+  }
+
+  code_type code() const noexcept
+  {
+    return has_payload() ? payload()->code
+                         : code_type(std::uint32_t(rep_ >> 32));
+  }
+
+  bool has_message() const noexcept
+  {
+    return has_payload();
+  }
+
+  // The attached message, or else a description of the code.
+  std::string message() const
+  {
+    if (ok()) {
+      return "ok";
+    }
+    if (has_payload()) {
+      return payload()->message;
+    }
+    if (domain() == generic_status_domain) {
+      return std::generic_category().message(code());
+    }
+    return "domain " + std::to_string(domain()) + " code "
+        + std::to_string(code());
+  }
+
+  // Statuses compare equal by domain and code; messages are not compared.
+  friend bool operator==(const status& lhs, const status& rhs) noexcept
+  {
+    return lhs.rep_ == rhs.rep_
+        || (!lhs.ok() && !rhs.ok() && lhs.domain() == rhs.domain()
+            && lhs.code() == rhs.code());
+  }
+
+  friend bool operator!=(const status& lhs, const status& rhs) noexcept
+  {
+    return !(lhs == rhs);
+  }
+
+  friend bool operator==(const status& lhs, std::errc rhs) noexcept
+  {
+    return lhs == status(rhs);
+  }
+
+  friend bool operator!=(const status& lhs, std::errc rhs) noexcept
+  {
+    return !(lhs == rhs);
+  }
+
+private:
+  static constexpr std::uint64_t inline_tag = 1;
+
+  bool has_payload() const noexcept
+  {
+    return rep_ != 0 && (rep_ & inline_tag) == 0;
+  }
+
+  const detail::status_payload* payload() const noexcept
+  {
+    return reinterpret_cast<const detail::status_payload*>(
+        std::uintptr_t(rep_));
+  }
+
+  std::uint64_t rep_;
+};
+
+// An ok `status` means success, so `expected<void, status>` is a single word
+// whose success check is a comparison with zero. `optional<status>` is not
+// affected and can hold an ok status.
+template <>
+struct expected_error_niche<status> {
+  static constexpr status success_value() noexcept
+  {
+    return status();
+  }
+
+  static constexpr bool is_success(const status& value) noexcept
+  {
+    return value.ok();
+  }
+};
+
+GUL_NAMESPACE_END
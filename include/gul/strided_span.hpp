@@ -0,0 +1,544 @@
+//
+// Copyright (c) 2022 Ramirisu (labyrinth dot ramirisu at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#pragma once
+
+#include <gul/config.hpp>
+
+#include <gul/detail/bit.hpp>
+
+#include <gul/bounds_check.hpp>
+#include <gul/span.hpp>
+#include <gul/type_traits.hpp>
+#include <gul/utility.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+
+GUL_NAMESPACE_BEGIN
+
+GUL_CXX17_INLINE constexpr std::size_t dynamic_stride = std::size_t(-1);
+
+namespace detail {
+
+template <std::size_t Stride>
+struct stride_storage_base {
+  constexpr stride_storage_base() noexcept = default;
+
+  GUL_CXX14_CONSTEXPR stride_storage_base(std::size_t stride) noexcept
+  {
+    GUL_ASSERT(stride == Stride);
+    GUL_UNUSED(stride);
+  }
+
+  static constexpr std::size_t get_stride() noexcept
+  {
+    return Stride;
+  }
+};
+
+template <>
+struct stride_storage_base<dynamic_stride> {
+  constexpr stride_storage_base() noexcept = default;
+
+  constexpr stride_storage_base(std::size_t stride) noexcept
+      : stride_(stride)
+  {
+  }
+
+  constexpr std::size_t get_stride() const noexcept
+  {
+    return stride_;
+  }
+
+  std::size_t stride_ = 0;
+};
+
+template <typename T>
+using strided_byte_t = conditional_t<
+    std::is_const<T>::value,
+    conditional_t<std::is_volatile<T>::value,
+                  const volatile unsigned char,
+                  const unsigned char>,
+    conditional_t<std::is_volatile<T>::value,
+                  volatile unsigned char,
+                  unsigned char>>;
+
+template <typename T>
+T* strided_advance(T* pointer, std::ptrdiff_t bytes) noexcept
+{
+  return reinterpret_cast<T*>(reinterpret_cast<strided_byte_t<T>*>(pointer)
+                              + bytes);
+}
+
+template <typename T>
+std::ptrdiff_t strided_distance(T* first, T* last) noexcept
+{
+  return reinterpret_cast<strided_byte_t<T>*>(last)
+      - reinterpret_cast<strided_byte_t<T>*>(first);
+}
+
+}
+
+// `BoundsCheck` applies to `operator[]`, `front`, `back`, `first`, `last`
+// and `subspan`, as for `span`. Iterators are never checked.
+template <typename T,
+          std::size_t Stride = dynamic_stride,
+          typename BoundsCheck = bounds_check_default>
+class strided_span : private detail::stride_storage_base<Stride> {
+  static_assert(Stride != 0, "[strided_span] Stride must not be zero");
+
+  using base_type = detail::stride_storage_base<Stride>;
+
+  template <typename, std::size_t, typename>
+  friend class strided_span;
+
+  class iterator_impl : private detail::stride_storage_base<Stride> {
+    friend class strided_span;
+
+    using base_type = detail::stride_storage_base<Stride>;
+
+  public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = remove_cv_t<T>;
+    using reference = T&;
+    using pointer = T*;
+    using difference_type = std::ptrdiff_t;
+
+    constexpr iterator_impl() noexcept = default;
+
+    reference operator*() const noexcept
+    {
+      return *curr_;
+    }
+
+    pointer operator->() const noexcept
+    {
+      return curr_;
+    }
+
+    reference operator[](difference_type n) const
+    {
+      return *advance(curr_, n);
+    }
+
+    iterator_impl& operator++()
+    {
+      curr_ = advance(curr_, 1);
+      return *this;
+    }
+
+    iterator_impl operator++(int)
+    {
+      auto it = *this;
+      ++*this;
+      return it;
+    }
+
+    iterator_impl& operator--()
+    {
+      curr_ = advance(curr_, -1);
+      return *this;
+    }
+
+    iterator_impl operator--(int)
+    {
+      auto it = *this;
+      --*this;
+      return it;
+    }
+
+    friend iterator_impl& operator+=(iterator_impl& it, difference_type n)
+    {
+      it.curr_ = it.advance(it.curr_, n);
+      return it;
+    }
+
+    friend iterator_impl& operator-=(iterator_impl& it, difference_type n)
+    {
+      it.curr_ = it.advance(it.curr_, -n);
+      return it;
+    }
+
+    friend iterator_impl operator+(const iterator_impl& it, difference_type n)
+    {
+      auto temp = it;
+      return temp += n;
+    }
+
+    friend iterator_impl operator+(difference_type n, const iterator_impl& it)
+    {
+      auto temp = it;
+      return temp += n;
+    }
+
+    friend iterator_impl operator-(const iterator_impl& it, difference_type n)
+    {
+      auto temp = it;
+      return temp -= n;
+    }
+
+    friend difference_type operator-(const iterator_impl& lhs,
+                                     const iterator_impl& rhs)
+    {
+      return detail::strided_distance(rhs.curr_, lhs.curr_)
+          / static_cast<difference_type>(lhs.get_stride());
+    }
+
+    friend bool operator==(const iterator_impl& lhs, const iterator_impl& rhs)
+    {
+      return lhs.curr_ == rhs.curr_;
+    }
+
+    friend bool operator!=(const iterator_impl& lhs, const iterator_impl& rhs)
+    {
+      return lhs.curr_ != rhs.curr_;
+    }
+
+    friend bool operator<(const iterator_impl& lhs, const iterator_impl& rhs)
+    {
+      return lhs - rhs < 0;
+    }
+
+    friend bool operator<=(const iterator_impl& lhs, const iterator_impl& rhs)
+    {
+      return lhs - rhs <= 0;
+    }
+
+    friend bool operator>(const iterator_impl& lhs, const iterator_impl& rhs)
+    {
+      return lhs - rhs > 0;
+    }
+
+    friend bool operator>=(const iterator_impl& lhs, const iterator_impl& rhs)
+    {
+      return lhs - rhs >= 0;
+    }
+
+  private:
+    iterator_impl(T* curr, std::size_t stride) noexcept
+        : base_type(stride)
+        , curr_(curr)
+    {
+    }
+
+    T* advance(T* p, difference_type n) const noexcept
+    {
+      return detail::strided_advance(
+          p, n * static_cast<difference_type>(this->get_stride()));
+    }
+
+    T* curr_ = nullptr;
+  };
+
+public:
+  using element_type = T;
+  using value_type = remove_cv_t<T>;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using pointer = T*;
+  using const_pointer = const T*;
+  using reference = T&;
+  using const_reference = const T&;
+  using iterator = iterator_impl;
+  using reverse_iterator = std::reverse_iterator<iterator>;
+
+  static constexpr std::size_t static_stride = Stride;
+
+  constexpr strided_span() noexcept = default;
+
+  // `stride` is the distance in bytes between two consecutive elements.
+  GUL_CXX14_CONSTEXPR strided_span(pointer first,
+                                   size_type count,
+                                   size_type stride)
+      : base_type(stride)
+      , data_(first)
+      , size_(count)
+  {
+    GUL_ASSERT(stride > 0);
+  }
+
+  template <std::size_t S = Stride, GUL_REQUIRES(S != dynamic_stride)>
+  constexpr strided_span(pointer first, size_type count) noexcept
+      : data_(first)
+      , size_(count)
+  {
+  }
+
+  template <typename U,
+            std::size_t N,
+            typename OtherBoundsCheck,
+            GUL_REQUIRES(std::is_convertible<U (*)[], T (*)[]>::value
+                         && (Stride == dynamic_stride
+                             || Stride == sizeof(U)))>
+  GUL_CXX14_CONSTEXPR strided_span(span<U, N, OtherBoundsCheck> s) noexcept
+      : base_type(sizeof(U))
+      , data_(s.data())
+      , size_(s.size())
+  {
+  }
+
+  template <typename U,
+            std::size_t S,
+            typename OtherBoundsCheck,
+            GUL_REQUIRES(std::is_convertible<U (*)[], T (*)[]>::value
+                         && (Stride == dynamic_stride || Stride == S))>
+  GUL_CXX14_CONSTEXPR
+  strided_span(const strided_span<U, S, OtherBoundsCheck>& other) noexcept
+      : base_type(other.stride())
+      , data_(other.data())
+      , size_(other.size())
+  {
+  }
+
+  reference front() const
+  {
+    BoundsCheck::check(size() > 0);
+    return *data();
+  }
+
+  reference back() const
+  {
+    BoundsCheck::check(size() > 0);
+    return (*this)[size() - 1];
+  }
+
+  reference operator[](size_type index) const
+  {
+    BoundsCheck::check(index < size());
+    return *advance(index);
+  }
+
+  constexpr pointer data() const noexcept
+  {
+    return data_;
+  }
+
+  constexpr size_type size() const noexcept
+  {
+    return size_;
+  }
+
+  constexpr size_type stride() const noexcept
+  {
+    return this->get_stride();
+  }
+
+  constexpr bool empty() const noexcept
+  {
+    return size() == 0;
+  }
+
+  strided_span first(size_type count) const
+  {
+    BoundsCheck::check(count <= size());
+    return strided_span(data(), count, stride());
+  }
+
+  strided_span last(size_type count) const
+  {
+    BoundsCheck::check(count <= size());
+    return strided_span(advance(size() - count), count, stride());
+  }
+
+  strided_span subspan(size_type offset,
+                       size_type count = dynamic_extent) const
+  {
+    BoundsCheck::check(offset <= size());
+    BoundsCheck::check(count == dynamic_extent || count <= size() - offset);
+    return strided_span(advance(offset),
+                        count == dynamic_extent ? size() - offset : count,
+                        stride());
+  }
+
+  iterator begin() const noexcept
+  {
+    return iterator(data(), stride());
+  }
+
+  iterator end() const noexcept
+  {
+    return iterator(advance(size()), stride());
+  }
+
+  reverse_iterator rbegin() const noexcept
+  {
+    return reverse_iterator(end());
+  }
+
+  reverse_iterator rend() const noexcept
+  {
+    return reverse_iterator(begin());
+  }
+
+private:
+  pointer advance(size_type n) const noexcept
+  {
+    return detail::strided_advance(
+        data(), static_cast<difference_type>(n * stride()));
+  }
+
+  pointer data_ = nullptr;
+  size_type size_ = 0;
+};
+
+template <typename T, std::size_t Stride, typename BoundsCheck>
+constexpr std::size_t strided_span<T, Stride, BoundsCheck>::static_stride;
+
+#ifdef GUL_HAS_CXX17
+
+template <typename T>
+strided_span(T*, std::size_t, std::size_t) -> strided_span<T>;
+
+template <typename T, std::size_t N, typename BoundsCheck>
+strided_span(span<T, N, BoundsCheck>)
+    -> strided_span<T, sizeof(T), BoundsCheck>;
+
+#endif
+
+// Views one data member of every element in `s`, e.g.
+// `make_strided_span(records, &record::price)`.
+template <typename T,
+          std::size_t N,
+          typename BoundsCheck,
+          typename Class,
+          typename Member,
+          GUL_REQUIRES(std::is_same<remove_cv_t<T>, Class>::value)>
+auto make_strided_span(span<T, N, BoundsCheck> s,
+                       Member Class::*member) noexcept
+    -> strided_span<conditional_t<std::is_const<T>::value,
+                                  const Member,
+                                  Member>,
+                    sizeof(T),
+                    BoundsCheck>
+{
+  using result_type = strided_span<
+      conditional_t<std::is_const<T>::value, const Member, Member>,
+      sizeof(T),
+      BoundsCheck>;
+  return s.empty() ? result_type()
+                   : result_type(&(s.data()->*member), s.size());
+}
+
+namespace detail {
+
+template <typename T>
+void strided_gather_scalar(const unsigned char* src,
+                           std::size_t stride,
+                           std::size_t count,
+                           T* dst) noexcept
+{
+  for (std::size_t i = 0; i < count; ++i) {
+    std::memcpy(dst + i, src + i * stride, sizeof(T));
+  }
+}
+
+#ifdef GUL_HAS_AVX2
+inline std::size_t strided_gather_avx2(const unsigned char* src,
+                                       std::size_t stride,
+                                       std::size_t count,
+                                       void* dst,
+                                       integral_constant<std::size_t, 4>)
+{
+  const int s = static_cast<int>(stride);
+  const __m256i offsets
+      = _mm256_setr_epi32(0, s, 2 * s, 3 * s, 4 * s, 5 * s, 6 * s, 7 * s);
+  auto out = static_cast<unsigned char*>(dst);
+  std::size_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    const __m256i values = _mm256_i32gather_epi32(
+        reinterpret_cast<const int*>(src + i * stride), offsets, 1);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i * 4), values);
+  }
+  return i;
+}
+
+inline std::size_t strided_gather_avx2(const unsigned char* src,
+                                       std::size_t stride,
+                                       std::size_t count,
+                                       void* dst,
+                                       integral_constant<std::size_t, 8>)
+{
+  const int s = static_cast<int>(stride);
+  const __m128i offsets = _mm_setr_epi32(0, s, 2 * s, 3 * s);
+  auto out = static_cast<unsigned char*>(dst);
+  std::size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    const __m256i values = _mm256_i32gather_epi64(
+        reinterpret_cast<const long long*>(src + i * stride), offsets, 1);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i * 8), values);
+  }
+  return i;
+}
+
+template <std::size_t Size>
+std::size_t strided_gather_avx2(const unsigned char*,
+                                std::size_t,
+                                std::size_t,
+                                void*,
+                                integral_constant<std::size_t, Size>)
+{
+  return 0;
+}
+#endif
+
+template <typename T, typename U>
+void strided_gather(T* src,
+                    std::size_t stride,
+                    std::size_t count,
+                    U* dst,
+                    std::true_type) noexcept
+{
+  const auto bytes = reinterpret_cast<const unsigned char*>(src);
+  if (stride == sizeof(U)) {
+    if (count != 0) {
+      std::memcpy(dst, bytes, count * sizeof(U));
+    }
+    return;
+  }
+  std::size_t i = 0;
+#ifdef GUL_HAS_AVX2
+  // Hardware gathers take 32-bit offsets, so the offset of the last lane has
+  // to fit into an int.
+  if (stride <= std::size_t(INT32_MAX / 8)) {
+    i = strided_gather_avx2(bytes, stride, count, dst,
+                            integral_constant<std::size_t, sizeof(U)> {});
+  }
+#endif
+  strided_gather_scalar(bytes + i * stride, stride, count - i, dst + i);
+}
+
+template <typename T, typename U>
+void strided_gather(T* src,
+                    std::size_t stride,
+                    std::size_t count,
+                    U* dst,
+                    std::false_type)
+{
+  for (std::size_t i = 0; i < count; ++i) {
+    dst[i] = *strided_advance(src, static_cast<std::ptrdiff_t>(i * stride));
+  }
+}
+
+}
+
+// Copies the elements of `src` into the contiguous buffer `dst` and returns
+// the part of `dst` that was written.
+template <typename T, std::size_t Stride, typename BoundsCheck>
+span<remove_cv_t<T>> gather(strided_span<T, Stride, BoundsCheck> src,
+                            span<remove_cv_t<T>> dst)
+{
+  BoundsCheck::check(src.size() <= dst.size());
+  detail::strided_gather(src.data(), src.stride(), src.size(), dst.data(),
+                         bool_constant<std::is_arithmetic<T>::value
+                                       && !std::is_volatile<T>::value> {});
+  return dst.first(src.size());
+}
+
+GUL_NAMESPACE_END
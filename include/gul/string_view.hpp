@@ -9,10 +9,15 @@
 
 #include <gul/config.hpp>
 
+#include <gul/detail/ascii.hpp>
+#include <gul/detail/hash.hpp>
+
 #include <gul/type_traits.hpp>
 
 #include <climits>
 #include <cstddef>
+#include <cstdint>
+#include <limits>
 #include <string>
 
 #ifdef GUL_HAS_CXX17
@@ -823,60 +828,122 @@ inline namespace string_view_literals {
 }
 }
 
-GUL_NAMESPACE_END
+template <class CharT, class Traits = std::char_traits<CharT>>
+class basic_string_view_hash {
+  static_assert(std::is_same<Traits, std::char_traits<CharT>>::value,
+                "[basic_string_view_hash] the raw characters are hashed, so "
+                "Traits must be std::char_traits<CharT>");
 
-namespace std {
-template <>
-struct hash<gul::string_view> {
-  std::size_t operator()(gul::string_view sv) const
+public:
+  using is_transparent = void;
+
+  constexpr basic_string_view_hash() noexcept
+      : seed_(0)
   {
-#ifdef GUL_HAS_CXX17
-    return hash<string_view>()(string_view(sv.data(), sv.size()));
-#else
-    return hash<string>()(static_cast<string>(sv));
-#endif
   }
-};
-template <>
-struct hash<gul::wstring_view> {
-  std::size_t operator()(gul::wstring_view sv) const
+
+  constexpr explicit basic_string_view_hash(std::uint64_t seed) noexcept
+      : seed_(seed)
   {
-#ifdef GUL_HAS_CXX17
-    return hash<wstring_view>()(wstring_view(sv.data(), sv.size()));
-#else
-    return hash<wstring>()(static_cast<wstring>(sv));
-#endif
   }
-};
-template <>
-struct hash<gul::u16string_view> {
-  std::size_t operator()(gul::u16string_view sv) const
+
+  std::size_t operator()(basic_string_view<CharT, Traits> sv) const noexcept
   {
-#ifdef GUL_HAS_CXX17
-    return hash<u16string_view>()(u16string_view(sv.data(), sv.size()));
-#else
-    return hash<u16string>()(static_cast<u16string>(sv));
+    return static_cast<std::size_t>(
+        detail::hash_bytes(sv.data(), sv.size() * sizeof(CharT), seed_));
+  }
+
+private:
+  std::uint64_t seed_;
+};
+
+using string_view_hash = basic_string_view_hash<char>;
+using wstring_view_hash = basic_string_view_hash<wchar_t>;
+using u16string_view_hash = basic_string_view_hash<char16_t>;
+using u32string_view_hash = basic_string_view_hash<char32_t>;
+#if defined(GUL_HAS_CXX20) || defined(__cpp_char8_t)
+using u8string_view_hash = basic_string_view_hash<char8_t>;
 #endif
+
+inline bool iequals(string_view lhs, string_view rhs) noexcept
+{
+  return lhs.size() == rhs.size()
+      && detail::ascii_imismatch(lhs.data(), rhs.data(), lhs.size())
+      == lhs.size();
+}
+
+inline int icompare(string_view lhs, string_view rhs) noexcept
+{
+  const auto size = lhs.size() < rhs.size() ? lhs.size() : rhs.size();
+  const auto index = detail::ascii_imismatch(lhs.data(), rhs.data(), size);
+  if (index != size) {
+    return static_cast<unsigned char>(detail::ascii_to_lower(lhs[index]))
+            < static_cast<unsigned char>(detail::ascii_to_lower(rhs[index]))
+        ? -1
+        : 1;
+  }
+  return lhs.size() == rhs.size() ? 0 : lhs.size() < rhs.size() ? -1 : 1;
+}
+
+inline bool istarts_with(string_view sv, string_view prefix) noexcept
+{
+  return sv.size() >= prefix.size()
+      && detail::ascii_imismatch(sv.data(), prefix.data(), prefix.size())
+      == prefix.size();
+}
+
+inline string_view::size_type ifind(string_view sv,
+                                    string_view needle,
+                                    string_view::size_type index = 0) noexcept
+{
+  return detail::ascii_ifind(sv.data(), sv.size(), needle.data(),
+                             needle.size(), index);
+}
+
+class string_view_ihash {
+public:
+  using is_transparent = void;
+
+  constexpr string_view_ihash() noexcept
+      : seed_(0)
+  {
   }
+
+  constexpr explicit string_view_ihash(std::uint64_t seed) noexcept
+      : seed_(seed)
+  {
+  }
+
+  std::size_t operator()(string_view sv) const noexcept
+  {
+    return static_cast<std::size_t>(detail::hash_bytes(
+        sv.data(), sv.size(), seed_, detail::ascii_icase_hash_reader {}));
+  }
+
+private:
+  std::uint64_t seed_;
 };
-template <>
-struct hash<gul::u32string_view> {
-  std::size_t operator()(gul::u32string_view sv) const
+
+struct string_view_iequal_to {
+  using is_transparent = void;
+
+  bool operator()(string_view lhs, string_view rhs) const noexcept
   {
-#ifdef GUL_HAS_CXX17
-    return hash<u32string_view>()(u32string_view(sv.data(), sv.size()));
-#else
-    return hash<u32string>()(static_cast<u32string>(sv));
-#endif
+    return iequals(lhs, rhs);
   }
 };
-#if defined(GUL_HAS_CXX20) || defined(__cpp_char8_t)
-template <>
-struct hash<gul::u8string_view> {
-  std::size_t operator()(gul::u8string_view sv) const
+
+GUL_NAMESPACE_END
+
+namespace std {
+// Only for the default traits: the raw characters are hashed, which is not
+// consistent with the comparison of other traits, e.g. case-insensitive ones.
+template <class CharT>
+struct hash<gul::basic_string_view<CharT, std::char_traits<CharT>>> {
+  std::size_t operator()(
+      gul::basic_string_view<CharT, std::char_traits<CharT>> sv) const noexcept
   {
-    return hash<u8string_view>()(u8string_view(sv.data(), sv.size()));
+    return gul::basic_string_view_hash<CharT>()(sv);
   }
 };
-#endif
 }
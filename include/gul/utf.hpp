@@ -0,0 +1,157 @@
+//
+// Copyright (c) 2022 Ramirisu (labyrinth dot ramirisu at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#pragma once
+
+#include <gul/config.hpp>
+
+#include <gul/detail/utf.hpp>
+
+#include <gul/expected.hpp>
+#include <gul/span.hpp>
+#include <gul/string_view.hpp>
+
+#include <system_error>
+
+GUL_NAMESPACE_BEGIN
+
+namespace detail {
+
+inline expected<std::size_t, std::errc> make_utf_result(std::errc ec,
+                                                        std::size_t written)
+{
+  if (ec != std::errc()) {
+    return unexpected<std::errc>(ec);
+  }
+  return written;
+}
+
+inline const unsigned char* utf8_bytes(const char* p) noexcept
+{
+  return reinterpret_cast<const unsigned char*>(p);
+}
+
+}
+
+inline bool validate_utf8(string_view str) noexcept
+{
+  return detail::utf8_validate(detail::utf8_bytes(str.data()), str.size());
+}
+
+inline bool validate_utf16(u16string_view str) noexcept
+{
+  return detail::utf16_validate(str.data(), str.size());
+}
+
+inline bool validate_utf32(u32string_view str) noexcept
+{
+  return detail::utf32_validate(str.data(), str.size());
+}
+
+inline auto utf8_to_utf16(string_view str, span<char16_t> buffer) noexcept
+    -> expected<std::size_t, std::errc>
+{
+  std::size_t written = 0;
+  const auto ec
+      = detail::utf8_to_utf16(detail::utf8_bytes(str.data()), str.size(),
+                              buffer.data(), buffer.size(), written);
+  return detail::make_utf_result(ec, written);
+}
+
+inline auto utf8_to_utf32(string_view str, span<char32_t> buffer) noexcept
+    -> expected<std::size_t, std::errc>
+{
+  std::size_t written = 0;
+  const auto ec
+      = detail::utf8_to_utf32(detail::utf8_bytes(str.data()), str.size(),
+                              buffer.data(), buffer.size(), written);
+  return detail::make_utf_result(ec, written);
+}
+
+inline auto utf16_to_utf8(u16string_view str, span<char> buffer) noexcept
+    -> expected<std::size_t, std::errc>
+{
+  std::size_t written = 0;
+  const auto ec = detail::utf16_to_utf8(str.data(), str.size(), buffer.data(),
+                                        buffer.size(), written);
+  return detail::make_utf_result(ec, written);
+}
+
+inline auto utf16_to_utf32(u16string_view str, span<char32_t> buffer) noexcept
+    -> expected<std::size_t, std::errc>
+{
+  std::size_t written = 0;
+  const auto ec = detail::utf16_to_utf32(str.data(), str.size(), buffer.data(),
+                                         buffer.size(), written);
+  return detail::make_utf_result(ec, written);
+}
+
+inline auto utf32_to_utf8(u32string_view str, span<char> buffer) noexcept
+    -> expected<std::size_t, std::errc>
+{
+  std::size_t written = 0;
+  const auto ec = detail::utf32_to_utf8(str.data(), str.size(), buffer.data(),
+                                        buffer.size(), written);
+  return detail::make_utf_result(ec, written);
+}
+
+inline auto utf32_to_utf16(u32string_view str, span<char16_t> buffer) noexcept
+    -> expected<std::size_t, std::errc>
+{
+  std::size_t written = 0;
+  const auto ec = detail::utf32_to_utf16(str.data(), str.size(), buffer.data(),
+                                         buffer.size(), written);
+  return detail::make_utf_result(ec, written);
+}
+
+#if defined(GUL_HAS_CXX20) || defined(__cpp_char8_t)
+inline bool validate_utf8(u8string_view str) noexcept
+{
+  return detail::utf8_validate(
+      reinterpret_cast<const unsigned char*>(str.data()), str.size());
+}
+
+inline auto utf8_to_utf16(u8string_view str, span<char16_t> buffer) noexcept
+    -> expected<std::size_t, std::errc>
+{
+  std::size_t written = 0;
+  const auto ec = detail::utf8_to_utf16(
+      reinterpret_cast<const unsigned char*>(str.data()), str.size(),
+      buffer.data(), buffer.size(), written);
+  return detail::make_utf_result(ec, written);
+}
+
+inline auto utf8_to_utf32(u8string_view str, span<char32_t> buffer) noexcept
+    -> expected<std::size_t, std::errc>
+{
+  std::size_t written = 0;
+  const auto ec = detail::utf8_to_utf32(
+      reinterpret_cast<const unsigned char*>(str.data()), str.size(),
+      buffer.data(), buffer.size(), written);
+  return detail::make_utf_result(ec, written);
+}
+
+inline auto utf16_to_utf8(u16string_view str, span<char8_t> buffer) noexcept
+    -> expected<std::size_t, std::errc>
+{
+  std::size_t written = 0;
+  const auto ec = detail::utf16_to_utf8(str.data(), str.size(), buffer.data(),
+                                        buffer.size(), written);
+  return detail::make_utf_result(ec, written);
+}
+
+inline auto utf32_to_utf8(u32string_view str, span<char8_t> buffer) noexcept
+    -> expected<std::size_t, std::errc>
+{
+  std::size_t written = 0;
+  const auto ec = detail::utf32_to_utf8(str.data(), str.size(), buffer.data(),
+                                        buffer.size(), written);
+  return detail::make_utf_result(ec, written);
+}
+#endif
+
+GUL_NAMESPACE_END
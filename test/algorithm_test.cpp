@@ -0,0 +1,228 @@
+//
+// Copyright (c) 2022 Ramirisu (labyrinth dot ramirisu at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <gul_test.h>
+
+#include <gul/algorithm.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <utility>
+#include <vector>
+
+using namespace gul;
+
+namespace {
+
+const std::size_t sizes[] = { 0,  1,  2,  3,  4,   5,    7,   8,  9,
+                              15, 16, 17, 31, 33, 100, 1000, 4099 };
+
+// Two chunks of 64 bytes at most, so that every parallel call is split.
+const parallel_policy small_chunks(4, 64);
+
+template <typename T>
+std::vector<T> random_values(std::size_t size, int lo, int hi)
+{
+  // Integer-valued, so floating-point sums are exact in any order.
+  std::mt19937 gen(static_cast<std::mt19937::result_type>(size));
+  std::uniform_int_distribution<int> dist(lo, hi);
+  std::vector<T> values(size);
+  for (auto& value : values) {
+    value = static_cast<T>(dist(gen));
+  }
+  return values;
+}
+
+template <typename T>
+void test_reduce()
+{
+  for (auto size : sizes) {
+    const auto values = random_values<T>(size, -100, 100);
+    T expected = 5;
+    for (auto value : values) {
+      expected += value;
+    }
+    const auto s = span<const T>(values.data(), values.size());
+    CHECK_EQ(reduce(s, T(5)), expected);
+    CHECK_EQ(reduce(small_chunks, s, T(5)), expected);
+    CHECK_EQ(reduce(s, T(5), [](T x, T y) { return x + y; }), expected);
+    CHECK_EQ(reduce(small_chunks, s, T(5), [](T x, T y) { return x + y; }),
+             expected);
+  }
+}
+
+template <typename T>
+void test_dot()
+{
+  for (auto size : sizes) {
+    const auto a = random_values<T>(size, -20, 20);
+    const auto b = random_values<T>(size + 1, -20, 20);
+    T expected = 1;
+    for (std::size_t i = 0; i < size; ++i) {
+      expected += a[i] * b[i];
+    }
+    const auto sa = span<const T>(a.data(), size);
+    const auto sb = span<const T>(b.data(), size);
+    CHECK_EQ(dot(sa, sb, T(1)), expected);
+    CHECK_EQ(dot(small_chunks, sa, sb, T(1)), expected);
+  }
+}
+
+template <typename T>
+void test_minmax()
+{
+  for (auto size : sizes) {
+    if (size < 2) {
+      continue;
+    }
+    for (std::size_t pos = 0; pos < size / 2; pos += size / 8 + 1) {
+      auto values = random_values<T>(size, 10, 100);
+      values[pos] = T(1);
+      values[size - 1 - pos] = T(1000);
+      const auto s = span<const T>(values.data(), values.size());
+      const auto result = minmax(s);
+      CHECK_EQ(result.first, T(1));
+      CHECK_EQ(result.second, T(1000));
+      CHECK_EQ(minmax(small_chunks, s), result);
+    }
+  }
+}
+
+template <typename T>
+void test_count_find()
+{
+  for (auto size : sizes) {
+    const auto values = random_values<T>(size, 0, 3);
+    const auto s = span<const T>(values.data(), values.size());
+    for (int v = 0; v < 5; ++v) {
+      const T value = static_cast<T>(v);
+      std::size_t expected = 0;
+      std::size_t first = size;
+      for (std::size_t i = 0; i < size; ++i) {
+        if (values[i] == value) {
+          first = first == size ? i : first;
+          ++expected;
+        }
+      }
+      CHECK_EQ(count(s, value), expected);
+      CHECK_EQ(count(small_chunks, s, value), expected);
+      CHECK_EQ(static_cast<std::size_t>(find(s, value) - s.begin()), first);
+    }
+  }
+}
+
+template <typename T>
+void test_prefix_sum()
+{
+  for (auto size : sizes) {
+    auto values = random_values<T>(size, -100, 100);
+    std::vector<T> expected(size);
+    T acc = 0;
+    for (std::size_t i = 0; i < size; ++i) {
+      acc += values[i];
+      expected[i] = acc;
+    }
+    std::vector<T> out(size + 1, T(7));
+    const auto in = span<const T>(values.data(), values.size());
+    const auto result = prefix_sum(in, span<T>(out.data(), out.size()));
+    CHECK_EQ(result.data(), out.data());
+    CHECK_EQ(result.size(), size);
+    CHECK(std::equal(expected.begin(), expected.end(), out.begin()));
+    CHECK_EQ(out.back(), T(7));
+    const auto inout = span<T>(values.data(), values.size());
+    prefix_sum(inout, inout);
+    CHECK(values == expected);
+  }
+}
+
+}
+
+TEST_SUITE_BEGIN("algorithm");
+
+TEST_CASE("reduce")
+{
+  test_reduce<int>();
+  test_reduce<std::int64_t>();
+  test_reduce<float>();
+  test_reduce<double>();
+  {
+    const int values[] = { 1, 2, 3 };
+    CHECK_EQ(reduce(span<const int>(values), 0.5), 6.5);
+    CHECK_EQ(reduce(span<const int>(values), 1,
+                    [](int x, int y) { return x * y; }),
+             6);
+    CHECK_EQ(reduce(par, span<const int>(values), 0), 6);
+  }
+}
+
+TEST_CASE("transform")
+{
+  for (auto size : sizes) {
+    const auto values = random_values<int>(size, -100, 100);
+    std::vector<double> out1(size + 1);
+    std::vector<double> out2(size + 1);
+    const auto in = span<const int>(values.data(), values.size());
+    const auto f = [](int x) { return x * 0.5; };
+    const auto r1 = transform(in, span<double>(out1.data(), out1.size()), f);
+    const auto r2 = transform(small_chunks, in,
+                              span<double>(out2.data(), out2.size()), f);
+    CHECK_EQ(r1.size(), size);
+    CHECK_EQ(r2.size(), size);
+    for (std::size_t i = 0; i < size; ++i) {
+      CHECK_EQ(out1[i], values[i] * 0.5);
+    }
+    CHECK(out1 == out2);
+  }
+}
+
+TEST_CASE("count and find")
+{
+  test_count_find<char>();
+  test_count_find<std::uint8_t>();
+  test_count_find<std::int16_t>();
+  test_count_find<std::uint32_t>();
+  test_count_find<std::int64_t>();
+  test_count_find<float>();
+  {
+    const int values[] = { 1, 2, 3, 2 };
+    const auto s = span<const int>(values);
+    CHECK_EQ(count(s, 2L), 2);
+    CHECK_EQ(find(s, 2L), s.begin() + 1);
+    CHECK_EQ(find(s, 5), s.end());
+  }
+}
+
+TEST_CASE("minmax")
+{
+  test_minmax<int>();
+  test_minmax<std::int64_t>();
+  test_minmax<std::uint16_t>();
+  test_minmax<float>();
+  test_minmax<double>();
+  {
+    const int values[] = { 3 };
+    CHECK_EQ(minmax(span<const int>(values)), std::make_pair(3, 3));
+  }
+}
+
+TEST_CASE("dot")
+{
+  test_dot<int>();
+  test_dot<float>();
+  test_dot<double>();
+}
+
+TEST_CASE("prefix_sum")
+{
+  test_prefix_sum<int>();
+  test_prefix_sum<std::int64_t>();
+  test_prefix_sum<float>();
+  test_prefix_sum<double>();
+}
+
+TEST_SUITE_END();
@@ -0,0 +1,197 @@
+//
+// Copyright (c) 2022 Ramirisu (labyrinth dot ramirisu at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <gul_test.h>
+
+#include <gul/aligned_span.hpp>
+
+#include <cstdint>
+#include <string>
+#include <utility>
+
+using namespace gul;
+
+namespace {
+
+template <std::size_t Align, typename T>
+bool is_aligned_to(const T* p)
+{
+  return reinterpret_cast<std::uintptr_t>(p) % Align == 0;
+}
+
+}
+
+TEST_SUITE_BEGIN("aligned_span");
+
+TEST_CASE("aligned_span")
+{
+  STATIC_ASSERT(sizeof(aligned_span<float, 32>) == sizeof(span<float>));
+  STATIC_ASSERT(aligned_span<float, 32>::alignment == 32);
+  {
+    const aligned_span<float, 32> s;
+    CHECK(s.empty());
+    CHECK_EQ(s.data(), nullptr);
+    CHECK_EQ(s.size(), 0);
+    CHECK_EQ(s.begin(), s.end());
+  }
+  {
+    alignas(32) float values[16] = {};
+    for (int i = 0; i < 16; ++i) {
+      values[i] = float(i);
+    }
+    const auto s = aligned_span<float, 32>(values, 16);
+    CHECK_EQ(s.data(), values);
+    CHECK_EQ(s.size(), 16);
+    CHECK_EQ(s.size_bytes(), 16 * sizeof(float));
+    CHECK_EQ(s.front(), 0);
+    CHECK_EQ(s.back(), 15);
+    CHECK_EQ(s[3], 3);
+    CHECK_EQ(s.end() - s.begin(), 16);
+
+    const auto from_span = aligned_span<float, 32>(span<float>(values));
+    CHECK_EQ(from_span.data(), values);
+    CHECK_EQ(from_span.size(), 16);
+
+    // Weakening the alignment and adding const are implicit.
+    const aligned_span<const float, 16> weaker = s;
+    CHECK_EQ(weaker.data(), values);
+    const span<const float> plain = s;
+    CHECK_EQ(plain.data(), values);
+    CHECK_EQ(plain.size(), 16);
+    STATIC_ASSERT(
+        std::is_convertible<aligned_span<float, 32>,
+                            aligned_span<const float, 16>>::value);
+    STATIC_ASSERT(
+        !std::is_convertible<aligned_span<float, 16>,
+                             aligned_span<float, 32>>::value);
+    STATIC_ASSERT(
+        !std::is_convertible<aligned_span<const float, 32>,
+                             aligned_span<float, 32>>::value);
+    STATIC_ASSERT(!std::is_convertible<span<float>,
+                                       aligned_span<float, 32>>::value);
+
+    const auto first = s.first(5);
+    STATIC_ASSERT_SAME(decltype(first), const aligned_span<float, 32>);
+    CHECK_EQ(first.data(), values);
+    CHECK_EQ(first.size(), 5);
+
+    const auto last = s.last(5);
+    STATIC_ASSERT_SAME(decltype(last), const span<float>);
+    CHECK_EQ(last.data(), values + 11);
+    CHECK_EQ(last.size(), 5);
+
+    const auto sub8 = s.subspan<8>();
+    STATIC_ASSERT_SAME(decltype(sub8), const aligned_span<float, 32>);
+    CHECK_EQ(sub8.data(), values + 8);
+    CHECK_EQ(sub8.size(), 8);
+
+    const auto sub4 = s.subspan<4, 2>();
+    STATIC_ASSERT_SAME(decltype(sub4), const aligned_span<float, 16>);
+    CHECK_EQ(sub4.data(), values + 4);
+    CHECK_EQ(sub4.size(), 2);
+
+    const auto sub6 = s.subspan<6>();
+    STATIC_ASSERT_SAME(decltype(sub6), const aligned_span<float, 8>);
+    CHECK_EQ(sub6.size(), 10);
+
+    const auto sub1 = s.subspan<1>();
+    STATIC_ASSERT_SAME(decltype(sub1), const aligned_span<float, 4>);
+
+    const auto sub0 = s.subspan<0>();
+    STATIC_ASSERT_SAME(decltype(sub0), const aligned_span<float, 32>);
+    CHECK_EQ(sub0.size(), 16);
+
+    const auto runtime = s.subspan(8, 4);
+    STATIC_ASSERT_SAME(decltype(runtime), const aligned_span<float, 32>);
+    CHECK_EQ(runtime.data(), values + 8);
+    CHECK_EQ(runtime.size(), 4);
+    CHECK_EQ(s.subspan(8).size(), 8);
+
+    float sum = 0;
+    for (auto value : s) {
+      sum += value;
+    }
+    CHECK_EQ(sum, 120);
+  }
+}
+
+TEST_CASE("aligned_buffer")
+{
+  STATIC_ASSERT(aligned_buffer<float, 64>::alignment == 64);
+  {
+    const aligned_buffer<float, 64> buffer;
+    CHECK(buffer.empty());
+    CHECK_EQ(buffer.data(), nullptr);
+    CHECK_EQ(buffer.size(), 0);
+    CHECK_EQ(buffer.padded_size(), 0);
+    CHECK(buffer.view().empty());
+  }
+  {
+    const aligned_buffer<float, 64> buffer(0);
+    CHECK(buffer.empty());
+    CHECK_NE(buffer.data(), nullptr);
+    CHECK(is_aligned_to<64>(buffer.data()));
+    CHECK_EQ(buffer.padded_size(), 16);
+  }
+  for (std::size_t size = 1; size < 40; ++size) {
+    aligned_buffer<float, 32> buffer(size, 1.5f);
+    CHECK(is_aligned_to<32>(buffer.data()));
+    CHECK_EQ(buffer.size(), size);
+    CHECK_EQ(buffer.padded_size() % 8, 0);
+    CHECK_LE(size, buffer.padded_size());
+    CHECK_LT(buffer.padded_size(), size + 8);
+    for (auto value : buffer) {
+      CHECK_EQ(value, 1.5f);
+    }
+    const auto padded = buffer.padded_view();
+    for (std::size_t i = size; i < padded.size(); ++i) {
+      CHECK_EQ(padded[i], 0.0f);
+    }
+    buffer[0] = 3.0f;
+    const aligned_span<float, 32> view = buffer;
+    CHECK_EQ(view.data(), buffer.data());
+    CHECK_EQ(view.size(), size);
+    CHECK_EQ(view[0], 3.0f);
+    const span<float> plain = buffer;
+    CHECK_EQ(plain.size(), size);
+  }
+  {
+    aligned_buffer<double, 64> buffer(3);
+    CHECK(is_aligned_to<64>(buffer.data()));
+    CHECK_EQ(buffer.padded_size(), 8);
+    auto data = buffer.data();
+    aligned_buffer<double, 64> moved(std::move(buffer));
+    CHECK_EQ(moved.data(), data);
+    CHECK_EQ(moved.size(), 3);
+    CHECK_EQ(buffer.data(), nullptr);
+    CHECK_EQ(buffer.size(), 0);
+    aligned_buffer<double, 64> assigned(5);
+    assigned = std::move(moved);
+    CHECK_EQ(assigned.data(), data);
+    CHECK_EQ(assigned.size(), 3);
+    CHECK_EQ(moved.data(), nullptr);
+  }
+  {
+    // 12-byte elements need 8 of them, 3 vectors, to end on a vector.
+    struct rgb {
+      float r, g, b;
+    };
+    const aligned_buffer<rgb, 32> buffer(1);
+    CHECK(is_aligned_to<32>(buffer.data()));
+    CHECK_EQ(buffer.padded_size(), 8);
+    CHECK_EQ(buffer.padded_size() * sizeof(rgb) % 32, 0);
+  }
+  {
+    aligned_buffer<std::string, 64> buffer(3, "aligned buffer");
+    CHECK(is_aligned_to<64>(buffer.data()));
+    CHECK_EQ(buffer.size(), 3);
+    CHECK_EQ(buffer[2], "aligned buffer");
+    CHECK(buffer.padded_view()[buffer.padded_size() - 1].empty());
+  }
+}
+
+TEST_SUITE_END();
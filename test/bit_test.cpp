@@ -0,0 +1,133 @@
+//
+// Copyright (c) 2022 Ramirisu (labyrinth dot ramirisu at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <gul_test.h>
+
+#include <gul/bit.hpp>
+
+#include <cstdint>
+#include <vector>
+
+using namespace gul;
+
+TEST_SUITE_BEGIN("bit");
+
+TEST_CASE("endian")
+{
+  STATIC_ASSERT(endian::native == endian::little
+                || endian::native == endian::big);
+  std::uint32_t x = 1;
+  unsigned char first;
+  std::memcpy(&first, &x, 1);
+  CHECK_EQ(endian::native == endian::little, first == 1);
+}
+
+TEST_CASE("byteswap")
+{
+  CHECK_EQ(byteswap(std::uint8_t(0x12)), 0x12);
+  CHECK_EQ(byteswap(std::uint16_t(0x1234)), 0x3412);
+  CHECK_EQ(byteswap(std::uint32_t(0x12345678)), 0x78563412u);
+  CHECK_EQ(byteswap(std::uint64_t(0x0123456789ABCDEF)),
+           std::uint64_t(0xEFCDAB8967452301));
+  CHECK_EQ(byteswap(std::int16_t(0x00FF)), std::int16_t(-256));
+  CHECK_EQ(byteswap(std::int32_t(-2)), std::int32_t(0xFEFFFFFF));
+  STATIC_ASSERT_SAME(decltype(byteswap(std::int64_t())), std::int64_t);
+}
+
+namespace {
+
+template <typename T>
+void check_bulk_byteswap(std::size_t count)
+{
+  std::vector<T> values(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    values[i] = static_cast<T>(0x0102030405060708ull * (i + 1));
+  }
+  auto expected = values;
+  for (auto& value : expected) {
+    value = byteswap(value);
+  }
+  byteswap(span<T>(values.data(), values.size()));
+  CHECK_EQ(values, expected);
+}
+
+}
+
+TEST_CASE("byteswap span")
+{
+  for (std::size_t count = 0; count < 70; ++count) {
+    check_bulk_byteswap<std::uint8_t>(count);
+    check_bulk_byteswap<std::uint16_t>(count);
+    check_bulk_byteswap<std::int32_t>(count);
+    check_bulk_byteswap<std::uint64_t>(count);
+  }
+  {
+    float values[] = { 1.0f, -2.5f };
+    byteswap(span<float>(values));
+    CHECK_EQ(load_be<float>(as_bytes(span<float>(values))), 1.0f);
+    CHECK_EQ(load_be<float>(as_bytes(span<float>(values)), 4), -2.5f);
+  }
+}
+
+TEST_CASE("load")
+{
+  const unsigned char raw[]
+      = { 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09 };
+  const auto bytes
+      = span<const byte>(reinterpret_cast<const byte*>(raw), sizeof(raw));
+  CHECK_EQ(load_le<std::uint8_t>(bytes), 0x01);
+  CHECK_EQ(load_le<std::uint16_t>(bytes), 0x0201);
+  CHECK_EQ(load_be<std::uint16_t>(bytes), 0x0102);
+  CHECK_EQ(load_le<std::uint32_t>(bytes, 1), 0x05040302u);
+  CHECK_EQ(load_be<std::uint32_t>(bytes, 1), 0x02030405u);
+  CHECK_EQ(load_le<std::uint64_t>(bytes, 1),
+           std::uint64_t(0x0908070605040302));
+  CHECK_EQ(load_be<std::uint64_t>(bytes, 1),
+           std::uint64_t(0x0203040506070809));
+  CHECK_EQ(load_be<std::int16_t>(bytes, 7), std::int16_t(0x0809));
+
+  const auto fixed = span<const byte, 9>(reinterpret_cast<const byte*>(raw), 9);
+  CHECK_EQ(load_be<std::uint16_t>(fixed, 7), 0x0809);
+
+  unsigned char mutable_raw[] = { 0xFF, 0xFE };
+  const auto writable
+      = span<byte>(reinterpret_cast<byte*>(mutable_raw), sizeof(mutable_raw));
+  CHECK_EQ(load_le<std::int16_t>(writable), std::int16_t(-257));
+}
+
+TEST_CASE("store")
+{
+  unsigned char raw[12] = {};
+  const auto bytes = span<byte>(reinterpret_cast<byte*>(raw), sizeof(raw));
+  store_le(bytes, std::uint32_t(0x01020304));
+  CHECK_EQ(raw[0], 0x04);
+  CHECK_EQ(raw[3], 0x01);
+  store_be(bytes, 4, std::uint32_t(0x01020304));
+  CHECK_EQ(raw[4], 0x01);
+  CHECK_EQ(raw[7], 0x04);
+  store_be(bytes, std::uint16_t(0xABCD));
+  CHECK_EQ(raw[0], 0xAB);
+  CHECK_EQ(raw[1], 0xCD);
+  store_le(bytes, 8, std::int32_t(-2));
+  CHECK_EQ(load_le<std::int32_t>(bytes, 8), -2);
+  CHECK_EQ(raw[8], 0xFE);
+  CHECK_EQ(raw[11], 0xFF);
+
+  store_be(bytes, 1, 3.5);
+  CHECK_EQ(load_be<double>(bytes, 1), 3.5);
+  CHECK_EQ(raw[1], 0x40);
+  store_le(bytes, 2, 3.5f);
+  CHECK_EQ(load_le<float>(bytes, 2), 3.5f);
+  CHECK_EQ(raw[5], 0x40);
+
+  enum class color : std::uint16_t { red = 0x0102 };
+  store_be(bytes, color::red);
+  CHECK_EQ(raw[0], 0x01);
+  CHECK(load_be<color>(bytes) == color::red);
+}
+
+TEST_SUITE_END();
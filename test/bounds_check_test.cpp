@@ -0,0 +1,72 @@
+//
+// Copyright (c) 2022 Ramirisu (labyrinth dot ramirisu at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#define GUL_BOUNDS_CHECK GUL_BOUNDS_CHECK_THROW
+
+#include <gul_test.h>
+
+#include <gul/bounds_check.hpp>
+#include <gul/span.hpp>
+#include <gul/strided_span.hpp>
+
+#include <stdexcept>
+
+using namespace gul;
+
+TEST_SUITE_BEGIN("bounds_check");
+
+TEST_CASE("policies")
+{
+  bounds_check_none::check(false);
+  bounds_check_assert::check(true);
+  bounds_check_trap::check(true);
+  bounds_check_throw::check(true);
+  CHECK_THROWS_AS(bounds_check_throw::check(false), std::out_of_range);
+  STATIC_ASSERT(noexcept(bounds_check_none::check(false)));
+  STATIC_ASSERT(noexcept(bounds_check_trap::check(false)));
+  STATIC_ASSERT(!noexcept(bounds_check_throw::check(false)));
+}
+
+TEST_CASE("translation unit default")
+{
+  STATIC_ASSERT(std::is_same<bounds_check_default, bounds_check_throw>::value);
+  STATIC_ASSERT(
+      std::is_same<span<int>,
+                   span<int, dynamic_extent, bounds_check_throw>>::value);
+  STATIC_ASSERT(!noexcept(bounds_check_default::check(false)));
+  CHECK_THROWS_AS(bounds_check_default::check(false), std::out_of_range);
+
+  int arr[] = { 0, 1, 2 };
+  const auto s = span<int>(arr, 3);
+  CHECK_EQ(s[2], 2);
+  CHECK_THROWS_AS(s[3], std::out_of_range);
+  CHECK_THROWS_AS(s.subspan(4), std::out_of_range);
+  CHECK_THROWS_AS(span<int>().front(), std::out_of_range);
+}
+
+TEST_CASE("strided_span")
+{
+  STATIC_ASSERT(std::is_same<
+                strided_span<int>,
+                strided_span<int, dynamic_stride, bounds_check_throw>>::value);
+
+  int arr[] = { 0, 1, 2, 3, 4, 5 };
+  const strided_span<int> s(arr, 3, 2 * sizeof(int));
+  CHECK_EQ(s[2], 4);
+  CHECK_THROWS_AS(s[3], std::out_of_range);
+  CHECK_THROWS_AS(s.first(4), std::out_of_range);
+  CHECK_THROWS_AS(s.subspan(1, 3), std::out_of_range);
+  CHECK_THROWS_AS(strided_span<int>().back(), std::out_of_range);
+
+  const strided_span<int, sizeof(int), bounds_check_none> t
+      = span<int, 6, bounds_check_none>(arr);
+  CHECK_EQ(t[5], 5);
+  const strided_span<const int> u = t;
+  CHECK_THROWS_AS(u[6], std::out_of_range);
+}
+
+TEST_SUITE_END();
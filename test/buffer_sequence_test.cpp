@@ -0,0 +1,154 @@
+//
+// Copyright (c) 2022 Ramirisu (labyrinth dot ramirisu at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <gul_test.h>
+
+#include <gul/buffer_sequence.hpp>
+
+#include <string>
+
+#ifdef GUL_HAS_IOVEC
+#include <unistd.h>
+#endif
+
+using namespace gul;
+
+TEST_SUITE_BEGIN("buffer_sequence");
+
+TEST_CASE("basic")
+{
+  buffer_sequence seq;
+  CHECK(seq.empty());
+  CHECK_EQ(seq.size_bytes(), 0);
+  CHECK(seq.iovecs().empty());
+
+  const byte header[] = { byte(1), byte(2) };
+  seq.reserve(3);
+  seq.push_back(header);
+  seq.push_back(string_view(""));
+  seq.push_back(string_view("abc"));
+  CHECK_EQ(seq.size(), 2);
+  CHECK_EQ(seq.size_bytes(), 5);
+  CHECK_EQ(seq[0].data(), header);
+  CHECK_EQ(seq[0].size(), 2);
+  CHECK_EQ(seq[1].size(), 3);
+
+  const auto iovecs = seq.iovecs();
+  REQUIRE(iovecs.size() == 2);
+  CHECK_EQ(iovecs[0].iov_base, static_cast<const void*>(header));
+  CHECK_EQ(iovecs[0].iov_len, 2);
+  CHECK_EQ(iovecs[1].iov_len, 3);
+
+  seq.clear();
+  CHECK(seq.empty());
+  CHECK_EQ(seq.size_bytes(), 0);
+}
+
+TEST_CASE("consume")
+{
+  const string_view parts[] = { "ab", "cde", "f" };
+  buffer_sequence seq;
+  for (auto part : parts) {
+    seq.push_back(part);
+  }
+  seq.consume(0);
+  CHECK_EQ(seq.size(), 3);
+
+  // Partially into the first buffer.
+  seq.consume(1);
+  CHECK_EQ(seq.size(), 3);
+  CHECK_EQ(seq.size_bytes(), 5);
+  CHECK_EQ(seq[0].size(), 1);
+  CHECK_EQ(static_cast<const char*>(seq.iovecs()[0].iov_base),
+           parts[0].data() + 1);
+
+  // Across the end of one buffer into the next.
+  seq.consume(2);
+  CHECK_EQ(seq.size(), 2);
+  CHECK_EQ(seq.size_bytes(), 3);
+  CHECK_EQ(seq[0].size(), 2);
+
+  char out[8] = {};
+  CHECK_EQ(seq.copy_to(as_writable_bytes(span<char>(out))), 3);
+  CHECK_EQ(string_view(out, 3), "def");
+  CHECK_EQ(seq.copy_to(as_writable_bytes(span<char>(out, 2))), 2);
+
+  // Exactly up to the end of a buffer.
+  seq.consume(2);
+  CHECK_EQ(seq.size(), 1);
+  CHECK_EQ(seq[0].size(), 1);
+
+  seq.consume(1);
+  CHECK(seq.empty());
+  CHECK_EQ(seq.size_bytes(), 0);
+  seq.push_back(string_view("g"));
+  CHECK_EQ(seq.size(), 1);
+
+  // Past the end.
+  seq.push_back(string_view("hi"));
+  seq.consume(10);
+  CHECK(seq.empty());
+  CHECK_EQ(seq.size_bytes(), 0);
+}
+
+TEST_CASE("consume while appending")
+{
+  // The sequence never drains, so consumed entries have to be dropped while
+  // others remain.
+  buffer_sequence seq;
+  seq.push_back(string_view("a"));
+  for (int i = 0; i < 1000; ++i) {
+    seq.push_back(string_view("bc"));
+    seq.consume(2);
+    REQUIRE(seq.size() == 1);
+    REQUIRE(seq.size_bytes() == 1);
+    char out = 0;
+    REQUIRE(seq.copy_to(as_writable_bytes(span<char>(&out, 1))) == 1);
+    REQUIRE(out == 'c');
+  }
+}
+
+#ifdef GUL_HAS_IOVEC
+TEST_CASE("writev and readv")
+{
+  int fds[2];
+  REQUIRE(::pipe(fds) == 0);
+
+  const std::string body(100, 'x');
+  buffer_sequence out;
+  out.push_back(string_view("head:"));
+  out.push_back(string_view(body.data(), body.size()));
+  out.push_back(string_view(":tail"));
+  const std::size_t total = out.size_bytes();
+  while (!out.empty()) {
+    // Hands the buffers over in small pieces to exercise partial writes.
+    const auto iovecs = out.iovecs().first(out.size() < 2 ? out.size() : 2);
+    const auto written = ::writev(fds[1], iovecs.data(), int(iovecs.size()));
+    REQUIRE(written > 0);
+    out.consume(std::size_t(written));
+  }
+
+  char head[5];
+  std::string received(total - sizeof(head), '\0');
+  mutable_buffer_sequence in;
+  in.push_back(as_writable_bytes(span<char>(head)));
+  in.push_back(as_writable_bytes(span<char>(&received[0], received.size())));
+  while (!in.empty()) {
+    const auto iovecs = in.iovecs();
+    const auto count = ::readv(fds[0], iovecs.data(), int(iovecs.size()));
+    REQUIRE(count > 0);
+    in.consume(std::size_t(count));
+  }
+  CHECK_EQ(string_view(head, sizeof(head)), "head:");
+  CHECK_EQ(received, body + ":tail");
+
+  ::close(fds[0]);
+  ::close(fds[1]);
+}
+#endif
+
+TEST_SUITE_END();
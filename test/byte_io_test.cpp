@@ -0,0 +1,238 @@
+//
+// Copyright (c) 2022 Ramirisu (labyrinth dot ramirisu at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <gul_test.h>
+
+#include <gul/byte_io.hpp>
+
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+using namespace gul;
+
+namespace {
+
+span<const byte> as_span(const std::vector<unsigned char>& bytes)
+{
+  return span<const byte>(reinterpret_cast<const byte*>(bytes.data()),
+                          bytes.size());
+}
+
+std::vector<unsigned char> encode_varint(std::uint64_t value)
+{
+  std::vector<unsigned char> buffer(10);
+  byte_writer writer(
+      span<byte>(reinterpret_cast<byte*>(buffer.data()), buffer.size()));
+  CHECK(writer.write_varint(value));
+  buffer.resize(writer.position());
+  return buffer;
+}
+
+std::vector<unsigned char> encode_signed_varint(std::int64_t value)
+{
+  std::vector<unsigned char> buffer(10);
+  byte_writer writer(
+      span<byte>(reinterpret_cast<byte*>(buffer.data()), buffer.size()));
+  CHECK(writer.write_signed_varint(value));
+  buffer.resize(writer.position());
+  return buffer;
+}
+
+}
+
+TEST_SUITE_BEGIN("byte_io");
+
+TEST_CASE("byte_reader fixed width")
+{
+  const std::vector<unsigned char> bytes = { 0x01, 0x02, 0x03, 0x04, 0x05,
+                                             0x06, 0x07, 0x08, 0x09 };
+  byte_reader reader(as_span(bytes));
+  CHECK_EQ(reader.remaining(), 9);
+  CHECK_EQ(reader.read_le<std::uint16_t>(), 0x0201);
+  CHECK_EQ(reader.read_be<std::uint32_t>(), 0x03040506u);
+  CHECK_EQ(reader.position(), 6);
+  CHECK_EQ(reader.read_le<std::uint32_t>(),
+           unexpected<std::errc>(std::errc::result_out_of_range));
+  CHECK_EQ(reader.position(), 6);
+  CHECK_EQ(reader.read_le<std::uint8_t>(), 0x07);
+  CHECK_EQ(reader.remaining_bytes().size(), 2);
+  CHECK(reader.skip(1));
+  CHECK_EQ(reader.skip(2),
+           unexpected<std::errc>(std::errc::result_out_of_range));
+  CHECK_EQ(reader.read_be<std::int8_t>(), 0x09);
+  CHECK(reader.empty());
+  CHECK_FALSE(reader.read_le<std::uint8_t>());
+
+  byte_reader none;
+  CHECK(none.empty());
+  CHECK_FALSE(none.read_varint());
+  CHECK_FALSE(none.read_signed_varint());
+  CHECK(none.read_bytes(0));
+}
+
+TEST_CASE("byte_reader bytes and strings")
+{
+  const std::vector<unsigned char> bytes = { 0x03, 'a', 'b', 'c', 0x05, 'x' };
+  byte_reader reader(as_span(bytes));
+  CHECK_EQ(reader.read_string(), string_view("abc"));
+  CHECK_EQ(reader.read_string(),
+           unexpected<std::errc>(std::errc::result_out_of_range));
+  CHECK_EQ(reader.position(), 4);
+  const auto rest = reader.read_bytes(2);
+  REQUIRE(rest);
+  CHECK_EQ(rest->data(), reinterpret_cast<const byte*>(bytes.data() + 4));
+  CHECK_EQ(rest->size(), 2);
+  CHECK_EQ(reader.read_bytes(1),
+           unexpected<std::errc>(std::errc::result_out_of_range));
+}
+
+TEST_CASE("varint encoding")
+{
+  using bytes = std::vector<unsigned char>;
+  CHECK_EQ(encode_varint(0), bytes { 0x00 });
+  CHECK_EQ(encode_varint(1), bytes { 0x01 });
+  CHECK_EQ(encode_varint(127), bytes { 0x7F });
+  CHECK_EQ(encode_varint(128), bytes { 0x80, 0x01 });
+  CHECK_EQ(encode_varint(300), bytes { 0xAC, 0x02 });
+  CHECK_EQ(encode_varint(624485), bytes { 0xE5, 0x8E, 0x26 });
+  CHECK_EQ(encode_varint(std::numeric_limits<std::uint64_t>::max()),
+           bytes { 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+                   0x01 });
+  CHECK_EQ(encode_signed_varint(0), bytes { 0x00 });
+  CHECK_EQ(encode_signed_varint(63), bytes { 0x3F });
+  CHECK_EQ(encode_signed_varint(64), bytes { 0xC0, 0x00 });
+  CHECK_EQ(encode_signed_varint(-1), bytes { 0x7F });
+  CHECK_EQ(encode_signed_varint(-64), bytes { 0x40 });
+  CHECK_EQ(encode_signed_varint(-65), bytes { 0xBF, 0x7F });
+  CHECK_EQ(encode_signed_varint(-123456), bytes { 0xC0, 0xBB, 0x78 });
+  CHECK_EQ(encode_signed_varint(std::numeric_limits<std::int64_t>::min()),
+           bytes { 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+                   0x7F });
+  CHECK_EQ(encode_signed_varint(std::numeric_limits<std::int64_t>::max()),
+           bytes { 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+                   0x00 });
+}
+
+TEST_CASE("varint round trip")
+{
+  std::mt19937_64 gen(42);
+  for (int i = 0; i < 20000; ++i) {
+    const auto bits = gen() % 65;
+    const auto value = bits == 64 ? gen() : gen() & ((1ull << bits) - 1);
+    const auto encoded = encode_varint(value);
+    // Exercises both the 8-byte fast path and the bytewise tail.
+    auto padded_buffer = encoded;
+    padded_buffer.resize(encoded.size() + 8, 0xAA);
+    const auto& padded = padded_buffer;
+    for (const auto* buffer : { &encoded, &padded }) {
+      byte_reader reader(as_span(*buffer));
+      CHECK_EQ(reader.read_varint(), value);
+      CHECK_EQ(reader.position(), encoded.size());
+    }
+
+    const auto signed_value = static_cast<std::int64_t>(value) >> (gen() % 64);
+    const auto signed_encoded = encode_signed_varint(signed_value);
+    byte_reader reader(as_span(signed_encoded));
+    CHECK_EQ(reader.read_signed_varint(), signed_value);
+    CHECK(reader.empty());
+  }
+}
+
+TEST_CASE("varint errors")
+{
+  using bytes = std::vector<unsigned char>;
+  for (const auto& input : { bytes { 0x80 }, bytes { 0xFF, 0xFF },
+                             bytes { 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+                                     0x80, 0x80 } }) {
+    byte_reader reader(as_span(input));
+    CHECK_EQ(reader.read_varint(),
+             unexpected<std::errc>(std::errc::result_out_of_range));
+    CHECK_EQ(reader.position(), 0);
+    CHECK_EQ(reader.read_signed_varint(),
+             unexpected<std::errc>(std::errc::result_out_of_range));
+  }
+  {
+    const bytes input = { 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+                          0xFF, 0xFF, 0xFF, 0xFF, 0x02 };
+    byte_reader reader(as_span(input));
+    CHECK_EQ(reader.read_varint(),
+             unexpected<std::errc>(std::errc::illegal_byte_sequence));
+    CHECK_EQ(reader.position(), 0);
+  }
+  {
+    const bytes input(11, 0x80);
+    byte_reader reader(as_span(input));
+    CHECK_EQ(reader.read_varint(),
+             unexpected<std::errc>(std::errc::illegal_byte_sequence));
+    CHECK_EQ(reader.read_signed_varint(),
+             unexpected<std::errc>(std::errc::illegal_byte_sequence));
+  }
+  {
+    const bytes input = { 0x80, 0x80, 0x80, 0x80, 0x80,
+                          0x80, 0x80, 0x80, 0x80, 0x01 };
+    byte_reader reader(as_span(input));
+    CHECK_EQ(reader.read_signed_varint(),
+             unexpected<std::errc>(std::errc::illegal_byte_sequence));
+  }
+  {
+    // Overlong but valid encodings are accepted.
+    const bytes input = { 0x81, 0x80, 0x80, 0x00 };
+    byte_reader reader(as_span(input));
+    CHECK_EQ(reader.read_varint(), 1u);
+  }
+}
+
+TEST_CASE("byte_writer")
+{
+  std::vector<unsigned char> buffer(16);
+  byte_writer writer(
+      span<byte>(reinterpret_cast<byte*>(buffer.data()), buffer.size()));
+  CHECK_EQ(writer.remaining(), 16);
+  CHECK(writer.write_le(std::uint16_t(0x0102)));
+  CHECK(writer.write_be(std::uint32_t(0x03040506)));
+  CHECK(writer.write_varint(300));
+  CHECK(writer.write_signed_varint(-1));
+  CHECK(writer.write_string("hi"));
+  const unsigned char raw[] = { 0xEE, 0xFF };
+  CHECK(writer.write_bytes(
+      span<const byte>(reinterpret_cast<const byte*>(raw), 2)));
+  CHECK_EQ(writer.position(), 14);
+  CHECK_EQ(writer.written().size(), 14);
+  CHECK_EQ(writer.written().data(), reinterpret_cast<byte*>(buffer.data()));
+
+  const std::vector<unsigned char> expected_bytes
+      = { 0x02, 0x01, 0x03, 0x04, 0x05, 0x06, 0xAC,
+          0x02, 0x7F, 0x02, 'h',  'i',  0xEE, 0xFF };
+  CHECK(std::equal(expected_bytes.begin(), expected_bytes.end(),
+                   buffer.begin()));
+
+  const auto full = unexpected<std::errc>(std::errc::no_buffer_space);
+  CHECK_EQ(writer.write_be(std::uint32_t(0)), full);
+  CHECK_EQ(writer.write_string("ab"), full);
+  CHECK_EQ(writer.write_varint(1ull << 14), full);
+  CHECK_EQ(writer.write_signed_varint(-8193), full);
+  CHECK_EQ(writer.position(), 14);
+  CHECK(writer.write_signed_varint(-64));
+  CHECK(writer.write_le(std::uint8_t(1)));
+  CHECK_EQ(writer.remaining(), 0);
+  CHECK_EQ(writer.write_bytes(span<const byte>()), expected<void, std::errc>());
+
+  byte_reader reader(as_span(buffer));
+  CHECK_EQ(reader.read_le<std::uint16_t>(), 0x0102);
+  CHECK_EQ(reader.read_be<std::uint32_t>(), 0x03040506u);
+  CHECK_EQ(reader.read_varint(), 300u);
+  CHECK_EQ(reader.read_signed_varint(), -1);
+  CHECK_EQ(reader.read_string(), string_view("hi"));
+  CHECK(reader.skip(2));
+  CHECK_EQ(reader.read_signed_varint(), -64);
+  CHECK_EQ(reader.read_le<std::uint8_t>(), 1);
+  CHECK(reader.empty());
+}
+
+TEST_SUITE_END();
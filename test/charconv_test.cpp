@@ -0,0 +1,464 @@
+//
+// Copyright (c) 2022 Ramirisu (labyrinth dot ramirisu at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <gul_test.h>
+
+#include <gul/charconv.hpp>
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+
+using namespace gul;
+
+TEST_SUITE_BEGIN("charconv");
+
+TEST_CASE("from_chars integer")
+{
+  {
+    auto r = from_chars<int>("12345");
+    CHECK(r.has_value());
+    CHECK_EQ(r->value, 12345);
+    CHECK_EQ(r->size, 5);
+  }
+  {
+    auto r = from_chars<int>("-2147483648xyz");
+    CHECK(r.has_value());
+    CHECK_EQ(r->value, std::numeric_limits<int>::min());
+    CHECK_EQ(r->size, 11);
+  }
+  {
+    auto r = from_chars<int>("2147483648");
+    CHECK(!r.has_value());
+    CHECK_EQ(r.error(), std::errc::result_out_of_range);
+  }
+  {
+    auto r = from_chars<int>("+1");
+    CHECK(!r.has_value());
+    CHECK_EQ(r.error(), std::errc::invalid_argument);
+  }
+  {
+    auto r = from_chars<unsigned>("-1");
+    CHECK(!r.has_value());
+    CHECK_EQ(r.error(), std::errc::invalid_argument);
+  }
+  {
+    auto r = from_chars<int>("");
+    CHECK(!r.has_value());
+    CHECK_EQ(r.error(), std::errc::invalid_argument);
+  }
+  {
+    auto r = from_chars<std::uint64_t>("18446744073709551615");
+    CHECK(r.has_value());
+    CHECK_EQ(r->value, std::numeric_limits<std::uint64_t>::max());
+    CHECK_EQ(r->size, 20);
+  }
+  {
+    auto r = from_chars<std::uint64_t>("18446744073709551616");
+    CHECK(!r.has_value());
+    CHECK_EQ(r.error(), std::errc::result_out_of_range);
+  }
+  {
+    auto r = from_chars<std::int64_t>("-9223372036854775808");
+    CHECK(r.has_value());
+    CHECK_EQ(r->value, std::numeric_limits<std::int64_t>::min());
+  }
+  {
+    auto r = from_chars<std::uint8_t>("255");
+    CHECK(r.has_value());
+    CHECK_EQ(r->value, 255);
+    CHECK(!from_chars<std::uint8_t>("256").has_value());
+    CHECK(!from_chars<std::int8_t>("-129").has_value());
+    CHECK_EQ(from_chars<std::int8_t>("-128")->value, -128);
+  }
+  {
+    auto r = from_chars<unsigned>("00000000000000000000000000042");
+    CHECK(r.has_value());
+    CHECK_EQ(r->value, 42u);
+    CHECK_EQ(r->size, 29);
+  }
+  {
+    CHECK_EQ(from_chars<int>("ff", 16)->value, 255);
+    CHECK_EQ(from_chars<int>("FF", 16)->value, 255);
+    CHECK_EQ(from_chars<int>("-101", 2)->value, -5);
+    CHECK_EQ(from_chars<int>("zz", 36)->value, 35 * 36 + 35);
+    CHECK_EQ(from_chars<int>("19", 8)->value, 1);
+    CHECK_EQ(from_chars<int>("19", 8)->size, 1);
+    CHECK_EQ(from_chars<std::uint64_t>(
+                 "1111111111111111111111111111111111111111111111111111111111111"
+                 "111",
+                 2)
+                 ->value,
+             std::numeric_limits<std::uint64_t>::max());
+    CHECK(!from_chars<std::uint64_t>(
+               "1111111111111111111111111111111111111111111111111111111111111"
+               "1111",
+               2)
+               .has_value());
+  }
+  {
+    const char buffer[] = { '1', '2', '3', '4', '5', '6', '7', '8', '9' };
+    auto r = from_chars<long>(span<const char>(buffer, 9));
+    CHECK(r.has_value());
+    CHECK_EQ(r->value, 123456789);
+    CHECK_EQ(r->size, 9);
+  }
+}
+
+TEST_CASE("from_chars integer randomized")
+{
+  std::mt19937_64 rng(42);
+  for (int i = 0; i < 20000; ++i) {
+    const auto value = static_cast<std::int64_t>(rng()) >> (rng() % 64);
+    const auto str = std::to_string(value);
+    auto r = from_chars<std::int64_t>(str);
+    CHECK(r.has_value());
+    CHECK_EQ(r->value, value);
+    CHECK_EQ(r->size, str.size());
+  }
+}
+
+namespace {
+template <typename T>
+T strto(const std::string& str);
+
+template <>
+double strto<double>(const std::string& str)
+{
+  return std::strtod(str.c_str(), nullptr);
+}
+
+template <>
+float strto<float>(const std::string& str)
+{
+  return std::strtof(str.c_str(), nullptr);
+}
+
+template <typename T>
+bool same_bits(T lhs, T rhs)
+{
+  return std::memcmp(&lhs, &rhs, sizeof(T)) == 0;
+}
+
+template <typename T>
+bool parses_like_strto(const std::string& str)
+{
+  auto r = from_chars<T>(str);
+  const T expected = strto<T>(str);
+  if (std::isinf(expected)
+      || (expected == 0
+          && str.find_first_of("123456789") != std::string::npos)) {
+    return !r.has_value() && r.error() == std::errc::result_out_of_range;
+  }
+  return r.has_value() && same_bits(r->value, expected)
+      && r->size == str.size();
+}
+}
+
+TEST_CASE("from_chars floating point")
+{
+  {
+    auto r = from_chars<double>("3.25");
+    CHECK(r.has_value());
+    CHECK_EQ(r->value, 3.25);
+    CHECK_EQ(r->size, 4);
+  }
+  {
+    auto r = from_chars<double>("-0");
+    CHECK(r.has_value());
+    CHECK(std::signbit(r->value));
+    CHECK_EQ(r->value, 0.0);
+  }
+  {
+    auto r = from_chars<double>("1e");
+    CHECK(r.has_value());
+    CHECK_EQ(r->value, 1.0);
+    CHECK_EQ(r->size, 1);
+  }
+  {
+    auto r = from_chars<double>("1e+x");
+    CHECK(r.has_value());
+    CHECK_EQ(r->size, 1);
+  }
+  {
+    auto r = from_chars<double>(".5");
+    CHECK(r.has_value());
+    CHECK_EQ(r->value, 0.5);
+    CHECK_EQ(r->size, 2);
+  }
+  {
+    CHECK_EQ(from_chars<double>(".").error(), std::errc::invalid_argument);
+    CHECK_EQ(from_chars<double>("e5").error(), std::errc::invalid_argument);
+    CHECK_EQ(from_chars<double>("+1").error(), std::errc::invalid_argument);
+    CHECK_EQ(from_chars<double>("").error(), std::errc::invalid_argument);
+  }
+  {
+    auto r = from_chars<double>("-Infinity");
+    CHECK(r.has_value());
+    CHECK(std::isinf(r->value));
+    CHECK(r->value < 0);
+    CHECK_EQ(r->size, 9);
+    CHECK_EQ(from_chars<double>("infinit")->size, 3);
+    CHECK(std::isnan(from_chars<double>("nan")->value));
+    CHECK_EQ(from_chars<double>("NaN(123_abc)")->size, 12);
+    CHECK_EQ(from_chars<double>("nan(123")->size, 3);
+  }
+  {
+    CHECK_EQ(from_chars<double>("1e400").error(),
+             std::errc::result_out_of_range);
+    CHECK_EQ(from_chars<double>("1e-400").error(),
+             std::errc::result_out_of_range);
+    CHECK_EQ(from_chars<float>("1e39").error(),
+             std::errc::result_out_of_range);
+    CHECK_EQ(from_chars<double>("0e999999999")->value, 0.0);
+  }
+  {
+    CHECK_EQ(from_chars<double>("1.5e3", chars_format::fixed)->size, 3);
+    CHECK_EQ(from_chars<double>("1.5", chars_format::scientific).error(),
+             std::errc::invalid_argument);
+    CHECK_EQ(from_chars<double>("1.5e3", chars_format::scientific)->value,
+             1500.0);
+  }
+  {
+    const char* cases[] = {
+      "2.2250738585072011e-308",
+      "2.2250738585072012e-308",
+      "4.9406564584124654e-324",
+      "2.4703282292062327e-324",
+      "2.4703282292062328e-324",
+      "1.7976931348623157e308",
+      "1.7976931348623158e308",
+      "9007199254740993",
+      "9007199254740992.000000000000000000000000000001",
+      "1.00000000000000011102230246251565404236316680908203125",
+      "1.00000000000000011102230246251565404236316680908203124",
+      "1.00000000000000011102230246251565404236316680908203126",
+      "0.1",
+      "0.30000000000000004",
+      "123456789012345678901234567890",
+      "7.2057594037927933e16",
+      "3.14159265358979323846264338327950288419716939937510",
+      "0.000000000000000000000000000000000000000000001",
+      "100000000000000000000000",
+      "1448997445238699",
+    };
+    for (auto c : cases) {
+      CHECK(parses_like_strto<double>(c));
+      CHECK(parses_like_strto<float>(c));
+    }
+  }
+}
+
+TEST_CASE("from_chars floating point randomized")
+{
+  std::mt19937_64 rng(7);
+  char buffer[64];
+  for (int i = 0; i < 20000; ++i) {
+    std::uint64_t bits = rng();
+    double value;
+    std::memcpy(&value, &bits, sizeof(value));
+    if (std::isnan(value) || std::isinf(value)) {
+      continue;
+    }
+    std::snprintf(buffer, sizeof(buffer), "%.17g", value);
+    CHECK(parses_like_strto<double>(buffer));
+    std::snprintf(buffer, sizeof(buffer), "%.*e", int(rng() % 25), value);
+    CHECK(parses_like_strto<double>(buffer));
+    CHECK(parses_like_strto<float>(buffer));
+  }
+  for (int i = 0; i < 20000; ++i) {
+    std::string str = std::to_string(rng() % 100000000000000000ull);
+    str.insert(rng() % (str.size() + 1), ".");
+    str += "e" + std::to_string(int(rng() % 700) - 350);
+    CHECK(parses_like_strto<double>(str));
+    CHECK(parses_like_strto<float>(str));
+  }
+}
+
+namespace {
+template <typename T>
+std::string to_string(T value)
+{
+  char buffer[512];
+  auto r = to_chars(buffer, value);
+  return r ? std::string(buffer, *r) : std::string();
+}
+
+template <typename T>
+std::string to_string(T value, chars_format fmt)
+{
+  char buffer[512];
+  auto r = to_chars(buffer, value, fmt);
+  return r ? std::string(buffer, *r) : std::string();
+}
+
+template <typename T>
+std::string shortest_scientific_by_printf(T value)
+{
+  char buffer[64];
+  for (int precision = 0;; ++precision) {
+    std::snprintf(buffer, sizeof(buffer), "%.*e", precision, double(value));
+    if (strto<T>(buffer) == value) {
+      return buffer;
+    }
+  }
+}
+
+template <typename T>
+std::string integer_by_printf(T value)
+{
+  char buffer[512];
+  std::snprintf(buffer, sizeof(buffer), "%.0f", double(value));
+  return buffer;
+}
+}
+
+TEST_CASE("to_chars integer")
+{
+  CHECK_EQ(to_string(0), "0");
+  CHECK_EQ(to_string(7), "7");
+  CHECK_EQ(to_string(-10), "-10");
+  CHECK_EQ(to_string(std::numeric_limits<std::int64_t>::min()),
+           "-9223372036854775808");
+  CHECK_EQ(to_string(std::numeric_limits<std::uint64_t>::max()),
+           "18446744073709551615");
+  CHECK_EQ(to_string(std::int8_t(-128)), "-128");
+  {
+    char buffer[64];
+    CHECK_EQ(std::string(buffer, *to_chars(buffer, 255, 16)), "ff");
+    CHECK_EQ(std::string(buffer, *to_chars(buffer, -5, 2)), "-101");
+    CHECK_EQ(std::string(buffer, *to_chars(buffer, 1295, 36)), "zz");
+    CHECK_EQ(std::string(buffer, *to_chars(buffer, 0, 2)), "0");
+  }
+  {
+    char buffer[3];
+    CHECK_EQ(*to_chars(buffer, 999), 3);
+    CHECK_EQ(to_chars(buffer, 1000).error(), std::errc::value_too_large);
+    CHECK_EQ(to_chars(buffer, -100).error(), std::errc::value_too_large);
+    CHECK_EQ(to_chars(span<char>(), 0).error(), std::errc::value_too_large);
+  }
+  {
+    std::mt19937_64 rng(3);
+    for (int i = 0; i < 20000; ++i) {
+      const auto value = static_cast<std::int64_t>(rng()) >> (rng() % 64);
+      CHECK_EQ(to_string(value), std::to_string(value));
+      CHECK_EQ(to_string(std::uint64_t(value)),
+               std::to_string(std::uint64_t(value)));
+      CHECK_EQ(to_string(std::int32_t(value)),
+               std::to_string(std::int32_t(value)));
+    }
+  }
+}
+
+TEST_CASE("to_chars floating point")
+{
+  CHECK_EQ(to_string(0.0), "0");
+  CHECK_EQ(to_string(-0.0), "-0");
+  CHECK_EQ(to_string(1.0), "1");
+  CHECK_EQ(to_string(0.1), "0.1");
+  CHECK_EQ(to_string(0.1f), "0.1");
+  CHECK_EQ(to_string(100.0), "100");
+  CHECK_EQ(to_string(123456.0), "123456");
+  CHECK_EQ(to_string(1e22), "1e+22");
+  CHECK_EQ(to_string(1e-5), "1e-05");
+  CHECK_EQ(to_string(0.0001), "1e-04");
+  CHECK_EQ(to_string(0.001), "0.001");
+  CHECK_EQ(to_string(1.5e300), "1.5e+300");
+  CHECK_EQ(to_string(5e-324), "5e-324");
+  CHECK_EQ(to_string(1.7976931348623157e308), "1.7976931348623157e+308");
+  CHECK_EQ(to_string(0.30000000000000004), "0.30000000000000004");
+  CHECK_EQ(to_string(3.4028235e38f), "3.4028235e+38");
+  CHECK_EQ(to_string(1e-45f), "1e-45");
+  CHECK_EQ(to_string(16777216.0f), "16777216");
+  CHECK_EQ(to_string(std::numeric_limits<double>::infinity()), "inf");
+  CHECK_EQ(to_string(-std::numeric_limits<float>::infinity()), "-inf");
+  CHECK_EQ(to_string(std::numeric_limits<double>::quiet_NaN()), "nan");
+
+  CHECK_EQ(to_string(1e22, chars_format::fixed), "10000000000000000000000");
+  CHECK_EQ(to_string(1e23, chars_format::fixed), "99999999999999991611392");
+  CHECK_EQ(to_string(-71073982370438922240.0, chars_format::fixed),
+           "-71073982370438922240");
+  CHECK_EQ(to_string(74633296.0f), "74633296");
+  CHECK_EQ(to_string(74633296.0f, chars_format::fixed), "74633296");
+  CHECK_EQ(to_string(3.4028235e38f, chars_format::fixed),
+           "340282346638528859811704183484516925440");
+  CHECK_EQ(to_string(std::numeric_limits<double>::max(), chars_format::fixed),
+           integer_by_printf(std::numeric_limits<double>::max()));
+  CHECK_EQ(to_string(0.00125, chars_format::fixed), "0.00125");
+  CHECK_EQ(to_string(12.5, chars_format::fixed), "12.5");
+  CHECK_EQ(to_string(12.5, chars_format::scientific), "1.25e+01");
+  CHECK_EQ(to_string(0.0, chars_format::scientific), "0e+00");
+  CHECK_EQ(to_string(100.0, chars_format::general), "100");
+  CHECK_EQ(to_string(123456.0, chars_format::general), "123456");
+  CHECK_EQ(to_string(1234567.0, chars_format::general), "1.234567e+06");
+  CHECK_EQ(to_string(1e6, chars_format::general), "1e+06");
+  CHECK_EQ(to_string(0.0001, chars_format::general), "0.0001");
+  CHECK_EQ(to_string(0.00001, chars_format::general), "1e-05");
+
+  {
+    char buffer[4];
+    CHECK_EQ(*to_chars(buffer, 0.25), 4);
+    CHECK_EQ(to_chars(buffer, 0.125).error(), std::errc::value_too_large);
+    CHECK_EQ(to_chars(buffer, 1e22, chars_format::fixed).error(),
+             std::errc::value_too_large);
+    CHECK_EQ(to_chars(buffer, -1e22).error(), std::errc::value_too_large);
+    CHECK_EQ(to_chars(span<char>(), 0.0).error(),
+             std::errc::value_too_large);
+  }
+}
+
+TEST_CASE("to_chars floating point randomized")
+{
+  std::mt19937_64 rng(11);
+  for (int i = 0; i < 50000; ++i) {
+    std::uint64_t bits = rng();
+    double value;
+    std::memcpy(&value, &bits, sizeof(value));
+    if (std::isnan(value) || std::isinf(value)) {
+      continue;
+    }
+    CHECK_EQ(to_string(value, chars_format::scientific),
+             shortest_scientific_by_printf(value));
+    if (std::fabs(value) >= 9007199254740992.0) {
+      CHECK_EQ(to_string(value, chars_format::fixed), integer_by_printf(value));
+    }
+    const auto str = to_string(value);
+    CHECK(same_bits(from_chars<double>(str)->value, value));
+    CHECK_EQ(from_chars<double>(str)->size, str.size());
+  }
+  for (int i = 0; i < 50000; ++i) {
+    std::uint32_t bits = std::uint32_t(rng());
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    if (std::isnan(value) || std::isinf(value)) {
+      continue;
+    }
+    CHECK_EQ(to_string(value, chars_format::scientific),
+             shortest_scientific_by_printf(value));
+    if (std::fabs(value) >= 16777216.0f) {
+      CHECK_EQ(to_string(value, chars_format::fixed), integer_by_printf(value));
+    }
+    const auto str = to_string(value);
+    CHECK(same_bits(from_chars<float>(str)->value, value));
+  }
+  for (int i = 0; i < 20000; ++i) {
+    const double value = double(std::int64_t(rng() % 2000000) - 1000000)
+        / double(1 << (rng() % 20));
+    CHECK(same_bits(from_chars<double>(to_string(value, chars_format::fixed))
+                        ->value,
+                    value));
+    CHECK(same_bits(
+        from_chars<double>(to_string(value, chars_format::general))->value,
+        value));
+  }
+}
+
+TEST_SUITE_END();
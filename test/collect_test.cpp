@@ -0,0 +1,145 @@
+//
+// Copyright (c) 2022 Ramirisu (labyrinth dot ramirisu at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <gul_test.h>
+
+#include <gul/collect.hpp>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace gul;
+
+TEST_SUITE_BEGIN("collect");
+
+namespace {
+using exp = expected<int, std::string>;
+
+std::vector<exp> make_expecteds(std::size_t count)
+{
+  std::vector<exp> v;
+  for (std::size_t i = 0; i < count; ++i) {
+    if (i % 7 == 3) {
+      v.emplace_back(unexpect, "e" + std::to_string(i));
+    } else {
+      v.emplace_back(int(i));
+    }
+  }
+  return v;
+}
+
+template <typename T>
+span<T> as_span(std::vector<T>& v)
+{
+  return span<T>(v.data(), v.size());
+}
+
+template <typename T>
+span<const T> as_span(const std::vector<T>& v)
+{
+  return span<const T>(v.data(), v.size());
+}
+
+// Small chunks, so that even short spans are split across threads.
+const parallel_policy small_chunks(4, 64);
+}
+
+TEST_CASE("sequence")
+{
+  {
+    std::vector<optional<int>> v { 1, 2, 3 };
+    const auto r = sequence(as_span(v));
+    REQUIRE(r.has_value());
+    CHECK_EQ(*r, std::vector<int> { 1, 2, 3 });
+    v[1].reset();
+    CHECK_FALSE(sequence(as_span(v)).has_value());
+    CHECK_FALSE(sequence(small_chunks, as_span(v)).has_value());
+  }
+  {
+    std::vector<optional<std::unique_ptr<int>>> v;
+    v.emplace_back(new int(1));
+    v.emplace_back(new int(2));
+    const auto r = sequence(as_span(v));
+    REQUIRE(r.has_value());
+    CHECK_EQ(*(*r)[1], 2);
+    // The values were moved out.
+    CHECK_EQ(*v[1], nullptr);
+  }
+  {
+    const std::vector<exp> v = make_expecteds(1000);
+    const span<const exp> s = as_span(v);
+    CHECK_EQ(sequence(s).error(), "e3");
+    CHECK_EQ(sequence(small_chunks, s).error(), "e3");
+    // Copied out of a const span.
+    CHECK_EQ(v[3].error(), "e3");
+
+    const span<const exp> ok = s.subspan(4, 6);
+    CHECK_EQ(sequence(ok)->size(), 6);
+    CHECK_EQ(sequence(small_chunks, s.first(3))->size(), 3);
+  }
+  {
+    std::vector<exp> v(500, exp(1));
+    CHECK_EQ(sequence(small_chunks, as_span(v))->size(), 500);
+    CHECK_EQ(sequence(span<exp>())->size(), 0);
+  }
+}
+
+TEST_CASE("collect")
+{
+  std::vector<optional<std::string>> v { std::string("a"), nullopt,
+                                         std::string("b") };
+  CHECK_EQ(collect(as_span(v)),
+           std::vector<std::string> { "a", "b" });
+
+  const std::vector<exp> e = make_expecteds(1000);
+  const auto values = collect(as_span(e));
+  CHECK_EQ(values.size(), 1000 - 143);
+  CHECK_EQ(collect(small_chunks, as_span(e)), values);
+  CHECK_EQ(reduce(as_span(values), 0LL),
+           999LL * 1000 / 2 - (3 + 997) * 143LL / 2);
+}
+
+TEST_CASE("partition")
+{
+  std::vector<exp> v = make_expecteds(1000);
+  const auto& const_v = v;
+  const auto serial = partition(as_span(const_v));
+  CHECK_EQ(serial.first.size(), 857);
+  CHECK_EQ(serial.second.size(), 143);
+  CHECK_EQ(serial.second.front(), "e3");
+  CHECK_EQ(serial.second.back(), "e997");
+
+  const auto parallel = partition(small_chunks, as_span(v));
+  CHECK_EQ(parallel.first, serial.first);
+  CHECK_EQ(parallel.second, serial.second);
+  CHECK(v[3].error().empty());
+}
+
+TEST_CASE("transpose")
+{
+  std::vector<optional<int>> v;
+  for (int i = 0; i < 300; ++i) {
+    if (i % 3 == 0) {
+      v.emplace_back(i);
+    } else {
+      v.emplace_back();
+    }
+  }
+  const auto serial = transpose(as_span(v));
+  const auto parallel = transpose(small_chunks, as_span(v));
+  CHECK_EQ(serial.size(), 300);
+  CHECK_EQ(serial.valid_count(), 100);
+  CHECK(std::equal(serial.validity().begin(), serial.validity().end(),
+                   parallel.validity().begin()));
+  for (std::size_t i = 0; i < v.size(); ++i) {
+    CHECK_EQ(serial[i], v[i]);
+    CHECK_EQ(parallel[i], v[i]);
+  }
+}
+
+TEST_SUITE_END();
@@ -9,7 +9,9 @@
 
 #include <gul/expected.hpp>
 
+#include <cstdint>
 #include <cstring>
+#include <system_error>
 
 using namespace gul;
 
@@ -2249,4 +2251,213 @@ TEST_CASE("compare")
   CHECK(!(expected<int, int>(unexpect) != gul::unexpected<int>(0)));
 }
 
+namespace {
+enum class parse_error : int { none, bad_digit, overflow };
+}
+
+GUL_NAMESPACE_BEGIN
+
+template <>
+struct expected_error_niche<parse_error>
+    : expected_error_niche_value<parse_error, parse_error::none> { };
+
+GUL_NAMESPACE_END
+
+namespace {
+GUL_CXX14_CONSTEXPR expected<void, parse_error> check_digit(char c)
+{
+  if (c < '0' || c > '9') {
+    return unexpected<parse_error>(parse_error::bad_digit);
+  }
+  return {};
+}
+}
+
+TEST_CASE("layout")
+{
+  // Small expecteds stay trivially copyable so that they are returned in
+  // registers.
+  using u32 = expected<std::uint32_t, std::errc>;
+  using u64 = expected<std::uint64_t, std::errc>;
+  using v = expected<void, std::errc>;
+  // The flag is padded to the alignment, which for std::uint64_t is 4 on
+  // i386.
+  STATIC_ASSERT(sizeof(u32) == sizeof(std::uint32_t) + alignof(u32));
+  STATIC_ASSERT(sizeof(u64) == sizeof(std::uint64_t) + alignof(u64));
+  STATIC_ASSERT(sizeof(v) == sizeof(std::errc) + alignof(v));
+  STATIC_ASSERT(std::is_trivially_copyable<u32>::value);
+  STATIC_ASSERT(std::is_trivially_copyable<u64>::value);
+  STATIC_ASSERT(std::is_trivially_copyable<v>::value);
+  STATIC_ASSERT(std::is_trivially_destructible<u64>::value);
+
+  // With a niche in E, the error is the discriminator.
+  using nv = expected<void, parse_error>;
+  STATIC_ASSERT(sizeof(nv) == sizeof(parse_error));
+  STATIC_ASSERT(alignof(nv) == alignof(parse_error));
+  STATIC_ASSERT(std::is_trivially_copyable<nv>::value);
+  STATIC_ASSERT(std::is_trivially_destructible<nv>::value);
+}
+
+TEST_CASE("niche")
+{
+  using nv = expected<void, parse_error>;
+  {
+    nv e;
+    CHECK(e.has_value());
+    e = unexpected<parse_error>(parse_error::overflow);
+    CHECK_FALSE(e.has_value());
+    CHECK_EQ(e.error(), parse_error::overflow);
+    nv c = e;
+    CHECK_EQ(c.error(), parse_error::overflow);
+    e.emplace();
+    CHECK(e.has_value());
+    CHECK(e == nv());
+    swap(e, c);
+    CHECK_FALSE(e.has_value());
+    CHECK(c.has_value());
+    CHECK_EQ(e.error(), parse_error::overflow);
+    e = c;
+    CHECK(e.has_value());
+  }
+  {
+    CHECK(check_digit('7').has_value());
+    const auto e = check_digit('x');
+    CHECK_FALSE(e.has_value());
+    CHECK_EQ(e.error(), parse_error::bad_digit);
+    CHECK_EQ(e.error_or(parse_error::none), parse_error::bad_digit);
+    nv u(unexpect, parse_error::bad_digit);
+    CHECK_EQ(u, e);
+  }
+  {
+    // The niche is not an optional_niche, so an optional still holds it.
+    STATIC_ASSERT(sizeof(optional<parse_error>) > sizeof(parse_error));
+    const optional<parse_error> o(parse_error::none);
+    CHECK(o.has_value());
+  }
+}
+
+namespace {
+struct counted_error {
+  static int moves;
+  static int copies;
+
+  int code;
+
+  explicit counted_error(int c)
+      : code(c)
+  {
+  }
+
+  counted_error(const counted_error& other)
+      : code(other.code)
+  {
+    ++copies;
+  }
+
+  counted_error(counted_error&& other) noexcept
+      : code(other.code)
+  {
+    ++moves;
+  }
+
+  counted_error& operator=(const counted_error&) = default;
+
+  counted_error& operator=(counted_error&&) = default;
+};
+
+int counted_error::moves = 0;
+int counted_error::copies = 0;
+
+expected<int, counted_error> checked_half(int v)
+{
+  if (v % 2 != 0) {
+    return expected<int, counted_error>(unexpect, v);
+  }
+  return v / 2;
+}
+
+expected<long, counted_error> quarter(int v)
+{
+  GUL_TRY_EXPECTED(auto half, checked_half(v));
+  GUL_TRY_EXPECTED(const int q, checked_half(half));
+  return q;
+}
+
+expected<void, counted_error> check_even(int v)
+{
+  GUL_TRY_EXPECTED_VOID(checked_half(v));
+  return {};
+}
+
+expected<std::string, int> first_word(const expected<std::string, int>& s)
+{
+  GUL_TRY_EXPECTED(const auto& str, s);
+  return str.substr(0, str.find(' '));
+}
+}
+
+TEST_CASE("GUL_TRY_EXPECTED")
+{
+  CHECK_EQ(quarter(8), 2);
+  CHECK(check_even(8).has_value());
+
+  counted_error::moves = 0;
+  counted_error::copies = 0;
+  auto r = quarter(6);
+  REQUIRE(!r.has_value());
+  CHECK_EQ(r.error().code, 3);
+  // `checked_half` builds the error in place; propagating moves it once.
+  CHECK_EQ(counted_error::moves, 1);
+  CHECK_EQ(counted_error::copies, 0);
+
+  counted_error::moves = 0;
+  CHECK_EQ(check_even(5).error().code, 5);
+  CHECK_EQ(counted_error::moves, 1);
+  CHECK_EQ(counted_error::copies, 0);
+
+  const expected<std::string, int> s("hello world");
+  CHECK_EQ(first_word(s), "hello");
+  CHECK_EQ(*s, "hello world");
+  CHECK_EQ(first_word(unexpected<int>(1)).error(), 1);
+}
+
+#ifdef GUL_HAS_EXPECTED_COROUTINE
+namespace {
+expected<long, counted_error> co_quarter(int v)
+{
+  auto half = co_await checked_half(v);
+  co_return co_await checked_half(half);
+}
+
+expected<void, counted_error> co_check_even(int v)
+{
+  co_await checked_half(v);
+}
+
+expected<int, counted_error> co_fail()
+{
+  co_return unexpected<counted_error>(counted_error(-1));
+}
+}
+
+TEST_CASE("coroutine")
+{
+  CHECK_EQ(co_quarter(8), 2);
+  CHECK(co_check_even(8).has_value());
+  CHECK_EQ(co_fail().error().code, -1);
+
+  counted_error::moves = 0;
+  counted_error::copies = 0;
+  auto r = co_quarter(6);
+  REQUIRE(!r.has_value());
+  CHECK_EQ(r.error().code, 3);
+  // Into the coroutine's result and from there into the return value.
+  CHECK_EQ(counted_error::moves, 2);
+  CHECK_EQ(counted_error::copies, 0);
+
+  CHECK_EQ(co_check_even(5).error().code, 5);
+  CHECK_EQ(counted_error::copies, 0);
+}
+#endif
+
 TEST_SUITE_END();
@@ -0,0 +1,181 @@
+//
+// Copyright (c) 2022 Ramirisu (labyrinth dot ramirisu at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <gul_test.h>
+
+#include <gul/function.hpp>
+#include <gul/optional.hpp>
+
+#include <memory>
+#include <string>
+
+using namespace gul;
+
+TEST_SUITE_BEGIN("function");
+
+namespace {
+int twice(int v)
+{
+  return v * 2;
+}
+
+int apply(function_ref<int(int)> f, int v)
+{
+  return f(v);
+}
+
+struct counter {
+  int count = 0;
+
+  int operator()(int step)
+  {
+    return count += step;
+  }
+};
+
+struct tracked {
+  static int alive;
+
+  tracked() noexcept
+  {
+    ++alive;
+  }
+
+  tracked(const tracked&) noexcept
+  {
+    ++alive;
+  }
+
+  tracked(tracked&&) noexcept
+  {
+    ++alive;
+  }
+
+  ~tracked()
+  {
+    --alive;
+  }
+
+  int operator()() const
+  {
+    return alive;
+  }
+};
+
+int tracked::alive = 0;
+
+struct deref {
+  std::unique_ptr<int> p;
+
+  int operator()() const
+  {
+    return *p;
+  }
+};
+}
+
+TEST_CASE("function_ref")
+{
+  STATIC_ASSERT(sizeof(function_ref<int(int)>) == 2 * sizeof(void*));
+  STATIC_ASSERT(std::is_trivially_copyable<function_ref<int(int)>>::value);
+
+  CHECK_EQ(apply(twice, 2), 4);
+  CHECK_EQ(apply(&twice, 3), 6);
+  CHECK_EQ(apply([](int v) { return v + 1; }, 3), 4);
+
+  // Refers to the callable, so state changes are visible.
+  counter c;
+  function_ref<int(int)> ref = c;
+  ref(2);
+  CHECK_EQ(ref(3), 5);
+  CHECK_EQ(c.count, 5);
+
+  // Copies refer to the same callable.
+  const function_ref<int(int)> copy = ref;
+  CHECK_EQ(copy(1), 6);
+
+  const function_ref<void(int)> discard = c;
+  discard(4);
+  CHECK_EQ(c.count, 10);
+
+  function_ref<std::string(std::string&&)> consume
+      = [](std::string&& s) { return std::move(s); };
+  CHECK_EQ(consume("abc"), "abc");
+
+  CHECK_EQ(optional<int>(5).transform(function_ref<int(int)>(twice)), 10);
+}
+
+TEST_CASE("inplace_function")
+{
+  {
+    inplace_function<int(int)> f;
+    CHECK_FALSE(f);
+    CHECK(f == nullptr);
+    f = twice;
+    CHECK(f != nullptr);
+    CHECK_EQ(f(4), 8);
+    f = nullptr;
+    CHECK_FALSE(f);
+  }
+  {
+    // Null function pointers leave it empty, as they do std::function.
+    int (*null)(int) = nullptr;
+    inplace_function<int(int)> f(null);
+    CHECK_FALSE(f);
+    f = twice;
+    f = null;
+    CHECK_FALSE(f);
+  }
+  {
+    // Move-only callables.
+    inplace_function<int()> f = deref { std::unique_ptr<int>(new int(7)) };
+    CHECK_EQ(f(), 7);
+    inplace_function<int()> g(std::move(f));
+    CHECK_FALSE(f);
+    CHECK_EQ(g(), 7);
+    f = std::move(g);
+    CHECK_EQ(f(), 7);
+  }
+  {
+    // Holds its own copy of the callable.
+    counter c;
+    inplace_function<int(int)> f = c;
+    f(2);
+    CHECK_EQ(f(1), 3);
+    CHECK_EQ(c.count, 0);
+  }
+  {
+    inplace_function<int(int)> a = twice;
+    inplace_function<int(int)> b = counter();
+    swap(a, b);
+    CHECK_EQ(a(1), 1);
+    CHECK_EQ(b(1), 2);
+    inplace_function<int(int)> empty;
+    a.swap(empty);
+    CHECK_FALSE(a);
+    CHECK_EQ(empty(1), 2);
+  }
+  {
+    // Larger captures need a larger buffer.
+    const long long x = 1, y = 2, z = 3, w = 4, v = 5;
+    inplace_function<long long(), 48> f = [=]() { return x + y + z + w + v; };
+    CHECK_EQ(f(), 15);
+    STATIC_ASSERT(decltype(f)::capacity == 48);
+  }
+  {
+    inplace_function<int()> f = tracked();
+    CHECK_EQ(tracked::alive, 1);
+    inplace_function<int()> g = std::move(f);
+    CHECK_EQ(g(), 1);
+    g = [] { return 0; };
+    CHECK_EQ(tracked::alive, 0);
+    g = tracked();
+  }
+  CHECK_EQ(tracked::alive, 0);
+}
+
+TEST_SUITE_END();
@@ -0,0 +1,138 @@
+//
+// Copyright (c) 2022 Ramirisu (labyrinth dot ramirisu at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <gul_test.h>
+
+#include <gul/mapped_file.hpp>
+
+#ifdef GUL_HAS_MAPPED_FILE
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+using namespace gul;
+
+namespace {
+
+class temp_file {
+public:
+  explicit temp_file(const std::string& content)
+      : path_("gul_mapped_file_test.tmp")
+  {
+    std::ofstream out(path_, std::ios::binary | std::ios::trunc);
+    out << content;
+  }
+
+  ~temp_file()
+  {
+    std::remove(path_.c_str());
+  }
+
+  const std::string& path() const noexcept
+  {
+    return path_;
+  }
+
+  std::string read() const
+  {
+    std::ifstream in(path_, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(in),
+                       std::istreambuf_iterator<char>());
+  }
+
+private:
+  std::string path_;
+};
+
+}
+
+TEST_SUITE_BEGIN("mapped_file");
+
+TEST_CASE("read_only")
+{
+  const temp_file file("hello, mapped world");
+  auto mapped = mapped_file::open(file.path());
+  REQUIRE(mapped);
+  CHECK(mapped->is_open());
+  CHECK_EQ(mapped->mode(), mapped_file_mode::read_only);
+  CHECK_EQ(mapped->size(), 19);
+  CHECK_FALSE(mapped->empty());
+  CHECK_EQ(mapped->view(), string_view("hello, mapped world"));
+  CHECK_EQ(mapped->bytes().size(), 19);
+  CHECK_EQ(to_integer<char>(mapped->bytes()[7]), 'm');
+  CHECK(mapped->advise(mapped_file_advice::sequential));
+  CHECK(mapped->advise(mapped_file_advice::random, 3, 4));
+  CHECK(mapped->advise(mapped_file_advice::willneed, 19));
+  CHECK(mapped->advise(mapped_file_advice::normal));
+
+  mapped_file moved = std::move(*mapped);
+  CHECK_FALSE(mapped->is_open());
+  CHECK(mapped->empty());
+  CHECK_EQ(moved.view(), string_view("hello, mapped world"));
+  moved.close();
+  CHECK_FALSE(moved.is_open());
+  CHECK(moved.view().empty());
+}
+
+TEST_CASE("flags")
+{
+  const temp_file file(std::string(1 << 16, 'x'));
+  auto mapped = mapped_file::open(
+      file.path().c_str(), mapped_file_mode::read_only,
+      mapped_file_flags::populate | mapped_file_flags::huge_pages);
+  REQUIRE(mapped);
+  CHECK_EQ(mapped->size(), 1 << 16);
+  CHECK_EQ(mapped->view().find_first_not_of('x'), string_view::npos);
+}
+
+TEST_CASE("read_write")
+{
+  const temp_file file("abcdef");
+  {
+    auto mapped = mapped_file::open(file.path(), mapped_file_mode::read_write);
+    REQUIRE(mapped);
+    mapped->writable_bytes()[0] = static_cast<byte>('X');
+    CHECK(mapped->flush());
+    CHECK(mapped->flush(false));
+  }
+  CHECK_EQ(file.read(), "Xbcdef");
+  {
+    auto mapped
+        = mapped_file::open(file.path(), mapped_file_mode::copy_on_write);
+    REQUIRE(mapped);
+    mapped->writable_bytes()[1] = static_cast<byte>('Y');
+    CHECK_EQ(mapped->view(), string_view("XYcdef"));
+  }
+  CHECK_EQ(file.read(), "Xbcdef");
+}
+
+TEST_CASE("empty and missing files")
+{
+  const temp_file file("");
+  auto mapped = mapped_file::open(file.path());
+  REQUIRE(mapped);
+  CHECK(mapped->is_open());
+  CHECK(mapped->empty());
+  CHECK(mapped->bytes().empty());
+  CHECK(mapped->advise(mapped_file_advice::willneed));
+  CHECK(mapped->flush());
+  mapped_file moved(std::move(*mapped));
+  CHECK(moved.is_open());
+  CHECK_FALSE(mapped->is_open());
+  moved.close();
+  CHECK_FALSE(moved.is_open());
+
+  CHECK_EQ(mapped_file::open("gul_mapped_file_test.missing"),
+           unexpected<std::errc>(std::errc::no_such_file_or_directory));
+  mapped_file none;
+  CHECK_FALSE(none.is_open());
+}
+
+TEST_SUITE_END();
+
+#endif
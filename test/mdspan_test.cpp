@@ -0,0 +1,265 @@
+//
+// Copyright (c) 2022 Ramirisu (labyrinth dot ramirisu at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <gul_test.h>
+
+#include <gul/mdspan.hpp>
+
+#include <array>
+#include <utility>
+
+using namespace gul;
+
+TEST_SUITE_BEGIN("mdspan");
+
+TEST_CASE("extents")
+{
+  using E = extents<int, 2, dynamic_extent, 4, dynamic_extent>;
+  STATIC_ASSERT(E::rank() == 4);
+  STATIC_ASSERT(E::rank_dynamic() == 2);
+  STATIC_ASSERT(E::static_extent(0) == 2);
+  STATIC_ASSERT(E::static_extent(1) == dynamic_extent);
+  STATIC_ASSERT(sizeof(E) == 2 * sizeof(int));
+  STATIC_ASSERT(std::is_empty<extents<int, 2, 3>>::value);
+  STATIC_ASSERT(
+      std::is_empty<layout_right::mapping<extents<int, 2, 3>>>::value);
+  {
+    constexpr E e(3, 5);
+    STATIC_ASSERT(e.extent(0) == 2);
+    STATIC_ASSERT(e.extent(1) == 3);
+    STATIC_ASSERT(e.extent(2) == 4);
+    STATIC_ASSERT(e.extent(3) == 5);
+  }
+  {
+    constexpr E e(2, 3, 4, 5);
+    STATIC_ASSERT(e.extent(1) == 3);
+    STATIC_ASSERT(e.extent(3) == 5);
+    CHECK(e == E(3, 5));
+    CHECK(e != E(3, 6));
+  }
+  {
+    const E e(std::array<int, 2> { { 7, 8 } });
+    CHECK_EQ(e.extent(1), 7);
+    CHECK_EQ(e.extent(3), 8);
+  }
+  {
+    const dextents<std::size_t, 4> d = E(3, 5);
+    CHECK_EQ(d.extent(0), 2);
+    CHECK_EQ(d.extent(1), 3);
+    CHECK_EQ(d.extent(2), 4);
+    CHECK_EQ(d.extent(3), 5);
+    CHECK(d == E(3, 5));
+    const E e(d);
+    CHECK(e == d);
+  }
+  {
+    STATIC_ASSERT(!std::is_constructible<extents<int, 3>,
+                                         extents<int, 5>>::value);
+    STATIC_ASSERT(!std::is_convertible<extents<int, 3>,
+                                       extents<int, 5>>::value);
+    STATIC_ASSERT(!std::is_constructible<extents<int, 3>,
+                                         extents<int, 3, 1>>::value);
+    STATIC_ASSERT(std::is_constructible<extents<int, 3>,
+                                        dextents<int, 1>>::value);
+    STATIC_ASSERT(std::is_convertible<extents<int, 3>,
+                                      dextents<int, 1>>::value);
+    STATIC_ASSERT(!std::is_constructible<
+                  mdspan<float, extents<int, 2, 8>>,
+                  mdspan<float, extents<int, 4, 4>>>::value);
+    STATIC_ASSERT(!std::is_constructible<
+                  layout_right::mapping<extents<int, 2, 8>>,
+                  layout_right::mapping<extents<int, 4, 4>>>::value);
+#if defined(GUL_HAS_CXX20)
+    STATIC_ASSERT(!std::is_convertible<dextents<int, 1>,
+                                       extents<int, 3>>::value);
+    STATIC_ASSERT(!std::is_convertible<
+                  mdspan<float, dextents<int, 2>>,
+                  mdspan<float, extents<int, 4, 4>>>::value);
+#endif
+  }
+  {
+    STATIC_ASSERT(dextents<int, 0>::rank() == 0);
+    STATIC_ASSERT_SAME(dextents<int, 2>,
+                       extents<int, dynamic_extent, dynamic_extent>);
+    const E e;
+    CHECK_EQ(e.extent(1), 0);
+  }
+}
+
+TEST_CASE("layout_right")
+{
+  using E = extents<int, 2, 3, 4>;
+  using M = layout_right::mapping<E>;
+  STATIC_ASSERT(M()(1, 2, 3) == 23);
+  STATIC_ASSERT(M()(0, 1, 0) == 4);
+  const M m;
+  CHECK_EQ(m.required_span_size(), 24);
+  CHECK_EQ(m.stride(0), 12);
+  CHECK_EQ(m.stride(1), 4);
+  CHECK_EQ(m.stride(2), 1);
+  CHECK(M::is_always_exhaustive());
+  const layout_right::mapping<dextents<int, 3>> d(dextents<int, 3>(2, 3, 4));
+  CHECK(d == m);
+  for (int i = 0; i < 2; ++i) {
+    for (int j = 0; j < 3; ++j) {
+      for (int k = 0; k < 4; ++k) {
+        CHECK_EQ(d(i, j, k), m(i, j, k));
+        CHECK_EQ(m(i, j, k), i * 12 + j * 4 + k);
+      }
+    }
+  }
+}
+
+TEST_CASE("layout_left")
+{
+  using E = extents<int, 2, 3, 4>;
+  using M = layout_left::mapping<E>;
+  STATIC_ASSERT(M()(1, 2, 3) == 1 + 2 * 2 + 3 * 6);
+  const M m;
+  CHECK_EQ(m.required_span_size(), 24);
+  CHECK_EQ(m.stride(0), 1);
+  CHECK_EQ(m.stride(1), 2);
+  CHECK_EQ(m.stride(2), 6);
+  for (int i = 0; i < 2; ++i) {
+    for (int j = 0; j < 3; ++j) {
+      for (int k = 0; k < 4; ++k) {
+        CHECK_EQ(m(i, j, k), i + j * 2 + k * 6);
+      }
+    }
+  }
+}
+
+TEST_CASE("layout_stride")
+{
+  using E = dextents<int, 2>;
+  const layout_stride::mapping<E> m(E(3, 4), std::array<int, 2> { { 1, 5 } });
+  CHECK_EQ(m.stride(0), 1);
+  CHECK_EQ(m.stride(1), 5);
+  CHECK_EQ(m(2, 3), 17);
+  CHECK_EQ(m.required_span_size(), 18);
+  CHECK_FALSE(m.is_exhaustive());
+  const layout_stride::mapping<E> r = layout_right::mapping<E>(E(3, 4));
+  CHECK_EQ(r.stride(0), 4);
+  CHECK_EQ(r.stride(1), 1);
+  CHECK_EQ(r(2, 3), 11);
+  CHECK(r.is_exhaustive());
+  const layout_stride::mapping<E> l = layout_left::mapping<E>(E(3, 4));
+  CHECK_EQ(l(2, 3), 2 + 3 * 3);
+  CHECK_EQ(l.strides()[1], 3);
+  CHECK(l != r);
+  const layout_stride::mapping<E> empty(E(0, 4),
+                                        std::array<int, 2> { { 4, 1 } });
+  CHECK_EQ(empty.required_span_size(), 0);
+}
+
+TEST_CASE("mdspan")
+{
+  int data[24] = {};
+  for (int i = 0; i < 24; ++i) {
+    data[i] = i;
+  }
+  {
+    const mdspan<int, extents<int, 2, 3, 4>> m(data);
+    STATIC_ASSERT(sizeof(m) == sizeof(int*));
+    CHECK_EQ(m.rank(), 3);
+    CHECK_EQ(m.size(), 24);
+    CHECK_FALSE(m.empty());
+    CHECK_EQ(m(1, 2, 3), 23);
+    CHECK_EQ(m(std::array<int, 3> { { 1, 0, 2 } }), 14);
+    CHECK_EQ(m.data_handle(), data);
+    CHECK_EQ(m.stride(0), 12);
+    m(0, 0, 1) = 100;
+    CHECK_EQ(data[1], 100);
+    data[1] = 1;
+  }
+  {
+    const mdspan<int, dextents<std::size_t, 2>> m(data, 4, 6);
+    CHECK_EQ(m.extent(0), 4);
+    CHECK_EQ(m.extent(1), 6);
+    CHECK_EQ(m(3, 5), 23);
+    const mdspan<const int, dextents<std::size_t, 2>> c = m;
+    CHECK_EQ(c(2, 1), 13);
+  }
+  {
+    const mdspan<int, dextents<int, 2>, layout_left> m(data, 4, 6);
+    CHECK_EQ(m(3, 5), 23);
+    CHECK_EQ(m(1, 2), 9);
+    const mdspan<int, dextents<int, 2>, layout_stride> s = m;
+    CHECK_EQ(s(1, 2), 9);
+  }
+  {
+    const mdspan<int, extents<int, dynamic_extent, 4>> m(span<int>(data, 24),
+                                                          6);
+    CHECK_EQ(m(5, 3), 23);
+  }
+  {
+    const mdspan<int, dextents<int, 2>> m;
+    CHECK(m.empty());
+    CHECK_EQ(m.data_handle(), nullptr);
+  }
+#ifdef GUL_HAS_CXX17
+  {
+    const auto m = mdspan(data, 4, 6);
+    STATIC_ASSERT_SAME(decltype(m),
+                       const mdspan<int, dextents<std::size_t, 2>>);
+    CHECK_EQ(m(3, 5), 23);
+    const auto e = mdspan(data, extents<int, 2, 12> {});
+    CHECK_EQ(e(1, 11), 23);
+  }
+#endif
+}
+
+TEST_CASE("submdspan")
+{
+  int data[24] = {};
+  for (int i = 0; i < 24; ++i) {
+    data[i] = i;
+  }
+  const mdspan<int, extents<int, 2, 3, 4>> m(data);
+  {
+    const auto s = submdspan(m, 1, full_extent, full_extent);
+    STATIC_ASSERT_SAME(
+        decltype(s),
+        const mdspan<int, extents<int, 3, 4>, layout_stride>);
+    for (int j = 0; j < 3; ++j) {
+      for (int k = 0; k < 4; ++k) {
+        CHECK_EQ(s(j, k), m(1, j, k));
+      }
+    }
+  }
+  {
+    const auto s = submdspan(m, full_extent, 2, std::make_pair(1, 3));
+    STATIC_ASSERT_SAME(
+        decltype(s),
+        const mdspan<int, extents<int, 2, dynamic_extent>, layout_stride>);
+    CHECK_EQ(s.extent(0), 2);
+    CHECK_EQ(s.extent(1), 2);
+    for (int i = 0; i < 2; ++i) {
+      for (int k = 0; k < 2; ++k) {
+        CHECK_EQ(s(i, k), m(i, 2, k + 1));
+      }
+    }
+    const auto t = submdspan(s, 1, full_extent);
+    CHECK_EQ(t.extent(0), 2);
+    CHECK_EQ(t(0), m(1, 2, 1));
+    CHECK_EQ(t(1), m(1, 2, 2));
+  }
+  {
+    const auto s = submdspan(m, 1, 2, 3);
+    STATIC_ASSERT(decltype(s)::rank() == 0);
+    CHECK_EQ(s(), 23);
+  }
+  {
+    const mdspan<int, dextents<int, 2>, layout_left> l(data, 4, 6);
+    const auto s = submdspan(l, std::make_pair(1, 3), 2);
+    CHECK_EQ(s.extent(0), 2);
+    CHECK_EQ(s(0), l(1, 2));
+    CHECK_EQ(s(1), l(2, 2));
+  }
+}
+
+TEST_SUITE_END();
@@ -0,0 +1,129 @@
+//
+// Copyright (c) 2022 Ramirisu (labyrinth dot ramirisu at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <gul_test.h>
+
+#include <gul/optional_array.hpp>
+
+#include <cstdint>
+#include <string>
+
+using namespace gul;
+
+TEST_SUITE_BEGIN("optional_array");
+
+TEST_CASE("basic")
+{
+  {
+    optional_array<int> a;
+    CHECK(a.empty());
+    CHECK_EQ(a.valid_count(), 0);
+    CHECK(a.validity().empty());
+  }
+  {
+    optional_array<int> a(3);
+    CHECK_EQ(a.size(), 3);
+    CHECK_EQ(a.null_count(), 3);
+    CHECK_FALSE(a[0].has_value());
+    a.set(1, 5);
+    CHECK(a.has_value(1));
+    CHECK_EQ(a[1], 5);
+    // Elements are handed out by reference.
+    *a[1] = 6;
+    CHECK_EQ(a.values()[1], 6);
+    a.reset(1);
+    CHECK_FALSE(a[1].has_value());
+    CHECK_EQ(a.null_count(), 3);
+  }
+  {
+    optional_array<std::string> a;
+    a.reserve(3);
+    a.push_back(std::string("a"));
+    a.push_back(nullopt);
+    a.push_back(optional<std::string>("c"));
+    a.push_back(optional<std::string>());
+    CHECK_EQ(a.size(), 4);
+    CHECK_EQ(a.valid_count(), 2);
+    const auto& c = a;
+    CHECK_EQ(*c[0], "a");
+    CHECK_FALSE(c[1].has_value());
+    CHECK_EQ(*c[2], "c");
+    CHECK_FALSE(c[3].has_value());
+    CHECK_EQ(c.validity().size(), 1);
+    CHECK_EQ(c.validity()[0], 0x5);
+    a.clear();
+    CHECK(a.empty());
+    CHECK(a.validity().empty());
+  }
+}
+
+TEST_CASE("bitmap")
+{
+  optional_array<std::uint8_t> a;
+  for (std::size_t i = 0; i < 200; ++i) {
+    if (i % 3 == 0) {
+      a.push_back(std::uint8_t(i));
+    } else {
+      a.push_back(nullopt);
+    }
+  }
+  CHECK_EQ(a.validity().size(), 4);
+  CHECK_EQ(a.valid_count(), 67);
+  CHECK_EQ(a.null_count(), 133);
+  // Bits past the end stay clear.
+  CHECK_EQ(a.validity()[3] >> 8, 0);
+  for (std::size_t i = 0; i < 200; ++i) {
+    CHECK_EQ(a.has_value(i), i % 3 == 0);
+  }
+
+  // Enough words to run over several popcount blocks.
+  optional_array<std::uint8_t> b(64 * 70 + 5);
+  for (std::size_t i = 0; i < b.size(); i += 2) {
+    b.set(i, 1);
+  }
+  CHECK_EQ(b.valid_count(), (b.size() + 1) / 2);
+}
+
+TEST_CASE("reduce")
+{
+  {
+    optional_array<int> a;
+    CHECK_EQ(reduce(a, 7), 7);
+  }
+  {
+    // Mixes fully valid, fully null and partially valid words.
+    optional_array<int> a(64 * 5 + 10);
+    long long expected = 0;
+    for (std::size_t i = 0; i < a.size(); ++i) {
+      const bool valid = i < 128 || (i >= 192 && i % 5 != 0);
+      if (valid) {
+        a.set(i, int(i));
+        expected += int(i);
+      } else {
+        a.values()[i] = 1000000;
+      }
+    }
+    CHECK_EQ(reduce(a, 0LL), expected);
+    CHECK_EQ(reduce(a, 0LL, [](long long acc, int v) { return acc + v; }),
+             expected);
+    CHECK_EQ(reduce(a, 0, [](int acc, int v) { return acc > v ? acc : v; }),
+             int(a.size() - 1));
+  }
+  {
+    optional_array<double> a;
+    for (int i = 0; i < 100; ++i) {
+      if (i % 2 == 0) {
+        a.push_back(0.5);
+      } else {
+        a.push_back(nullopt);
+      }
+    }
+    CHECK_EQ(reduce(a, 1.0), 26.0);
+  }
+}
+
+TEST_SUITE_END();
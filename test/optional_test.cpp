@@ -1619,4 +1619,86 @@ TEST_CASE("make_optional")
   CHECK_EQ(vec.value(), dc<int> { 0, 1, 2 });
 }
 
+namespace {
+enum class row_index : int { };
+
+struct node { };
+}
+
+GUL_NAMESPACE_BEGIN
+
+template <>
+struct optional_niche<row_index>
+    : optional_niche_value<row_index, row_index(-1)> { };
+
+template <>
+struct optional_niche<char32_t> : optional_niche_max<char32_t> { };
+
+template <>
+struct optional_niche<node*> : optional_niche_null<node*> { };
+
+template <>
+struct optional_niche<double> : optional_niche_nan<double> { };
+
+GUL_NAMESPACE_END
+
+TEST_CASE("niche")
+{
+  STATIC_ASSERT(sizeof(optional<row_index>) == sizeof(row_index));
+  STATIC_ASSERT(sizeof(optional<char32_t>) == sizeof(char32_t));
+  STATIC_ASSERT(sizeof(optional<node*>) == sizeof(node*));
+  STATIC_ASSERT(sizeof(optional<double>) == sizeof(double));
+  STATIC_ASSERT(sizeof(optional<int>) > sizeof(int));
+  {
+    optional<row_index> o;
+    CHECK_FALSE(o.has_value());
+    o = row_index(0);
+    CHECK(o.has_value());
+    CHECK_EQ(*o, row_index(0));
+    o.emplace(row_index(7));
+    CHECK_EQ(*o, row_index(7));
+    optional<row_index> c = o;
+    CHECK_EQ(c, row_index(7));
+    o.reset();
+    CHECK_FALSE(o.has_value());
+    CHECK_EQ(o.value_or(row_index(3)), row_index(3));
+    swap(o, c);
+    CHECK(o.has_value());
+    CHECK_FALSE(c.has_value());
+    CHECK_EQ(*o, row_index(7));
+    c = nullopt;
+    CHECK_FALSE(c.has_value());
+  }
+  {
+    optional<char32_t> o(in_place, U'a');
+    CHECK_EQ(*o, U'a');
+    o = nullopt;
+    CHECK_FALSE(o.has_value());
+    CHECK_FALSE(o.transform([](char32_t c) { return int(c); }).has_value());
+  }
+  {
+    node n;
+    optional<node*> o;
+    CHECK_FALSE(o.has_value());
+    o = &n;
+    CHECK_EQ(*o, &n);
+    CHECK_EQ(o.value(), &n);
+  }
+  {
+    optional<double> o;
+    CHECK_FALSE(o.has_value());
+    o = 1.5;
+    CHECK_EQ(*o, 1.5);
+    // NaNs other than the reserved one are values.
+    o = std::numeric_limits<double>::quiet_NaN();
+    CHECK(o.has_value());
+    o.reset();
+    CHECK_FALSE(o.has_value());
+    std::vector<optional<double>> column(4);
+    column[1] = 2.0;
+    CHECK_FALSE(column[0].has_value());
+    CHECK(column[1].has_value());
+  }
+}
+
 TEST_SUITE_END();
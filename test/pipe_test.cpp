@@ -0,0 +1,198 @@
+//
+// Copyright (c) 2022 Ramirisu (labyrinth dot ramirisu at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <gul_test.h>
+
+#include <gul/pipe.hpp>
+
+#include <string>
+#include <vector>
+
+using namespace gul;
+using namespace gul::pipes;
+
+TEST_SUITE_BEGIN("pipe");
+
+namespace {
+struct counted {
+  static int moves;
+  static int copies;
+
+  std::vector<int> data;
+
+  counted() = default;
+
+  explicit counted(std::vector<int> d)
+      : data(std::move(d))
+  {
+  }
+
+  counted(const counted& other)
+      : data(other.data)
+  {
+    ++copies;
+  }
+
+  counted(counted&& other) noexcept
+      : data(std::move(other.data))
+  {
+    ++moves;
+  }
+
+  counted& operator=(const counted&) = default;
+
+  counted& operator=(counted&&) = default;
+};
+
+int counted::moves = 0;
+int counted::copies = 0;
+
+counted append(counted c, int value)
+{
+  c.data.push_back(value);
+  return c;
+}
+
+struct push {
+  int value;
+
+  counted operator()(counted&& c) const
+  {
+    c.data.push_back(value);
+    return std::move(c);
+  }
+};
+
+optional<int> parse(const std::string& s)
+{
+  if (s.empty() || s.size() > 9) {
+    return nullopt;
+  }
+  int value = 0;
+  for (char c : s) {
+    if (c < '0' || c > '9') {
+      return nullopt;
+    }
+    value = value * 10 + (c - '0');
+  }
+  return value;
+}
+}
+
+TEST_CASE("optional")
+{
+  const auto twice = [](int v) { return v * 2; };
+  const auto str = [](int v) { return std::to_string(v); };
+  {
+    optional<int> r = pipe(optional<std::string>("21")) | and_then(parse)
+        | transform(twice) | transform(str) | and_then(parse);
+    CHECK_EQ(r, 42);
+  }
+  {
+    optional<std::string> source("x");
+    optional<int> r = pipe(source) | and_then(parse) | transform(twice);
+    CHECK_FALSE(r.has_value());
+    // An lvalue source is not moved from.
+    CHECK_EQ(*source, "x");
+  }
+  {
+    const optional<std::string> source;
+    auto r = (pipe(source) | or_else([]() {
+                return optional<std::string>("7");
+              }) | and_then(parse))
+                 .run();
+    STATIC_ASSERT(std::is_same<decltype(r), optional<int>>::value);
+    CHECK_EQ(r, 7);
+  }
+  {
+    optional<int> r = pipe(optional<int>()) | or_else([]() {
+                        return optional<int>();
+                      }) | transform(twice);
+    CHECK_FALSE(r.has_value());
+  }
+  {
+    optional<int> r = pipe(optional<int>(1));
+    CHECK_EQ(r, 1);
+  }
+}
+
+TEST_CASE("expected")
+{
+  using exp = expected<int, std::string>;
+  const auto checked_inc = [](int v) -> exp {
+    if (v >= 10) {
+      return unexpected<std::string>("overflow");
+    }
+    return v + 1;
+  };
+  {
+    exp r = pipe(exp(1)) | and_then(checked_inc) | and_then(checked_inc)
+        | transform([](int v) { return v * 10; });
+    CHECK_EQ(r, 30);
+  }
+  {
+    exp r = pipe(exp(10)) | and_then(checked_inc)
+        | transform([](int v) { return v * 10; });
+    CHECK_EQ(r.error(), "overflow");
+  }
+  {
+    expected<int, std::size_t> r = pipe(exp(unexpect, "bad"))
+        | transform([](int v) { return v + 1; })
+        | transform_error([](const std::string& e) { return e.size(); });
+    CHECK_EQ(r.error(), 3);
+  }
+  {
+    exp r = pipe(exp(unexpect, "bad"))
+        | or_else([](const std::string& e) { return exp(int(e.size())); })
+        | and_then(checked_inc);
+    CHECK_EQ(r, 4);
+  }
+  {
+    expected<int, int> r = pipe(exp(unexpect, "bad"))
+        | or_else([](const std::string&) -> expected<int, int> {
+            return unexpected<int>(-1);
+          });
+    CHECK_EQ(r.error(), -1);
+  }
+}
+
+TEST_CASE("stored pipeline")
+{
+  // The stages are owned by the pipeline, so it can outlive the
+  // full-expression that builds it as long as the source does.
+  optional<int> source(20);
+  auto p = gul::pipe(source)
+      | pipes::transform([](int v) { return v + 1; })
+      | pipes::transform([](int v) { return v * 2; });
+  const optional<int> r = std::move(p).run();
+  CHECK_EQ(r, 42);
+}
+
+TEST_CASE("no intermediate results")
+{
+  const std::vector<int> init { 1, 2, 3 };
+  const auto add = [](counted&& c) { return append(std::move(c), 4); };
+
+  counted::moves = 0;
+  counted::copies = 0;
+  auto eager = optional<counted>(in_place, init)
+                   .transform(add)
+                   .transform(push { 5 })
+                   .transform(push { 6 });
+  const int eager_moves = counted::moves;
+
+  counted::moves = 0;
+  optional<counted> lazy = pipe(optional<counted>(in_place, init))
+      | transform(add) | transform(push { 5 }) | transform(push { 6 });
+  const int lazy_moves = counted::moves;
+
+  CHECK_EQ(eager->data, lazy->data);
+  CHECK_EQ(counted::copies, 0);
+  CHECK(lazy_moves < eager_moves);
+}
+
+TEST_SUITE_END();
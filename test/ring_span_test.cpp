@@ -0,0 +1,224 @@
+//
+// Copyright (c) 2022 Ramirisu (labyrinth dot ramirisu at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <gul_test.h>
+
+#include <gul/ring_span.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace gul;
+
+TEST_SUITE_BEGIN("ring_span");
+
+TEST_CASE("basic")
+{
+  {
+    ring_span<int> r;
+    CHECK_EQ(r.capacity(), 0);
+    CHECK(r.empty());
+    CHECK(r.full());
+    CHECK_FALSE(r.push(1));
+    CHECK_FALSE(r.pop().has_value());
+    CHECK(r.readable().empty());
+    CHECK(r.writable().empty());
+  }
+  {
+    int storage[3] = {};
+    ring_span<int> r(storage);
+    CHECK_EQ(r.capacity(), 3);
+    CHECK(r.empty());
+    CHECK_FALSE(r.peek().has_value());
+    CHECK(r.push(1));
+    CHECK(r.push(2));
+    CHECK_EQ(r.size(), 2);
+    CHECK_EQ(r.front(), 1);
+    CHECK_EQ(r.back(), 2);
+    CHECK_EQ(*r.peek(), 1);
+    CHECK(r.push(3));
+    CHECK(r.full());
+    CHECK_FALSE(r.push(4));
+    CHECK_EQ(r.pop(), 1);
+    CHECK(r.push(4));
+    CHECK_EQ(r[0], 2);
+    CHECK_EQ(r[1], 3);
+    CHECK_EQ(r[2], 4);
+    CHECK_EQ(r.back(), 4);
+    // The peeked reference refers to the slot itself.
+    *r.peek() = 20;
+    CHECK_EQ(r.pop(), 20);
+    CHECK_EQ(r.pop(), 3);
+    CHECK_EQ(r.pop(), 4);
+    CHECK_FALSE(r.pop().has_value());
+    CHECK(r.empty());
+  }
+  {
+    std::unique_ptr<int> storage[2];
+    ring_span<std::unique_ptr<int>> r(storage);
+    CHECK(r.push(std::unique_ptr<int>(new int(1))));
+    CHECK(r.push(std::unique_ptr<int>(new int(2))));
+    auto p = r.pop();
+    REQUIRE(p.has_value());
+    CHECK_EQ(**p, 1);
+    CHECK_EQ(storage[0], nullptr);
+    r.clear();
+    CHECK(r.empty());
+  }
+}
+
+TEST_CASE("wrap around")
+{
+  // Runs every start position across the storage boundary.
+  for (std::size_t capacity = 1; capacity <= 7; ++capacity) {
+    std::vector<int> storage(capacity);
+    ring_span<int> r(span<int>(storage.data(), storage.size()));
+    int next_in = 0;
+    int next_out = 0;
+    for (std::size_t round = 0; round < 3 * capacity; ++round) {
+      for (std::size_t count = 0; count <= capacity; ++count) {
+        std::vector<int> in(count);
+        for (auto& value : in) {
+          value = next_in++;
+        }
+        CHECK_EQ(r.write(span<const int>(in.data(), in.size())), count);
+        CHECK_EQ(r.size(), count);
+        const auto readable = r.readable();
+        CHECK_EQ(readable.size(), count);
+        CHECK_EQ(r.writable().size(), capacity - count);
+        if (count != 0) {
+          CHECK_EQ(readable.first.front(), next_out);
+        }
+        std::vector<int> out(count + 1);
+        CHECK_EQ(r.read(span<int>(out.data(), out.size())), count);
+        for (std::size_t i = 0; i < count; ++i) {
+          CHECK_EQ(out[i], next_out++);
+        }
+        CHECK(r.empty());
+      }
+      CHECK(r.push(next_in++));
+      CHECK_EQ(r.pop(), next_out++);
+    }
+  }
+}
+
+TEST_CASE("segments")
+{
+  int storage[5] = {};
+  ring_span<int> r(storage);
+  const int values[] = { 0, 1, 2, 3 };
+  CHECK_EQ(r.write(values), 4);
+  r.consume(3);
+  CHECK_EQ(r.size(), 1);
+
+  // The write position is at index 4, so the free slots wrap.
+  auto writable = r.writable();
+  CHECK_EQ(writable.first.data(), storage + 4);
+  CHECK_EQ(writable.first.size(), 1);
+  CHECK_EQ(writable.second.data(), storage);
+  CHECK_EQ(writable.second.size(), 3);
+  writable.first[0] = 4;
+  writable.second[0] = 5;
+  writable.second[1] = 6;
+  r.commit(3);
+  CHECK_EQ(r.size(), 4);
+  CHECK_EQ(r.write(values), 1);
+  CHECK(r.full());
+  CHECK(r.writable().empty());
+
+  const auto readable = r.readable();
+  CHECK_EQ(readable.first.data(), storage + 3);
+  CHECK_EQ(readable.first.size(), 2);
+  CHECK_EQ(readable.second.data(), storage);
+  CHECK_EQ(readable.second.size(), 3);
+  CHECK_EQ(readable.first[0], 3);
+  CHECK_EQ(readable.first[1], 4);
+  CHECK_EQ(readable.second[0], 5);
+  CHECK_EQ(readable.second[1], 6);
+  CHECK_EQ(readable.second[2], 0);
+
+  std::string strings[2];
+  ring_span<std::string> sr(strings);
+  const std::string in[] = { "a", "b", "c" };
+  CHECK_EQ(sr.write(in), 2);
+  std::string out[2];
+  CHECK_EQ(sr.read(out), 2);
+  CHECK_EQ(out[0], "a");
+  CHECK_EQ(out[1], "b");
+}
+
+TEST_CASE("spsc_ring_span")
+{
+  {
+    int storage[2] = {};
+    spsc_ring_span<int> r(storage);
+    CHECK_EQ(r.capacity(), 2);
+    CHECK(r.empty());
+    CHECK(r.push(1));
+    CHECK(r.push(2));
+    CHECK_FALSE(r.push(3));
+    CHECK_EQ(*r.peek(), 1);
+    CHECK_EQ(r.pop(), 1);
+    CHECK_EQ(r.size(), 1);
+    CHECK(r.push(3));
+    CHECK_EQ(r.readable().first.size(), 1);
+    CHECK_EQ(r.readable().second.size(), 1);
+    r.consume(2);
+    CHECK(r.empty());
+    CHECK_FALSE(r.pop().has_value());
+  }
+  {
+    const std::uint32_t total = 100000;
+    std::vector<std::uint32_t> storage(61);
+    spsc_ring_span<std::uint32_t> r(
+        span<std::uint32_t>(storage.data(), storage.size()));
+    std::thread producer([&]() {
+      std::uint32_t next = 0;
+      std::uint32_t batch[7];
+      while (next < total) {
+        std::uint32_t written = 0;
+        if (next % 3 == 0) {
+          written = r.push(next) ? 1 : 0;
+        } else {
+          std::uint32_t count = 0;
+          for (; count < 7 && next + count < total; ++count) {
+            batch[count] = next + count;
+          }
+          written = std::uint32_t(
+              r.write(span<const std::uint32_t>(batch, count)));
+        }
+        if (written == 0) {
+          std::this_thread::yield();
+        }
+        next += written;
+      }
+    });
+    std::uint32_t expected = 0;
+    bool ordered = true;
+    while (expected < total) {
+      const auto readable = r.readable();
+      for (auto value : readable.first) {
+        ordered = ordered && value == expected++;
+      }
+      for (auto value : readable.second) {
+        ordered = ordered && value == expected++;
+      }
+      r.consume(readable.size());
+      if (readable.empty()) {
+        std::this_thread::yield();
+      }
+    }
+    producer.join();
+    CHECK(ordered);
+    CHECK(r.empty());
+  }
+}
+
+TEST_SUITE_END();
@@ -11,6 +11,8 @@
 #include <gul/string_view.hpp>
 
 #include <array>
+#include <cstdint>
+#include <stdexcept>
 
 using namespace gul;
 
@@ -248,6 +250,92 @@ TEST_CASE("basic")
     CHECK_EQ(ws.data(), reinterpret_cast<byte*>(arr));
     CHECK_EQ(ws.size(), 16);
   }
+  {
+    std::uint16_t arr[] = { 0, 1, 2 };
+    auto s = span<std::uint16_t, 3>(arr, 3);
+    auto rs = as_bytes(s);
+    STATIC_ASSERT_SAME(decltype(rs), span<const byte, 6>);
+    CHECK_EQ(rs.data(), reinterpret_cast<const byte*>(arr));
+    CHECK_EQ(rs.size(), 6);
+    auto ws = as_writable_bytes(s);
+    STATIC_ASSERT_SAME(decltype(ws), span<byte, 6>);
+    CHECK_EQ(ws.size(), 6);
+    auto cs = as_bytes(span<const std::uint16_t>(arr, 2));
+    STATIC_ASSERT_SAME(decltype(cs), span<const byte>);
+    CHECK_EQ(cs.size(), 4);
+  }
+}
+
+TEST_CASE("subspan")
+{
+  int arr[] = { 0, 1, 2, 3 };
+  {
+    auto s = span<int, 4>(arr, 4);
+    auto sub = s.template subspan<1>();
+    STATIC_ASSERT_SAME(decltype(sub), span<int, 3>);
+    CHECK_EQ(sub.data(), arr + 1);
+    CHECK_EQ(sub.size(), 3);
+  }
+  {
+    auto s = span<int>(arr, 4);
+    auto sub = s.template subspan<1>();
+    STATIC_ASSERT_SAME(decltype(sub), span<int>);
+    CHECK_EQ(sub.data(), arr + 1);
+    CHECK_EQ(sub.size(), 3);
+    CHECK_EQ(s.subspan(1).size(), 3);
+    CHECK_EQ(s.subspan(4).size(), 0);
+    CHECK(s.subspan(0, 0).empty());
+  }
+}
+
+TEST_CASE("converting constructor")
+{
+  int arr[] = { 0, 1, 2, 3 };
+  const auto s = span<int, 4>(arr, 4);
+  const span<const int> dynamic = s;
+  CHECK_EQ(dynamic.data(), arr);
+  CHECK_EQ(dynamic.size(), 4);
+  const span<const int, 4> fixed = s;
+  CHECK_EQ(fixed.data(), arr);
+  STATIC_ASSERT(std::is_convertible<span<int>, span<const int>>::value);
+  STATIC_ASSERT(!std::is_convertible<span<const int>, span<int>>::value);
+  STATIC_ASSERT(!std::is_convertible<span<int, 4>, span<int, 3>>::value);
+  STATIC_ASSERT(std::is_constructible<span<int, 4>, span<int>>::value);
+  STATIC_ASSERT(!std::is_convertible<span<long>, span<int>>::value);
+  STATIC_ASSERT(std::is_convertible<span<byte>, span<const byte>>::value);
+}
+
+TEST_CASE("bounds check policy")
+{
+  int arr[] = { 0, 1, 2, 3 };
+  {
+    using checked = span<int, dynamic_extent, bounds_check_throw>;
+    const auto s = checked(arr, 4);
+    CHECK_EQ(s[3], 3);
+    CHECK_THROWS_AS(s[4], std::out_of_range);
+    CHECK_THROWS_AS(s.first(5), std::out_of_range);
+    CHECK_THROWS_AS(s.last(5), std::out_of_range);
+    CHECK_THROWS_AS(s.subspan(5), std::out_of_range);
+    CHECK_THROWS_AS(s.subspan(2, 3), std::out_of_range);
+    CHECK_THROWS_AS(checked().front(), std::out_of_range);
+    CHECK_THROWS_AS(checked().back(), std::out_of_range);
+    // The policy is carried over to subspans.
+    STATIC_ASSERT_SAME(decltype(s.first(2)), checked);
+    STATIC_ASSERT_SAME(decltype(s.template last<2>()),
+                       span<int, 2, bounds_check_throw>);
+    CHECK_THROWS_AS(s.subspan(1, 2)[2], std::out_of_range);
+    // Only the policy differs, so the conversion is implicit both ways.
+    const span<int> unchecked = s;
+    CHECK_EQ(unchecked.data(), arr);
+    const checked back = unchecked;
+    CHECK_EQ(back.size(), 4);
+  }
+  {
+    const auto s = span<int, 4, bounds_check_none>(arr, 4);
+    CHECK_EQ(s[2], 2);
+    STATIC_ASSERT_SAME(decltype(as_bytes(s)),
+                       span<const byte, 16, bounds_check_none>);
+  }
 }
 
 #ifdef GUL_HAS_CXX17
@@ -0,0 +1,107 @@
+//
+// Copyright (c) 2022 Ramirisu (labyrinth dot ramirisu at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <gul_test.h>
+
+#include <gul/expected.hpp>
+#include <gul/optional.hpp>
+#include <gul/status.hpp>
+
+#include <cstdint>
+#include <string>
+
+using namespace gul;
+
+TEST_SUITE_BEGIN("status");
+
+TEST_CASE("basic")
+{
+  {
+    constexpr status s;
+    STATIC_ASSERT(s.ok());
+    CHECK_EQ(s.domain(), 0);
+    CHECK_EQ(s.code(), 0);
+    CHECK_FALSE(s.has_message());
+    CHECK_EQ(s.message(), "ok");
+  }
+  {
+    constexpr status s = std::errc::invalid_argument;
+    STATIC_ASSERT(!s.ok());
+    CHECK_EQ(s.domain(), generic_status_domain);
+    CHECK_EQ(s.code(), int(std::errc::invalid_argument));
+    CHECK_EQ(s.message(),
+             std::generic_category().message(int(std::errc::invalid_argument)));
+    CHECK(s == std::errc::invalid_argument);
+    CHECK(s != std::errc::io_error);
+  }
+  {
+    const status s(7, -3);
+    CHECK_FALSE(s.ok());
+    CHECK_EQ(s.domain(), 7);
+    CHECK_EQ(s.code(), -3);
+    CHECK_EQ(s.message(), "domain 7 code -3");
+    // A zero code still is an error.
+    CHECK_FALSE(status(0, 0).ok());
+    CHECK(status(0, 0) != status());
+  }
+}
+
+TEST_CASE("with_message")
+{
+  const auto s = status::with_message(3, 42, "disk on fire");
+  CHECK_FALSE(s.ok());
+  CHECK(s.has_message());
+  CHECK_EQ(s.domain(), 3);
+  CHECK_EQ(s.code(), 42);
+  CHECK_EQ(s.message(), "disk on fire");
+  // Messages do not take part in comparisons.
+  CHECK(s == status(3, 42));
+  CHECK(s == status::with_message(3, 42, "other"));
+  CHECK(s != status(3, 43));
+
+  const auto e = status::with_message(std::errc::timed_out, "after 5s");
+  CHECK(e == std::errc::timed_out);
+  CHECK_EQ(e.message(), "after 5s");
+}
+
+TEST_CASE("expected")
+{
+  STATIC_ASSERT(sizeof(status) == sizeof(std::uint64_t));
+  STATIC_ASSERT(std::is_trivially_copyable<status>::value);
+  STATIC_ASSERT(std::is_trivially_copyable<expected<int, status>>::value);
+  STATIC_ASSERT(sizeof(expected<int, status>)
+                == sizeof(status) + alignof(expected<int, status>));
+  STATIC_ASSERT(sizeof(expected<void, status>) == sizeof(status));
+
+  const auto check = [](int v) -> expected<void, status> {
+    if (v < 0) {
+      return unexpected<status>(std::errc::invalid_argument);
+    }
+    return {};
+  };
+  CHECK(check(1).has_value());
+  CHECK_EQ(check(-1).error(), std::errc::invalid_argument);
+
+  expected<int, status> r = unexpected<status>(status(2, 5));
+  CHECK_EQ(r.error(), status(2, 5));
+  r = 3;
+  CHECK_EQ(r, 3);
+}
+
+TEST_CASE("optional")
+{
+  // Only expected reserves the ok status; an optional can hold it.
+  optional<status> last(status {});
+  CHECK(last.has_value());
+  CHECK(last->ok());
+  last = status(std::errc::timed_out);
+  CHECK_EQ(*last, std::errc::timed_out);
+  last.reset();
+  CHECK(!last.has_value());
+}
+
+TEST_SUITE_END();
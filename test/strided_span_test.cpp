@@ -0,0 +1,250 @@
+//
+// Copyright (c) 2022 Ramirisu (labyrinth dot ramirisu at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <gul_test.h>
+
+#include <gul/strided_span.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+using namespace gul;
+
+namespace {
+
+struct record {
+  std::uint8_t tag;
+  double price;
+  std::int32_t quantity;
+};
+
+}
+
+TEST_SUITE_BEGIN("strided_span");
+
+TEST_CASE("basic")
+{
+  STATIC_ASSERT(sizeof(strided_span<int>) == 3 * sizeof(std::size_t));
+  STATIC_ASSERT(sizeof(strided_span<int, 8>) == 2 * sizeof(std::size_t));
+  {
+    const strided_span<int> s;
+    CHECK(s.empty());
+    CHECK_EQ(s.data(), nullptr);
+    CHECK_EQ(s.size(), 0);
+    CHECK_EQ(s.begin(), s.end());
+  }
+  {
+    int arr[] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+    const strided_span<int> s(arr, 5, 2 * sizeof(int));
+    CHECK_EQ(s.size(), 5);
+    CHECK_EQ(s.stride(), 2 * sizeof(int));
+    CHECK_EQ(s.front(), 0);
+    CHECK_EQ(s.back(), 8);
+    for (std::size_t i = 0; i < s.size(); ++i) {
+      CHECK_EQ(s[i], int(2 * i));
+    }
+    s[1] = 20;
+    CHECK_EQ(arr[2], 20);
+    arr[2] = 2;
+
+    const strided_span<int, 3 * sizeof(int)> t(arr + 1, 3);
+    CHECK_EQ(t.stride(), 3 * sizeof(int));
+    CHECK_EQ(t[0], 1);
+    CHECK_EQ(t[1], 4);
+    CHECK_EQ(t[2], 7);
+    const strided_span<const int> u = t;
+    CHECK_EQ(u.stride(), 3 * sizeof(int));
+    CHECK_EQ(u[2], 7);
+  }
+  {
+    int arr[] = { 0, 1, 2, 3 };
+    const strided_span<int> s = span<int>(arr);
+    CHECK_EQ(s.stride(), sizeof(int));
+    CHECK_EQ(s.size(), 4);
+    CHECK_EQ(s[3], 3);
+    const strided_span<const int, sizeof(int)> t = span<int, 4>(arr);
+    CHECK_EQ(t[2], 2);
+  }
+}
+
+TEST_CASE("first/last/subspan")
+{
+  int arr[] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+  const strided_span<int> s(arr, 5, 2 * sizeof(int));
+  {
+    const auto f = s.first(2);
+    CHECK_EQ(f.size(), 2);
+    CHECK_EQ(f[1], 2);
+    CHECK(s.first(0).empty());
+  }
+  {
+    const auto l = s.last(2);
+    CHECK_EQ(l.size(), 2);
+    CHECK_EQ(l[0], 6);
+    CHECK_EQ(l[1], 8);
+    CHECK(s.last(0).empty());
+  }
+  {
+    const auto sub = s.subspan(1, 3);
+    CHECK_EQ(sub.size(), 3);
+    CHECK_EQ(sub[0], 2);
+    CHECK_EQ(sub[2], 6);
+    const auto rest = s.subspan(2);
+    CHECK_EQ(rest.size(), 3);
+    CHECK_EQ(rest[0], 4);
+    CHECK(s.subspan(5).empty());
+  }
+}
+
+TEST_CASE("iterator")
+{
+  int arr[] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+  const strided_span<int> s(arr, 4, 3 * sizeof(int));
+  STATIC_ASSERT_SAME(std::iterator_traits<strided_span<int>::iterator>::
+                         iterator_category,
+                     std::random_access_iterator_tag);
+  {
+    std::vector<int> v(s.begin(), s.end());
+    CHECK_EQ(v, std::vector<int> { 0, 3, 6, 9 });
+    std::vector<int> r(s.rbegin(), s.rend());
+    CHECK_EQ(r, std::vector<int> { 9, 6, 3, 0 });
+  }
+  {
+    auto it = s.begin();
+    CHECK_EQ(s.end() - it, 4);
+    CHECK_EQ(it[2], 6);
+    it += 3;
+    CHECK_EQ(*it, 9);
+    it -= 2;
+    CHECK_EQ(*it, 3);
+    CHECK_EQ(*(it + 1), 6);
+    CHECK_EQ(*(1 + it), 6);
+    CHECK_EQ(*(it - 1), 0);
+    CHECK_EQ(*it++, 3);
+    CHECK_EQ(*it--, 6);
+    CHECK_EQ(*++it, 6);
+    CHECK_EQ(*--it, 3);
+    CHECK(s.begin() < it);
+    CHECK(s.begin() <= it);
+    CHECK(s.end() > it);
+    CHECK(s.end() >= it);
+    CHECK(it != s.begin());
+  }
+  {
+    std::sort(s.begin(), s.end(), [](int l, int r) { return l > r; });
+    CHECK_EQ(arr[0], 9);
+    CHECK_EQ(arr[3], 6);
+    CHECK_EQ(arr[6], 3);
+    CHECK_EQ(arr[9], 0);
+    CHECK_EQ(arr[1], 1);
+  }
+}
+
+TEST_CASE("make_strided_span")
+{
+  std::vector<record> records(5);
+  for (std::size_t i = 0; i < records.size(); ++i) {
+    records[i].tag = std::uint8_t(i);
+    records[i].price = double(i) * 1.5;
+    records[i].quantity = std::int32_t(i) * 10;
+  }
+  const auto all = span<record>(records.data(), records.size());
+  {
+    const auto prices = make_strided_span(all, &record::price);
+    STATIC_ASSERT_SAME(decltype(prices),
+                       const strided_span<double, sizeof(record)>);
+    CHECK_EQ(prices.size(), 5);
+    CHECK_EQ(prices[4], 6.0);
+    prices[0] = 100.0;
+    CHECK_EQ(records[0].price, 100.0);
+  }
+  {
+    const std::vector<record>& crecords = records;
+    const auto quantities = make_strided_span(
+        span<const record>(crecords.data(), crecords.size()),
+        &record::quantity);
+    STATIC_ASSERT_SAME(decltype(quantities),
+                       const strided_span<const std::int32_t,
+                                          sizeof(record)>);
+    CHECK_EQ(quantities[3], 30);
+  }
+  {
+    const auto none = make_strided_span(span<record>(), &record::tag);
+    CHECK(none.empty());
+  }
+}
+
+namespace {
+
+template <typename T>
+void check_gather(std::size_t stride_elements, std::size_t count)
+{
+  std::vector<T> source(stride_elements * count + 1);
+  for (std::size_t i = 0; i < source.size(); ++i) {
+    source[i] = T(i * 3 + 1);
+  }
+  const std::vector<T>& csource = source;
+  const strided_span<const T> s(csource.data(), count,
+                                stride_elements * sizeof(T));
+  std::vector<T> out(count + 2, T(0));
+  const auto written = gather(s, span<T>(out.data(), out.size()));
+  CHECK_EQ(written.data(), out.data());
+  CHECK_EQ(written.size(), count);
+  for (std::size_t i = 0; i < count; ++i) {
+    CHECK_EQ(out[i], source[i * stride_elements]);
+  }
+  CHECK_EQ(out[count], T(0));
+}
+
+}
+
+TEST_CASE("gather")
+{
+  for (std::size_t count : { 0, 1, 3, 4, 7, 8, 9, 17, 64, 100 }) {
+    for (std::size_t stride : { 1, 2, 3, 5 }) {
+      check_gather<std::uint8_t>(stride, count);
+      check_gather<std::int16_t>(stride, count);
+      check_gather<std::int32_t>(stride, count);
+      check_gather<float>(stride, count);
+      check_gather<std::uint64_t>(stride, count);
+      check_gather<double>(stride, count);
+    }
+  }
+  {
+    std::vector<record> records(33);
+    for (std::size_t i = 0; i < records.size(); ++i) {
+      records[i].price = double(i) + 0.25;
+      records[i].quantity = std::int32_t(i) - 7;
+    }
+    const std::vector<record>& crecords = records;
+    const auto all = span<const record>(crecords.data(), crecords.size());
+    std::vector<double> prices(records.size());
+    gather(make_strided_span(all, &record::price),
+           span<double>(prices.data(), prices.size()));
+    std::vector<std::int32_t> quantities(records.size());
+    gather(make_strided_span(all, &record::quantity),
+           span<std::int32_t>(quantities.data(), quantities.size()));
+    for (std::size_t i = 0; i < records.size(); ++i) {
+      CHECK_EQ(prices[i], records[i].price);
+      CHECK_EQ(quantities[i], records[i].quantity);
+    }
+  }
+  {
+    std::string strs[] = { "a", "b", "c", "d", "e", "f" };
+    const strided_span<std::string> s(strs, 3, 2 * sizeof(std::string));
+    std::string out[3];
+    gather(s, span<std::string>(out));
+    CHECK_EQ(out[0], "a");
+    CHECK_EQ(out[1], "c");
+    CHECK_EQ(out[2], "e");
+  }
+}
+
+TEST_SUITE_END();
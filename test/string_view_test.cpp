@@ -9,6 +9,10 @@
 
 #include <gul/string_view.hpp>
 
+#include <algorithm>
+#include <random>
+#include <string>
+
 using namespace gul;
 
 TEST_SUITE_BEGIN("string_view");
@@ -390,33 +394,184 @@ TEST_CASE("user-defined literals")
 
 TEST_CASE("hash")
 {
-  std::string str(test::s);
-  string_view sv(test::s);
-  CHECK_EQ(std::hash<std::string>()(str), std::hash<string_view>()(sv));
+  std::hash<string_view> hasher;
+  CHECK_EQ(hasher(test::s), hasher(std::string(test::s)));
+  CHECK_EQ(hasher(""), hasher(string_view()));
+  CHECK_NE(hasher("hello world!"), hasher("hello world?"));
+  CHECK_NE(hasher(""), hasher(string_view("\0", 1)));
+  CHECK_NE(hasher("a"), hasher("aa"));
+
+  const std::string text(256, 'x');
+  const auto base = hasher(text);
+  for (std::size_t i = 0; i < text.size(); ++i) {
+    std::string copy = text;
+    copy[i] = 'y';
+    CHECK_NE(hasher(copy), base);
+    CHECK_NE(hasher(string_view(text.data(), i)), base);
+  }
 
-  const wchar_t* ws = L"hello world!";
-  std::wstring wstr(ws);
-  wstring_view wsv(ws);
-  CHECK_EQ(std::hash<std::wstring>()(wstr), std::hash<wstring_view>()(wsv));
+  CHECK_EQ(std::hash<string_view>()(test::s), string_view_hash()(test::s));
+  CHECK_EQ(string_view_hash(42)(test::s), string_view_hash(42)(test::s));
+  CHECK_NE(string_view_hash(42)(test::s), string_view_hash(43)(test::s));
+  CHECK_NE(string_view_hash(42)(test::s), string_view_hash()(test::s));
+
+  CHECK_EQ(std::hash<wstring_view>()(L"hello world!"),
+           wstring_view_hash()(std::wstring(L"hello world!")));
+  CHECK_EQ(std::hash<u16string_view>()(u"hello world!"),
+           u16string_view_hash()(std::u16string(u"hello world!")));
+  CHECK_EQ(std::hash<u32string_view>()(U"hello world!"),
+           u32string_view_hash()(std::u32string(U"hello world!")));
+#if defined(GUL_HAS_CXX20) || defined(__cpp_char8_t)
+  CHECK_EQ(std::hash<u8string_view>()(u8"hello world!"),
+           u8string_view_hash()(std::u8string(u8"hello world!")));
+#endif
 
-  const char16_t* u16s = u"hello world!";
-  std::u16string u16str(u16s);
-  u16string_view u16sv(u16s);
-  CHECK_EQ(std::hash<std::u16string>()(u16str),
-           std::hash<u16string_view>()(u16sv));
+#if !GUL_BIG_ENDIAN
+  CHECK_EQ(string_view_hash(0)(""), std::size_t(0x42bc986dc5eec4d3));
+  CHECK_EQ(string_view_hash(1)("a"), std::size_t(0x84508dc903c31551));
+  CHECK_EQ(string_view_hash(2)("abc"), std::size_t(0x0bc54887cfc9ecb1));
+  CHECK_EQ(string_view_hash(3)("message digest"),
+           std::size_t(0x6e2ff3298208a67c));
+  CHECK_EQ(string_view_hash(4)("abcdefghijklmnopqrstuvwxyz"),
+           std::size_t(0x9a64e42e897195b9));
+  CHECK_EQ(string_view_hash(5)("ABCDEFGHIJKLMNOPQRSTUVWXYZ"
+                               "abcdefghijklmnopqrstuvwxyz0123456789"),
+           std::size_t(0x9199383239c32554));
+  CHECK_EQ(string_view_hash(6)("1234567890123456789012345678901234567890"
+                               "1234567890123456789012345678901234567890"),
+           std::size_t(0x7c1ccf6bba30f5a5));
+#endif
+}
 
-  const char32_t* u32s = U"hello world!";
-  std::u32string u32str(u32s);
-  u32string_view u32sv(u32s);
-  CHECK_EQ(std::hash<std::u32string>()(u32str),
-           std::hash<u32string_view>()(u32sv));
+namespace test {
+std::string to_lower(string_view sv)
+{
+  std::string result(sv.data(), sv.size());
+  for (auto& c : result) {
+    if (c >= 'A' && c <= 'Z') {
+      c = char(c - 'A' + 'a');
+    }
+  }
+  return result;
+}
 
-#if defined(GUL_HAS_CXX20) || defined(__cpp_char8_t)
-  const char8_t* u8s = u8"hello world!";
-  std::u8string u8str(u8s);
-  u8string_view u8sv(u8s);
-  CHECK_EQ(std::hash<std::u8string>()(u8str), std::hash<u8string_view>()(u8sv));
-#endif
+std::string random_string(std::mt19937& gen, std::size_t size)
+{
+  static const char alphabet[] = "aAbBzZ@[`{\x80\xC1\xE1";
+  std::uniform_int_distribution<std::size_t> dist(0, sizeof(alphabet) - 2);
+  std::string result(size, '\0');
+  for (auto& c : result) {
+    c = alphabet[dist(gen)];
+  }
+  return result;
+}
+
+int sign(int value)
+{
+  return value < 0 ? -1 : value > 0 ? 1 : 0;
+}
+}
+
+TEST_CASE("iequals")
+{
+  CHECK(iequals("", ""));
+  CHECK(iequals("Content-Type", "content-type"));
+  CHECK(iequals("CONTENT-TYPE", "content-type"));
+  CHECK_FALSE(iequals("Content-Type", "content-typ"));
+  CHECK_FALSE(iequals("Content-Type", "content_type"));
+  CHECK_FALSE(iequals("@", "`"));
+  CHECK_FALSE(iequals("[", "{"));
+  CHECK_FALSE(iequals("\xC1", "\xE1"));
+
+  std::mt19937 gen;
+  for (std::size_t size = 0; size < 80; ++size) {
+    const auto str = test::random_string(gen, size);
+    std::string upper = str;
+    std::transform(upper.begin(), upper.end(), upper.begin(), [](char c) {
+      return c >= 'a' && c <= 'z' ? char(c - 'a' + 'A') : c;
+    });
+    CHECK(iequals(str, upper));
+    for (std::size_t i = 0; i < size; ++i) {
+      std::string other = upper;
+      other[i] = '\x80';
+      CHECK_EQ(iequals(str, other), str[i] == '\x80');
+    }
+  }
+}
+
+TEST_CASE("icompare")
+{
+  CHECK_EQ(icompare("", ""), 0);
+  CHECK_EQ(icompare("ABC", "abc"), 0);
+  CHECK_EQ(icompare("ABC", "abd"), -1);
+  CHECK_EQ(icompare("abd", "ABC"), 1);
+  CHECK_EQ(icompare("ab", "ABC"), -1);
+  CHECK_EQ(icompare("ABC", "ab"), 1);
+  CHECK_EQ(icompare("Z", "\x80"), -1);
+
+  std::mt19937 gen;
+  std::uniform_int_distribution<std::size_t> size_dist(0, 40);
+  for (int i = 0; i < 5000; ++i) {
+    const auto lhs = test::random_string(gen, size_dist(gen));
+    const auto rhs = test::random_string(gen, size_dist(gen));
+    CHECK_EQ(icompare(lhs, rhs),
+             test::sign(string_view(test::to_lower(lhs))
+                            .compare(test::to_lower(rhs))));
+  }
+}
+
+TEST_CASE("istarts_with")
+{
+  CHECK(istarts_with("", ""));
+  CHECK(istarts_with("Accept-Encoding", ""));
+  CHECK(istarts_with("Accept-Encoding", "ACCEPT"));
+  CHECK(istarts_with("Accept-Encoding", "accept-encoding"));
+  CHECK_FALSE(istarts_with("Accept", "accept-encoding"));
+  CHECK_FALSE(istarts_with("Accept-Encoding", "except"));
+}
+
+TEST_CASE("ifind")
+{
+  string_view sv = "Transfer-Encoding: CHUNKED";
+  CHECK_EQ(ifind(sv, "chunked"), 19);
+  CHECK_EQ(ifind(sv, "ENCODING"), 9);
+  CHECK_EQ(ifind(sv, "encoding", 10), string_view::npos);
+  CHECK_EQ(ifind(sv, "gzip"), string_view::npos);
+  CHECK_EQ(ifind(sv, ""), 0);
+  CHECK_EQ(ifind(sv, "", sv.size()), sv.size());
+  CHECK_EQ(ifind(sv, "", sv.size() + 1), string_view::npos);
+  CHECK_EQ(ifind("", "a"), string_view::npos);
+
+  std::mt19937 gen;
+  std::uniform_int_distribution<std::size_t> size_dist(0, 80);
+  std::uniform_int_distribution<std::size_t> needle_dist(0, 3);
+  for (int i = 0; i < 5000; ++i) {
+    const auto str = test::random_string(gen, size_dist(gen));
+    const auto needle = test::random_string(gen, needle_dist(gen));
+    const auto lower = test::to_lower(str);
+    const auto lower_needle = test::to_lower(needle);
+    for (std::size_t index = 0; index <= str.size() + 1; index += 7) {
+      CHECK_EQ(ifind(str, needle, index), lower.find(lower_needle, index));
+    }
+  }
+}
+
+TEST_CASE("string_view_ihash")
+{
+  string_view_ihash hasher;
+  CHECK_EQ(hasher("Content-Length"), hasher("content-length"));
+  CHECK_EQ(hasher("Content-Length"), hasher("CONTENT-LENGTH"));
+  CHECK_NE(hasher("Content-Length"), hasher("Content-Type"));
+  CHECK_NE(string_view_ihash(1)("Host"), string_view_ihash(2)("Host"));
+  CHECK(string_view_iequal_to()("Host", "HOST"));
+  CHECK_FALSE(string_view_iequal_to()("Host", "Hosts"));
+
+  std::mt19937 gen;
+  for (std::size_t size = 0; size < 120; ++size) {
+    const auto str = test::random_string(gen, size);
+    CHECK_EQ(string_view_ihash(7)(str),
+             string_view_hash(7)(test::to_lower(str)));
+  }
 }
 
 TEST_SUITE_END();
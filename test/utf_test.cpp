@@ -0,0 +1,330 @@
+//
+// Copyright (c) 2022 Ramirisu (labyrinth dot ramirisu at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <gul_test.h>
+
+#include <gul/utf.hpp>
+
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace gul;
+
+TEST_SUITE_BEGIN("utf");
+
+namespace {
+std::string encode_utf8(char32_t c)
+{
+  char buffer[4];
+  auto r = utf32_to_utf8(u32string_view(&c, 1), buffer);
+  return std::string(buffer, r.has_value() ? *r : 0);
+}
+
+std::u32string random_code_points(std::mt19937& gen, std::size_t size)
+{
+  std::uniform_int_distribution<int> plane(0, 3);
+  std::u32string result;
+  for (std::size_t i = 0; i < size; ++i) {
+    char32_t c;
+    switch (plane(gen)) {
+    case 0:
+      c = std::uniform_int_distribution<char32_t>(0, 0x7F)(gen);
+      break;
+    case 1:
+      c = std::uniform_int_distribution<char32_t>(0x80, 0x7FF)(gen);
+      break;
+    case 2:
+      c = std::uniform_int_distribution<char32_t>(0x800, 0xFFFF)(gen);
+      if (c >= 0xD800 && c <= 0xDFFF) {
+        c -= 0x800;
+      }
+      break;
+    default:
+      c = std::uniform_int_distribution<char32_t>(0x10000, 0x10FFFF)(gen);
+      break;
+    }
+    result.push_back(c);
+  }
+  return result;
+}
+
+std::string to_utf8(const std::u32string& str)
+{
+  std::string result(str.size() * 4, '\0');
+  auto r = utf32_to_utf8(str, span<char>(&result[0], result.size()));
+  result.resize(r.has_value() ? *r : 0);
+  return result;
+}
+
+bool validate_utf8_scalar(const std::string& str)
+{
+  return detail::utf8_validate_scalar(
+      reinterpret_cast<const unsigned char*>(str.data()), str.size());
+}
+}
+
+TEST_CASE("validate_utf8")
+{
+  CHECK(validate_utf8(""));
+  CHECK(validate_utf8("hello world!"));
+  CHECK(validate_utf8("\x7F"));
+  CHECK(validate_utf8("\xC2\x80"));
+  CHECK(validate_utf8("\xDF\xBF"));
+  CHECK(validate_utf8("\xE0\xA0\x80"));
+  CHECK(validate_utf8("\xED\x9F\xBF"));
+  CHECK(validate_utf8("\xEE\x80\x80"));
+  CHECK(validate_utf8("\xEF\xBF\xBF"));
+  CHECK(validate_utf8("\xF0\x90\x80\x80"));
+  CHECK(validate_utf8("\xF4\x8F\xBF\xBF"));
+
+  CHECK_FALSE(validate_utf8("\x80"));
+  CHECK_FALSE(validate_utf8("\xBF"));
+  CHECK_FALSE(validate_utf8("\xC0\x80"));
+  CHECK_FALSE(validate_utf8("\xC1\xBF"));
+  CHECK_FALSE(validate_utf8("\xC2"));
+  CHECK_FALSE(validate_utf8("\xC2\x41"));
+  CHECK_FALSE(validate_utf8("\xE0\x80\x80"));
+  CHECK_FALSE(validate_utf8("\xE0\x9F\xBF"));
+  CHECK_FALSE(validate_utf8("\xED\xA0\x80"));
+  CHECK_FALSE(validate_utf8("\xED\xBF\xBF"));
+  CHECK_FALSE(validate_utf8("\xE1\x80"));
+  CHECK_FALSE(validate_utf8("\xF0\x80\x80\x80"));
+  CHECK_FALSE(validate_utf8("\xF0\x8F\xBF\xBF"));
+  CHECK_FALSE(validate_utf8("\xF4\x90\x80\x80"));
+  CHECK_FALSE(validate_utf8("\xF5\x80\x80\x80"));
+  CHECK_FALSE(validate_utf8("\xFF"));
+  CHECK_FALSE(validate_utf8("\xF0\x90\x80"));
+  CHECK_FALSE(validate_utf8("\xC2\x80\x80"));
+
+  // Sequences crossing, or truncated at, block boundaries.
+  for (std::size_t offset = 0; offset < 70; ++offset) {
+    const std::string prefix(offset, 'a');
+    const char* sequences[] = { "\xC2\x80", "\xE0\xA0\x80",
+                                "\xF0\x90\x80\x80", "\xF4\x8F\xBF\xBF" };
+    for (auto sequence : sequences) {
+      const std::string valid = prefix + sequence;
+      CHECK(validate_utf8(valid));
+      CHECK(validate_utf8(valid + std::string(40, 'b')));
+      for (std::size_t n = 1; n < valid.size() - offset; ++n) {
+        const std::string truncated = valid.substr(0, offset + n);
+        CHECK_FALSE(validate_utf8(truncated));
+        CHECK_FALSE(validate_utf8(truncated + std::string(40, 'b')));
+      }
+    }
+  }
+}
+
+TEST_CASE("validate_utf8 random")
+{
+  std::mt19937 gen;
+  std::uniform_int_distribution<std::size_t> size_dist(0, 100);
+  std::uniform_int_distribution<int> byte_dist(0, 255);
+  for (int i = 0; i < 20000; ++i) {
+    std::string str = to_utf8(random_code_points(gen, size_dist(gen)));
+    CHECK(validate_utf8(str));
+    if (!str.empty()) {
+      const auto mutations = i % 3;
+      for (int m = 0; m < mutations; ++m) {
+        str[std::uniform_int_distribution<std::size_t>(
+            0, str.size() - 1)(gen)]
+            = static_cast<char>(byte_dist(gen));
+      }
+    }
+    CHECK_EQ(validate_utf8(str), validate_utf8_scalar(str));
+#ifdef GUL_UTF8_SSSE3
+#ifdef GUL_UTF8_SSSE3_DISPATCH
+    if (detail::cpu_has_ssse3())
+#endif
+    {
+      CHECK_EQ(detail::utf8_validate_ssse3(
+                   reinterpret_cast<const unsigned char*>(str.data()),
+                   str.size()),
+               validate_utf8_scalar(str));
+    }
+#endif
+  }
+}
+
+TEST_CASE("validate_utf16")
+{
+  CHECK(validate_utf16(u""));
+  CHECK(validate_utf16(u"hello world!"));
+  CHECK(validate_utf16(u"\xD7FF\xE000\xFFFF"));
+  CHECK(validate_utf16(u"\xD800\xDC00\xDBFF\xDFFF"));
+  CHECK_FALSE(validate_utf16(u"\xD800"));
+  CHECK_FALSE(validate_utf16(u"\xDC00"));
+  CHECK_FALSE(validate_utf16(u"\xD800\xD800"));
+  CHECK_FALSE(validate_utf16(u"\xDC00\xD800"));
+  CHECK_FALSE(validate_utf16(u"a\xD800z"));
+}
+
+TEST_CASE("validate_utf32")
+{
+  CHECK(validate_utf32(U""));
+  CHECK(validate_utf32(U"hello world!"));
+  CHECK(validate_utf32(U"\x10FFFF"));
+  CHECK_FALSE(validate_utf32(U"\xD800"));
+  CHECK_FALSE(validate_utf32(U"\xDFFF"));
+  CHECK_FALSE(validate_utf32(U"\x110000"));
+}
+
+TEST_CASE("transcoding")
+{
+  {
+    char16_t buffer[16];
+    auto r = utf8_to_utf16("a\xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80", buffer);
+    CHECK(r.has_value());
+    CHECK_EQ(*r, 5);
+    CHECK_EQ(u16string_view(buffer, *r),
+             u16string_view(u"a\xE9\x20AC\xD83D\xDE00"));
+  }
+  {
+    char32_t buffer[16];
+    auto r = utf8_to_utf32("a\xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80", buffer);
+    CHECK(r.has_value());
+    CHECK_EQ(*r, 4);
+    CHECK_EQ(u32string_view(buffer, *r), u32string_view(U"a\xE9\x20AC\x1F600"));
+  }
+  {
+    char buffer[16];
+    auto r = utf16_to_utf8(u"a\xE9\x20AC\xD83D\xDE00", buffer);
+    CHECK(r.has_value());
+    CHECK_EQ(string_view(buffer, *r),
+             string_view("a\xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80"));
+  }
+  {
+    char32_t buffer[16];
+    auto r = utf16_to_utf32(u"a\xE9\x20AC\xD83D\xDE00", buffer);
+    CHECK(r.has_value());
+    CHECK_EQ(u32string_view(buffer, *r), u32string_view(U"a\xE9\x20AC\x1F600"));
+  }
+  {
+    char16_t buffer[16];
+    auto r = utf32_to_utf16(U"a\xE9\x20AC\x1F600", buffer);
+    CHECK(r.has_value());
+    CHECK_EQ(u16string_view(buffer, *r),
+             u16string_view(u"a\xE9\x20AC\xD83D\xDE00"));
+  }
+  CHECK_EQ(encode_utf8(0x7F), "\x7F");
+  CHECK_EQ(encode_utf8(0x80), "\xC2\x80");
+  CHECK_EQ(encode_utf8(0x7FF), "\xDF\xBF");
+  CHECK_EQ(encode_utf8(0x800), "\xE0\xA0\x80");
+  CHECK_EQ(encode_utf8(0xFFFF), "\xEF\xBF\xBF");
+  CHECK_EQ(encode_utf8(0x10000), "\xF0\x90\x80\x80");
+  CHECK_EQ(encode_utf8(0x10FFFF), "\xF4\x8F\xBF\xBF");
+}
+
+TEST_CASE("transcoding errors")
+{
+  char buffer8[4];
+  char16_t buffer16[4];
+  char32_t buffer32[4];
+
+  CHECK_EQ(utf8_to_utf16("\xC0\x80", buffer16).error(),
+           std::errc::illegal_byte_sequence);
+  CHECK_EQ(utf8_to_utf32("ab\xED\xA0\x80", buffer32).error(),
+           std::errc::illegal_byte_sequence);
+  CHECK_EQ(utf16_to_utf8(u"\xDC00", buffer8).error(),
+           std::errc::illegal_byte_sequence);
+  CHECK_EQ(utf16_to_utf32(u"a\xD800", buffer32).error(),
+           std::errc::illegal_byte_sequence);
+  CHECK_EQ(utf32_to_utf8(U"\x110000", buffer8).error(),
+           std::errc::illegal_byte_sequence);
+  CHECK_EQ(utf32_to_utf16(U"\xDFFF", buffer16).error(),
+           std::errc::illegal_byte_sequence);
+
+  CHECK_EQ(utf8_to_utf16("abcde", buffer16).error(),
+           std::errc::value_too_large);
+  CHECK_EQ(utf8_to_utf16("abc\xF0\x9F\x98\x80", buffer16).error(),
+           std::errc::value_too_large);
+  CHECK_EQ(utf8_to_utf32("abcde", buffer32).error(),
+           std::errc::value_too_large);
+  CHECK_EQ(utf16_to_utf8(u"abc\xE9", buffer8).error(),
+           std::errc::value_too_large);
+  CHECK_EQ(utf16_to_utf32(u"abcde", buffer32).error(),
+           std::errc::value_too_large);
+  CHECK_EQ(utf32_to_utf8(U"\x1F600\x1F600", buffer8).error(),
+           std::errc::value_too_large);
+  CHECK_EQ(utf32_to_utf16(U"\x1F600\x1F600\x1F600", buffer16).error(),
+           std::errc::value_too_large);
+
+  CHECK_EQ(*utf8_to_utf16("", span<char16_t>()), 0);
+  CHECK_EQ(*utf16_to_utf8(u"", span<char>()), 0);
+}
+
+TEST_CASE("transcoding round trip")
+{
+  std::mt19937 gen;
+  std::uniform_int_distribution<std::size_t> size_dist(0, 100);
+  for (int i = 0; i < 2000; ++i) {
+    const auto utf32 = random_code_points(gen, size_dist(gen));
+    const auto utf8 = to_utf8(utf32);
+
+    std::vector<char16_t> utf16(utf32.size() * 2);
+    auto r16 = utf8_to_utf16(utf8, span<char16_t>(utf16.data(), utf16.size()));
+    CHECK(r16.has_value());
+    utf16.resize(*r16);
+    CHECK(validate_utf16(u16string_view(utf16.data(), utf16.size())));
+
+    std::vector<char16_t> utf16_from_utf32(utf32.size() * 2);
+    auto r16_32 = utf32_to_utf16(utf32,
+                                 span<char16_t>(utf16_from_utf32.data(),
+                                                utf16_from_utf32.size()));
+    CHECK(r16_32.has_value());
+    utf16_from_utf32.resize(*r16_32);
+    CHECK(utf16 == utf16_from_utf32);
+
+    std::vector<char32_t> back32(utf16.size());
+    auto r32 = utf16_to_utf32(u16string_view(utf16.data(), utf16.size()),
+                              span<char32_t>(back32.data(), back32.size()));
+    CHECK(r32.has_value());
+    CHECK_EQ(u32string_view(back32.data(), *r32), u32string_view(utf32));
+
+    std::vector<char32_t> utf32_from_utf8(utf8.size());
+    auto r32_8 = utf8_to_utf32(
+        utf8, span<char32_t>(utf32_from_utf8.data(), utf32_from_utf8.size()));
+    CHECK(r32_8.has_value());
+    CHECK_EQ(u32string_view(utf32_from_utf8.data(), *r32_8),
+             u32string_view(utf32));
+
+    std::string back8(utf16.size() * 3, '\0');
+    auto r8 = utf16_to_utf8(u16string_view(utf16.data(), utf16.size()),
+                            span<char>(&back8[0], back8.size()));
+    CHECK(r8.has_value());
+    back8.resize(*r8);
+    CHECK_EQ(back8, utf8);
+  }
+}
+
+#if defined(GUL_HAS_CXX20) || defined(__cpp_char8_t)
+TEST_CASE("char8_t")
+{
+  CHECK(validate_utf8(u8"héllo"));
+
+  char16_t buffer16[8];
+  auto r16 = utf8_to_utf16(u8"héllo", buffer16);
+  CHECK(r16.has_value());
+  CHECK_EQ(u16string_view(buffer16, *r16), u16string_view(u"héllo"));
+
+  char32_t buffer32[8];
+  auto r32 = utf8_to_utf32(u8"héllo", buffer32);
+  CHECK(r32.has_value());
+  CHECK_EQ(u32string_view(buffer32, *r32), u32string_view(U"héllo"));
+
+  char8_t buffer8[8];
+  auto r8 = utf16_to_utf8(u"héllo", buffer8);
+  CHECK(r8.has_value());
+  CHECK_EQ(u8string_view(buffer8, *r8), u8string_view(u8"héllo"));
+
+  r8 = utf32_to_utf8(U"héllo", buffer8);
+  CHECK(r8.has_value());
+  CHECK_EQ(u8string_view(buffer8, *r8), u8string_view(u8"héllo"));
+}
+#endif
+
+TEST_SUITE_END();